@@ -114,6 +114,8 @@ MFEM_USE_LAPACK        = NO
 MFEM_THREAD_SAFE       = NO
 MFEM_USE_OPENMP        = NO
 MFEM_USE_LEGACY_OPENMP = NO
+MFEM_USE_THREADS       = NO
+MFEM_USE_PROFILER      = NO
 MFEM_USE_MEMALLOC      = YES
 MFEM_TIMER_TYPE        = $(if $(NOTMAC),2,4)
 MFEM_USE_SUNDIALS      = NO
@@ -183,6 +185,10 @@ LAPACK_LIB = $(if $(NOTMAC),-llapack -lblas,-framework Accelerate)
 OPENMP_OPT = $(XCOMPILER)-fopenmp
 OPENMP_LIB =
 
+# Thread pool backend configuration
+THREADS_OPT = $(XCOMPILER)-pthread
+THREADS_LIB = $(XLINKER)-pthread
+
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
@@ -13,22 +13,99 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/profiler.hpp"
 #include <cmath>
 
 namespace mfem
 {
 
+// Build the element-to-vdof table of @a fes, with the signs of the dofs removed
+static void GetElementToVDofTable(const FiniteElementSpace &fes, Table &el_vdof)
+{
+   const int ne = fes.GetNE();
+   Array<int> vdofs;
+   el_vdof.MakeI(ne);
+   for (int i = 0; i < ne; i++)
+   {
+      fes.GetElementVDofs(i, vdofs);
+      el_vdof.AddColumnsInRow(i, vdofs.Size());
+   }
+   el_vdof.MakeJ();
+   for (int i = 0; i < ne; i++)
+   {
+      fes.GetElementVDofs(i, vdofs);
+      for (int j = 0; j < vdofs.Size(); j++)
+      {
+         if (vdofs[j] < 0) { vdofs[j] = -1 - vdofs[j]; }
+      }
+      el_vdof.AddConnections(i, vdofs.GetData(), vdofs.Size());
+   }
+   el_vdof.ShiftUpI();
+}
+
+// Add the element matrix @a elmat to the CSR data @a V, using the positions
+// @a map of its entries given by BilinearForm::BuildElementCSRMap().
+static void AddElementMatrix(double *V, const int *map,
+                             const Array<int> &vdofs, const DenseMatrix &elmat)
+{
+   const int n = vdofs.Size();
+   const double *el = elmat.Data();
+   for (int j = 0; j < n; j++)
+   {
+      const double s_j = (vdofs[j] >= 0) ? 1.0 : -1.0;
+      for (int i = 0; i < n; i++)
+      {
+         const double s_i = (vdofs[i] >= 0) ? 1.0 : -1.0;
+         V[map[i+n*j]] += s_i * s_j * el[i+n*j];
+      }
+   }
+}
+
+// Add the element matrix @a elmat to the finalized matrix @a A. Unlike
+// SparseMatrix::AddSubMatrix(), this does not use the "current row" state of
+// @a A, so different rows can be updated concurrently. The array @a col_pos
+// of size A.Width() is used as scratch space.
+static void AddElementMatrix(SparseMatrix &A, const Array<int> &vdofs,
+                             const DenseMatrix &elmat, Array<int> &col_pos)
+{
+   const int *I = A.GetI(), *J = A.GetJ();
+   double *V = A.GetData();
+   const int n = vdofs.Size();
+   for (int i = 0; i < n; i++)
+   {
+      const int row = (vdofs[i] >= 0) ? vdofs[i] : -1 - vdofs[i];
+      const double s_i = (vdofs[i] >= 0) ? 1.0 : -1.0;
+      for (int k = I[row]; k < I[row+1]; k++)
+      {
+         col_pos[J[k]] = k;
+      }
+      for (int j = 0; j < n; j++)
+      {
+         const int col = (vdofs[j] >= 0) ? vdofs[j] : -1 - vdofs[j];
+         const double s_j = (vdofs[j] >= 0) ? 1.0 : -1.0;
+         const int k = col_pos[col];
+         MFEM_VERIFY(k >= I[row] && k < I[row+1] && J[k] == col,
+                     "Entry for row = " << row << ", col = " << col
+                     << " is not allocated.");
+         V[k] += s_i * s_j * elmat(i,j);
+      }
+   }
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
 
-   if (precompute_sparsity == 0 || fes->GetVDim() > 1)
+   elem_csr_offsets.DeleteAll();
+   if (!threaded_assembly && !numeric_reassembly &&
+       (precompute_sparsity == 0 || fes->GetVDim() > 1))
    {
       mat = new SparseMatrix(height);
       return;
    }
 
-   const Table &elem_dof = fes->GetElementToDofTable();
+   Table elem_dof;
+   GetElementToVDofTable(*fes, elem_dof);
    Table dof_dof;
 
    if (fbfi.Size() > 0)
@@ -74,6 +151,8 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   threaded_assembly = false;
+   numeric_reassembly = false;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
@@ -92,6 +171,8 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   threaded_assembly = false;
+   numeric_reassembly = false;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
@@ -126,15 +207,13 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
          // Use the original BilinearForm implementation for now
          break;
       case AssemblyLevel::ELEMENT:
-         mfem_error("Element assembly not supported yet... stay tuned!");
-         // ext = new EABilinearFormExtension(this);
+         ext = new EABilinearFormExtension(this);
          break;
       case AssemblyLevel::PARTIAL:
          ext = new PABilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFBilinearFormExtension(this);
+         ext = new MFBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
@@ -193,6 +272,7 @@ void BilinearForm::UseSparsity(int *I, int *J, bool isSorted)
       }
       delete mat;
    }
+   elem_csr_offsets.DeleteAll();
    height = width = fes->GetVSize();
    mat = new SparseMatrix(I, J, NULL, height, width, false, true, isSorted);
 }
@@ -376,6 +456,7 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PROFILE_REGION("BilinearForm::Assemble");
    if (ext)
    {
       ext->Assemble();
@@ -391,6 +472,12 @@ void BilinearForm::Assemble(int skip_zeros)
       AllocMat();
    }
 
+   const bool numeric = numeric_reassembly && !static_cond && !hybridization;
+   if (numeric)
+   {
+      PrepareNumericReassembly();
+   }
+
 #ifdef MFEM_USE_LEGACY_OPENMP
    int free_element_matrices = 0;
    if (!element_matrices)
@@ -400,7 +487,23 @@ void BilinearForm::Assemble(int skip_zeros)
    }
 #endif
 
-   if (dbfi.Size())
+   if (dbfi.Size() && threaded_assembly && !element_matrices &&
+       !static_cond && !hybridization && mat->Finalized())
+   {
+      AssembleDomainThreaded();
+   }
+   else if (dbfi.Size() && numeric)
+   {
+      double *V = mat->GetData();
+      for (int i = 0; i < fes -> GetNE(); i++)
+      {
+         ComputeElementMatrix(i, elmat);
+         fes->GetElementVDofs(i, vdofs);
+         AddElementMatrix(V, elem_csr_map.GetData() + elem_csr_offsets[i],
+                          vdofs, elmat);
+      }
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -576,6 +679,189 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+void BilinearForm::ColorElements()
+{
+   const int ne = fes->GetNE();
+   Table el_dof, dof_el;
+   GetElementToVDofTable(*fes, el_dof);
+   Transpose(el_dof, dof_el, fes->GetVSize());
+
+   // Greedy coloring of the element graph: each element gets the smallest
+   // color not used by the elements sharing one of its dofs.
+   Array<int> el_color(ne), color_mark;
+   el_color = -1;
+   int num_colors = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      const int *dofs = el_dof.GetRow(i);
+      for (int j = 0; j < el_dof.RowSize(i); j++)
+      {
+         const int *els = dof_el.GetRow(dofs[j]);
+         for (int k = 0; k < dof_el.RowSize(dofs[j]); k++)
+         {
+            const int c = el_color[els[k]];
+            if (c >= 0) { color_mark[c] = i; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && color_mark[c] == i) { c++; }
+      if (c == num_colors)
+      {
+         color_mark.Append(-1);
+         num_colors++;
+      }
+      el_color[i] = c;
+   }
+
+   elem_colors.MakeI(num_colors);
+   for (int i = 0; i < ne; i++) { elem_colors.AddAColumnInRow(el_color[i]); }
+   elem_colors.MakeJ();
+   for (int i = 0; i < ne; i++) { elem_colors.AddConnection(el_color[i], i); }
+   elem_colors.ShiftUpI();
+}
+
+void BilinearForm::AssembleDomainThreaded()
+{
+   const int ne = fes->GetNE();
+   if (ne == 0) { return; }
+   if (elem_colors.Size() <= 0) { ColorElements(); }
+   const bool use_map = (elem_csr_offsets.Size() == ne + 1);
+   double *V = mat->GetData();
+
+   // Assemble serially the first element of each geometry type, so that the
+   // shared data created on first use (e.g. integration rules) is available
+   // before the threads start.
+   Array<bool> done(ne);
+   done = false;
+   {
+      Array<bool> geom_seen(Geometry::NumGeom);
+      geom_seen = false;
+      DenseMatrix elmat;
+      Array<int> col_pos(use_map ? 0 : mat->Width());
+      for (int i = 0; i < ne; i++)
+      {
+         const Geometry::Type geom = fes->GetFE(i)->GetGeomType();
+         if (geom_seen[geom]) { continue; }
+         geom_seen[geom] = true;
+         ComputeElementMatrix(i, elmat);
+         fes->GetElementVDofs(i, vdofs);
+         if (use_map)
+         {
+            AddElementMatrix(V, elem_csr_map.GetData() + elem_csr_offsets[i],
+                             vdofs, elmat);
+         }
+         else
+         {
+            AddElementMatrix(*mat, vdofs, elmat, col_pos);
+         }
+         done[i] = true;
+      }
+   }
+
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel
+#endif
+   {
+      // Thread-local scratch space
+      DenseMatrix elmat, tmp;
+      Array<int> el_vdofs;
+      Array<int> col_pos(use_map ? 0 : mat->Width());
+      IsoparametricTransformation eltrans;
+
+      for (int c = 0; c < elem_colors.Size(); c++)
+      {
+         const int *els = elem_colors.GetRow(c);
+         const int nels = elem_colors.RowSize(c);
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+         #pragma omp for schedule(static)
+#endif
+         for (int k = 0; k < nels; k++)
+         {
+            const int i = els[k];
+            if (done[i]) { continue; }
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int j = 1; j < dbfi.Size(); j++)
+            {
+               dbfi[j]->AssembleElementMatrix(fe, eltrans, tmp);
+               elmat += tmp;
+            }
+            fes->GetElementVDofs(i, el_vdofs);
+            if (use_map)
+            {
+               AddElementMatrix(V, elem_csr_map.GetData() +
+                                elem_csr_offsets[i], el_vdofs, elmat);
+            }
+            else
+            {
+               AddElementMatrix(*mat, el_vdofs, elmat, col_pos);
+            }
+         }
+      }
+   }
+}
+
+void BilinearForm::BuildElementCSRMap()
+{
+   const int ne = fes->GetNE();
+   const int *I = mat->GetI(), *J = mat->GetJ();
+   Array<int> col_pos(mat->Width());
+
+   elem_csr_offsets.SetSize(ne + 1);
+   elem_csr_offsets[0] = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      elem_csr_offsets[i+1] = elem_csr_offsets[i] + vdofs.Size()*vdofs.Size();
+   }
+   elem_csr_map.SetSize(elem_csr_offsets[ne]);
+
+   for (int e = 0; e < ne; e++)
+   {
+      fes->GetElementVDofs(e, vdofs);
+      const int n = vdofs.Size();
+      int *map = elem_csr_map.GetData() + elem_csr_offsets[e];
+      for (int i = 0; i < n; i++)
+      {
+         const int row = (vdofs[i] >= 0) ? vdofs[i] : -1 - vdofs[i];
+         for (int k = I[row]; k < I[row+1]; k++)
+         {
+            col_pos[J[k]] = k;
+         }
+         for (int j = 0; j < n; j++)
+         {
+            const int col = (vdofs[j] >= 0) ? vdofs[j] : -1 - vdofs[j];
+            const int k = col_pos[col];
+            MFEM_VERIFY(k >= I[row] && k < I[row+1] && J[k] == col,
+                        "Entry for row = " << row << ", col = " << col
+                        << " is not allocated.");
+            map[i+n*j] = k;
+         }
+      }
+   }
+}
+
+void BilinearForm::PrepareNumericReassembly()
+{
+   if (elem_csr_offsets.Size() != fes->GetNE() + 1)
+   {
+      if (!mat->Finalized() || height != fes->GetVSize())
+      {
+         // mat does not have the element sparsity pattern, e.g. it was
+         // replaced by ConformingAssemble()
+         delete mat;
+         mat = NULL;
+         height = width = fes->GetVSize();
+         AllocMat();
+      }
+      BuildElementCSRMap();
+   }
+   *mat = 0.0;
+   delete mat_e;
+   mat_e = NULL;
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -599,6 +885,7 @@ void BilinearForm::ConformingAssemble()
    }
    delete R;
    mat = mfem::Mult(*RA, *P);
+   elem_csr_offsets.DeleteAll();
    delete RA;
    if (mat_e)
    {
@@ -640,6 +927,7 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
                                     Vector &b, OperatorHandle &A, Vector &X,
                                     Vector &B, int copy_interior)
 {
+   MFEM_PROFILE_REGION("BilinearForm::FormLinearSystem");
    if (ext)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
@@ -708,6 +996,7 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
 void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                     OperatorHandle &A)
 {
+   MFEM_PROFILE_REGION("BilinearForm::FormSystemMatrix");
    if (ext)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
@@ -998,6 +1287,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultTranspose(const Vector &x, Vector &y) const
+{
+   if (ext)
+   {
+      ext->MultTranspose(x, y);
+   }
+   else
+   {
+      y = 0.0;
+      AddMultTranspose(x, y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1027,6 +1329,8 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
       mat = NULL;
       delete hybridization;
       hybridization = NULL;
+      elem_colors.Clear();
+      elem_csr_offsets.DeleteAll();
       sequence = fes->GetSequence();
    }
    else
@@ -1252,6 +1556,7 @@ void MixedBilinearForm::AddBdrTraceFaceIntegrator(BilinearFormIntegrator *bfi,
 
 void MixedBilinearForm::Assemble (int skip_zeros)
 {
+   MFEM_PROFILE_REGION("MixedBilinearForm::Assemble");
    if (ext)
    {
       ext->Assemble();
@@ -105,6 +105,34 @@ protected:
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /// Use the thread-parallel assembly of the domain integrators.
+   bool threaded_assembly;
+   /** @brief Elements grouped by colors: two elements with the same color do
+       not share any dof. Built on the first threaded assembly. */
+   Table elem_colors;
+
+   // Build the element coloring used by the threaded assembly
+   void ColorElements();
+
+   // Thread-parallel assembly of the domain integrators into the finalized mat
+   void AssembleDomainThreaded();
+
+   /// Refill the finalized matrix in place on reassembly.
+   bool numeric_reassembly;
+   /** @brief Positions in the CSR data of #mat of the entries of the element
+       matrices, see UseNumericReassembly().
+
+       The entries of element i are stored at indices elem_csr_offsets[i] to
+       elem_csr_offsets[i+1]-1 of elem_csr_map, in the column-major order of
+       the element matrix. Empty when the map is not built for #mat. */
+   Array<int> elem_csr_offsets, elem_csr_map;
+
+   // Build elem_csr_offsets and elem_csr_map for the finalized mat
+   void BuildElementCSRMap();
+
+   // Make sure mat has the element sparsity pattern and its map, then zero it
+   void PrepareNumericReassembly();
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -114,6 +142,8 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      threaded_assembly = false;
+      numeric_reassembly = false;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::FULL;
       batch = 1;
@@ -180,6 +210,34 @@ public:
        present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /** @brief Enable the thread-parallel assembly of the domain integrators.
+
+       The matrix is allocated in CSR format, with the sparsity pattern given by
+       the element-to-dof tables (also for vector FE spaces), and the element
+       matrices are added directly to it. The elements are colored so that the
+       elements of one color do not share dofs; each color is then assembled in
+       parallel, with thread-local element transformations and scratch space.
+
+       Threads are used only when MFEM is built with MFEM_USE_OPENMP and
+       MFEM_THREAD_SAFE, otherwise the integrators share their scratch data.
+       This method should be called before assembly. It is ignored with static
+       condensation, hybridization and assembly levels other than FULL. */
+   void UseThreadedAssembly(bool use = true) { threaded_assembly = use; }
+
+   /** @brief Enable the numeric-only reassembly of the matrix.
+
+       The matrix is allocated once in CSR format, with the sparsity pattern
+       given by the element-to-dof tables, together with a map from the entries
+       of the element matrices to their positions in the CSR data. Each
+       subsequent call to Assemble() keeps the I and J arrays, sets the matrix
+       to zero, discards the eliminated part of the matrix, and refills the
+       matrix in place through the map, without any allocation or search.
+
+       The map stores one integer per entry of each element matrix. This method
+       should be called before assembly. It is ignored with static condensation
+       and hybridization. */
+   void UseNumericReassembly(bool use = true) { numeric_reassembly = use; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -246,8 +304,7 @@ public:
    void FullAddMultTranspose(const Vector & x, Vector & y) const
    { mat->AddMultTranspose(x, y); mat_e->AddMultTranspose(x, y); }
 
-   virtual void MultTranspose(const Vector & x, Vector & y) const
-   { y = 0.0; AddMultTranspose (x, y); }
+   virtual void MultTranspose(const Vector & x, Vector & y) const;
 
    double InnerProduct(const Vector &x, const Vector &y) const
    { return mat->InnerProduct (x, y); }
@@ -269,7 +326,13 @@ public:
       MFEM_VERIFY(mat, "mat is NULL and can't be dereferenced");
       return *mat;
    }
-   SparseMatrix *LoseMat() { SparseMatrix *tmp = mat; mat = NULL; return tmp; }
+   SparseMatrix *LoseMat()
+   {
+      SparseMatrix *tmp = mat;
+      mat = NULL;
+      elem_csr_offsets.DeleteAll();
+      return tmp;
+   }
 
    /// Returns a reference to the sparse matrix of eliminated b.c.
    const SparseMatrix &SpMatElim() const
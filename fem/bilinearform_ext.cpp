@@ -13,8 +13,12 @@
 // PABilinearFormExtension and MFBilinearFormExtension.
 
 #include "../general/forall.hpp"
+#include "../general/profiler.hpp"
 #include "bilinearform.hpp"
 #include "libceed/ceed.hpp"
+#ifdef MFEM_USE_MPI
+#include "pfespace.hpp"
+#endif
 
 namespace mfem
 {
@@ -83,6 +87,7 @@ void PABilinearFormExtension::SetupRestrictionOperators()
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::Assemble");
    SetupRestrictionOperators();
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -109,6 +114,7 @@ void PABilinearFormExtension::Assemble()
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::AssembleDiagonal");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -174,6 +180,7 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::Mult");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -189,10 +196,14 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    else
    {
       elem_restrict->Mult(x, localX);
-      localY = 0.0;
-      for (int i = 0; i < iSz; ++i)
       {
-         integrators[i]->AddMultPA(localX, localY);
+         MFEM_PROFILE_REGION("AddMultPA");
+         MFEM_PROFILE_BYTES((localX.Size() + 2*localY.Size())*sizeof(double));
+         localY = 0.0;
+         for (int i = 0; i < iSz; ++i)
+         {
+            integrators[i]->AddMultPA(localX, localY);
+         }
       }
       elem_restrict->MultTranspose(localY, y);
    }
@@ -232,6 +243,7 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PABilinearFormExtension::MultTranspose");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
@@ -287,6 +299,342 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+bool PABilinearFormExtension::SupportsElementRanges() const
+{
+   if (DeviceCanUseCeed() ||
+       !dynamic_cast<const ElementRestriction*>(elem_restrict) ||
+       a->GetFBFI()->Size() > 0 || a->GetBFBFI()->Size() > 0)
+   {
+      return false;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPAElements()) { return false; }
+   }
+   return true;
+}
+
+void PABilinearFormExtension::AddMultElements(const Vector &x, Vector &y,
+                                              int e_begin, int e_end) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultPAElements(x, y, e_begin, e_end);
+   }
+}
+
+Operator *PABilinearFormExtension::SetupRAP(const Operator *Pi,
+                                            const Operator *Po)
+{
+#ifdef MFEM_USE_MPI
+   const ConformingProlongationOperator *P =
+      dynamic_cast<const ConformingProlongationOperator*>(Pi);
+   if (P && Pi == Po && SupportsElementRanges())
+   {
+      return new PAOverlappedRAPOperator(*this, *trialFes, *P);
+   }
+#endif
+   return BilinearFormExtension::SetupRAP(Pi, Po);
+}
+
+#ifdef MFEM_USE_MPI
+// Interior ranges with fewer elements are merged with the boundary ranges, to
+// limit the number of kernel launches.
+static const int PA_OVERLAP_MIN_RANGE = 32;
+
+PAOverlappedRAPOperator::PAOverlappedRAPOperator(
+   const PABilinearFormExtension &ext, const FiniteElementSpace &fes,
+   const ConformingProlongationOperator &P_)
+   : Operator(P_.Width()),
+     pa(ext),
+     P(P_),
+     R(*dynamic_cast<const ElementRestriction*>(ext.GetElementRestriction()))
+{
+   // Mark the scalar dofs with external vector dofs
+   const Array<int> &ext_ldofs = P.GetExternalLDofs();
+   Array<int> ext_marker(fes.GetNDofs());
+   ext_marker = 0;
+   for (int i = 0; i < ext_ldofs.Size(); i++)
+   {
+      ext_marker[fes.VDofToDof(ext_ldofs[i])] = 1;
+   }
+   for (int i = 0; i < ext_marker.Size(); i++)
+   {
+      if (ext_marker[i]) { ext_dofs.Append(i); }
+   }
+
+   // Classify the elements and group them in ranges of consecutive elements
+   const int ne = fes.GetNE();
+   Array<int> bdr_elem(ne), dofs;
+   for (int e = 0; e < ne; e++)
+   {
+      fes.GetElementDofs(e, dofs);
+      bdr_elem[e] = 0;
+      for (int j = 0; j < dofs.Size(); j++)
+      {
+         const int d = (dofs[j] >= 0) ? dofs[j] : -1 - dofs[j];
+         if (ext_marker[d]) { bdr_elem[e] = 1; break; }
+      }
+   }
+   int num_int = 0;
+   for (int e = 0; e < ne; )
+   {
+      int f = e + 1;
+      while (f < ne && bdr_elem[f] == bdr_elem[e]) { f++; }
+      const bool is_bdr = bdr_elem[e] || f - e < PA_OVERLAP_MIN_RANGE;
+      Array<int> &ranges = is_bdr ? bdr_ranges : int_ranges;
+      const int n = ranges.Size();
+      if (n > 0 && ranges[n-1] == e) { ranges[n-1] = f; }
+      else { ranges.Append(e); ranges.Append(f); }
+      if (!is_bdr) { num_int += f - e; }
+      e = f;
+   }
+
+   // Split the interior ranges in two halves with similar numbers of elements
+   int_split = 0;
+   for (int count = 0; 2*count < num_int; int_split++)
+   {
+      count += int_ranges[2*int_split+1] - int_ranges[2*int_split];
+   }
+
+   xL.SetSize(P.Height(), Device::GetDeviceMemoryType());
+   yL.SetSize(P.Height(), Device::GetDeviceMemoryType());
+   xE.SetSize(R.Height(), Device::GetDeviceMemoryType());
+   yE.SetSize(R.Height(), Device::GetDeviceMemoryType());
+   yE.UseDevice(true); // ensure 'yE = 0.0' is done on device
+}
+
+void PAOverlappedRAPOperator::AddMultRanges(const Array<int> &ranges,
+                                            int first, int last) const
+{
+   for (int k = first; k < last; k++)
+   {
+      const int e_begin = ranges[2*k], e_end = ranges[2*k+1];
+      R.MultElements(xL, xE, e_begin, e_end);
+      pa.AddMultElements(xE, yE, e_begin, e_end);
+   }
+}
+
+void PAOverlappedRAPOperator::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("PAOverlappedRAPOperator::Mult");
+   // xL = P x: the owned entries are set now, the external ones are received
+   // while the first half of the interior elements is computed.
+   P.MultBegin(x, xL);
+   yE = 0.0;
+   AddMultRanges(int_ranges, 0, int_split);
+   P.MultEnd(xL);
+   AddMultRanges(bdr_ranges, 0, bdr_ranges.Size()/2);
+
+   // y = P^T yL: the external entries of yL, which only depend on the boundary
+   // elements, are sent while the other interior elements are computed.
+   R.MultTransposeDofs(yE, yL, ext_dofs);
+   P.MultTransposeBegin(yL);
+   AddMultRanges(int_ranges, int_split, int_ranges.Size()/2);
+   R.MultTranspose(yE, yL);
+   P.MultTransposeEnd(yL, y);
+}
+
+void PAOverlappedRAPOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   P.Mult(x, xL);
+   pa.MultTranspose(xL, yL);
+   P.MultTranspose(yL, y);
+}
+#endif
+
+// Data and methods for element-assembled bilinear forms
+EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
+   : PABilinearFormExtension(form),
+     ne(0),
+     elemDofs(0)
+{
+}
+
+void EABilinearFormExtension::Assemble()
+{
+   MFEM_PROFILE_REGION("EABilinearFormExtension::Assemble");
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported with element assembly");
+   SetupRestrictionOperators();
+
+   ne = trialFes->GetNE();
+   elemDofs = ne > 0 ? trialFes->GetFE(0)->GetDof() * trialFes->GetVDim() : 0;
+
+   ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
+   ea_data.UseDevice(true);
+   ea_data = 0.0;
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleEA(*a->FESpace(), ea_data);
+   }
+}
+
+void EABilinearFormExtension::AssembleDiagonal(Vector &y) const
+{
+   const int NDOFS = elemDofs;
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   auto Y = Reshape(localY.Write(), NDOFS, ne);
+   MFEM_FORALL(glob_j, ne*NDOFS,
+   {
+      const int e = glob_j/NDOFS;
+      const int j = glob_j%NDOFS;
+      Y(j, e) = A(j, j, e);
+   });
+   const ElementRestriction* H1elem_restrict =
+      dynamic_cast<const ElementRestriction*>(elem_restrict);
+   if (H1elem_restrict)
+   {
+      H1elem_restrict->MultTransposeUnsigned(localY, y);
+   }
+   else
+   {
+      elem_restrict->MultTranspose(localY, y);
+   }
+}
+
+void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("EABilinearFormExtension::Mult");
+   // Apply the Element Restriction
+   elem_restrict->Mult(x, localX);
+   // Apply the Element Matrices
+   const int NDOFS = elemDofs;
+   auto X = Reshape(localX.Read(), NDOFS, ne);
+   auto Y = Reshape(localY.Write(), NDOFS, ne);
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   MFEM_FORALL(glob_i, ne*NDOFS,
+   {
+      const int e = glob_i/NDOFS;
+      const int i = glob_i%NDOFS;
+      double res = 0.0;
+      for (int j = 0; j < NDOFS; j++)
+      {
+         res += A(j, i, e)*X(j, e);
+      }
+      Y(i, e) = res;
+   });
+   // Apply the Element Restriction transposed
+   elem_restrict->MultTranspose(localY, y);
+}
+
+void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   // Apply the Element Restriction
+   elem_restrict->Mult(x, localX);
+   // Apply the Element Matrices transposed
+   const int NDOFS = elemDofs;
+   auto X = Reshape(localX.Read(), NDOFS, ne);
+   auto Y = Reshape(localY.Write(), NDOFS, ne);
+   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   MFEM_FORALL(glob_j, ne*NDOFS,
+   {
+      const int e = glob_j/NDOFS;
+      const int j = glob_j%NDOFS;
+      double res = 0.0;
+      for (int i = 0; i < NDOFS; i++)
+      {
+         res += A(j, i, e)*X(i, e);
+      }
+      Y(j, e) = res;
+   });
+   // Apply the Element Restriction transposed
+   elem_restrict->MultTranspose(localY, y);
+}
+
+
+// Data and methods for matrix-free bilinear forms
+MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
+   : BilinearFormExtension(form),
+     trialFes(a->FESpace()),
+     testFes(a->FESpace()),
+     elem_restrict(NULL)
+{
+}
+
+void MFBilinearFormExtension::Assemble()
+{
+   MFEM_PROFILE_REGION("MFBilinearFormExtension::Assemble");
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported in matrix-free mode");
+   MFEM_VERIFY(UsesTensorBasis(*trialFes),
+               "matrix-free mode requires a tensor-product space");
+   elem_restrict =
+      trialFes->GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+   localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+   localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleMF(*a->FESpace());
+   }
+}
+
+void MFBilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
+                                               OperatorHandle &A)
+{
+   Operator *oper;
+   Operator::FormSystemOperator(ess_tdof_list, oper);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
+                                               Vector &x, Vector &b,
+                                               OperatorHandle &A,
+                                               Vector &X, Vector &B,
+                                               int copy_interior)
+{
+   Operator *oper;
+   Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("MFBilinearFormExtension::Mult");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   elem_restrict->Mult(x, localX);
+   localY = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultMF(localX, localY);
+   }
+   elem_restrict->MultTranspose(localY, y);
+}
+
+void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   elem_restrict->Mult(x, localX);
+   localY = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultTransposeMF(localX, localY);
+   }
+   elem_restrict->MultTranspose(localY, y);
+}
+
+void MFBilinearFormExtension::Update()
+{
+   FiniteElementSpace *fes = a->FESpace();
+   height = width = fes->GetVSize();
+   trialFes = fes;
+   testFes = fes;
+   elem_restrict = nullptr;
+}
+
+
 MixedBilinearFormExtension::MixedBilinearFormExtension(MixedBilinearForm *form)
    : Operator(form->Height(), form->Width()), a(form)
 {
@@ -328,6 +676,7 @@ PAMixedBilinearFormExtension::PAMixedBilinearFormExtension(
 
 void PAMixedBilinearFormExtension::Assemble()
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::Assemble");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
    for (int i = 0; i < integratorCount; ++i)
@@ -433,6 +782,7 @@ void PAMixedBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 void PAMixedBilinearFormExtension::AddMult(const Vector &x, Vector &y,
                                            const double c) const
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::AddMult");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
 
@@ -465,6 +815,7 @@ void PAMixedBilinearFormExtension::MultTranspose(const Vector &x,
 void PAMixedBilinearFormExtension::AddMultTranspose(const Vector &x, Vector &y,
                                                     const double c) const
 {
+   MFEM_PROFILE_REGION("PAMixedBilinearFormExtension::AddMultTranspose");
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
 
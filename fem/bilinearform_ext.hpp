@@ -21,6 +21,9 @@ namespace mfem
 
 class BilinearForm;
 class MixedBilinearForm;
+#ifdef MFEM_USE_MPI
+class ConformingProlongationOperator;
+#endif
 
 
 /** @brief Class extending the BilinearForm class to support the different
@@ -78,26 +81,6 @@ public:
    ~FABilinearFormExtension() {}
 };
 
-/// Data and methods for element-assembled bilinear forms
-class EABilinearFormExtension : public BilinearFormExtension
-{
-public:
-   EABilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
-
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~EABilinearFormExtension() {}
-};
-
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -110,6 +93,10 @@ protected:
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
 
+   /** With a parallel conforming prolongation, use PAOverlappedRAPOperator
+       when SupportsElementRanges() returns true. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+
 public:
    PABilinearFormExtension(BilinearForm*);
 
@@ -125,27 +112,114 @@ public:
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
+
+   /** @brief Return true if the action of the form can be computed one range
+       of elements at a time with AddMultElements(). */
+   /** This requires an ElementRestriction, no face integrators, and domain
+       integrators implementing BilinearFormIntegrator::AddMultPAElements(). */
+   virtual bool SupportsElementRanges() const;
+
+   /** @brief Add the action of the domain integrators on the elements in the
+       range [@a e_begin, @a e_end) to the E-vector @a y. */
+   /** The E-vectors @a x and @a y are those of all elements, see
+       ElementRestriction::MultElements(). */
+   void AddMultElements(const Vector &x, Vector &y,
+                        int e_begin, int e_end) const;
+
+   /// Return the element restriction, set by SetupRestrictionOperators().
+   const Operator *GetElementRestriction() const { return elem_restrict; }
 };
 
+/// Data and methods for element-assembled bilinear forms
+class EABilinearFormExtension : public PABilinearFormExtension
+{
+protected:
+   int ne;
+   int elemDofs;
+   /** @brief The element matrices, stored contiguously element by element.
+
+       Entry (i,j) of the matrix of element e is stored at
+       ea_data[j + elemDofs*(i + elemDofs*e)], where the local dof indices
+       follow the E-vector ordering of the element restriction. */
+   Vector ea_data;
+
+public:
+   EABilinearFormExtension(BilinearForm *form);
+
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+
+   bool SupportsElementRanges() const { return false; }
+};
+
+#ifdef MFEM_USE_MPI
+/** @brief The operator P^T A P of a partially assembled form A on a parallel
+    conforming space, which overlaps the neighbor communication of P and P^T
+    with the element kernels. */
+/** The elements are split in interior elements, whose dofs are all owned by
+    this rank, and boundary elements, which have external dofs, i.e. dofs owned
+    by a neighbor. The action is computed as follows: the exchange of the
+    external entries of P x is started and the first half of the interior
+    elements is computed; then the exchange is completed and the boundary
+    elements are computed. Only these elements contribute to the external
+    entries of A P x, whose reduction is started before the second half of the
+    interior elements is computed. The result is identical to the one of
+    RAPOperator. Created by PABilinearFormExtension::SetupRAP(). */
+class PAOverlappedRAPOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &pa; // Not owned
+   const ConformingProlongationOperator &P; // Not owned
+   const ElementRestriction &R; // Not owned
+   /// Ranges of interior and boundary elements, stored as begin/end pairs.
+   Array<int> int_ranges, bdr_ranges;
+   /// Interior ranges computed before completing the exchange of P x.
+   int int_split;
+   /// Scalar dofs with external vector dofs.
+   Array<int> ext_dofs;
+   mutable Vector xL, yL, xE, yE;
+
+   void AddMultRanges(const Array<int> &ranges, int first, int last) const;
+
+public:
+   PAOverlappedRAPOperator(const PABilinearFormExtension &ext,
+                           const FiniteElementSpace &fes,
+                           const ConformingProlongationOperator &P);
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+#endif
+
 
 /// Data and methods for matrix-free bilinear forms
+/** No data is stored at the quadrature points: the integrators recompute the
+    geometric factors in each application of the operator. */
 class MFBilinearFormExtension : public BilinearFormExtension
 {
+protected:
+   const FiniteElementSpace *trialFes, *testFes; // Not owned
+   mutable Vector localX, localY;
+   const Operator *elem_restrict; // Not owned
+
 public:
-   MFBilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
+   MFBilinearFormExtension(BilinearForm *form);
 
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
+   void Assemble();
+   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
    void FormLinearSystem(const Array<int> &ess_tdof_list,
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~MFBilinearFormExtension() {}
+                         int copy_interior = 0);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void Update();
 };
 
 /** @brief Class extending the MixedBilinearForm class to support the different
@@ -51,6 +51,51 @@ void BilinearFormIntegrator::AssembleDiagonalPA(Vector &)
               "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                        Vector &emat)
+{
+   const int ne = fes.GetNE();
+   if (ne == 0) { return; }
+   // Assuming the same element type
+   const FiniteElement &fe = *fes.GetFE(0);
+   const int nd = fe.GetDof();
+   const int elemDofs = nd * fes.GetVDim();
+   // Tensor-product elements in continuous spaces use the lexicographic
+   // ordering of the local dofs, see PABilinearFormExtension.
+   const int *dof_map = NULL;
+   const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>(&fe);
+   if (tfe && !fes.IsDGSpace() && tfe->GetDofMap().Size() > 0)
+   {
+      dof_map = tfe->GetDofMap().GetData();
+   }
+   Array<int> perm(elemDofs);
+   Array<int> sign(elemDofs);
+   for (int i = 0; i < elemDofs; i++)
+   {
+      const int d = i % nd, c = i / nd;
+      const int sd = dof_map ? dof_map[d] : d;
+      perm[i] = (sd >= 0 ? sd : -1-sd) + c*nd;
+      sign[i] = (sd >= 0) ? 1 : -1;
+   }
+   double *A = emat.HostReadWrite();
+   DenseMatrix elmat;
+   for (int e = 0; e < ne; e++)
+   {
+      AssembleElementMatrix(*fes.GetFE(e), *fes.GetElementTransformation(e),
+                            elmat);
+      MFEM_VERIFY(elmat.Height() == elemDofs && elmat.Width() == elemDofs,
+                  "element matrix size does not match the element dofs");
+      for (int i = 0; i < elemDofs; i++)
+      {
+         for (int j = 0; j < elemDofs; j++)
+         {
+            A[j + elemDofs*(i + elemDofs*e)] +=
+               sign[i]*sign[j]*elmat(perm[i],perm[j]);
+         }
+      }
+   }
+}
+
 void BilinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
 {
    mfem_error ("BilinearFormIntegrator::MultAssembled(...)\n"
@@ -63,6 +108,31 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAElements(const Vector &, Vector &,
+                                               int, int) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAElements(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &)
+{
+   MFEM_ABORT("BilinearFormIntegrator::AssembleMF(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultMF(...)\n"
+              "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposeMF(const Vector &, Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultTransposeMF(...)\n"
+              "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
@@ -1040,6 +1110,10 @@ void VectorMassIntegrator::AssembleElementMatrix
    vdim = (vdim == -1) ? spaceDim : vdim;
 
    elmat.SetSize(nd*vdim);
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#endif
    shape.SetSize(nd);
    partelmat.SetSize(nd);
    if (VQ)
@@ -1122,6 +1196,10 @@ void VectorMassIntegrator::AssembleElementMatrix2(
    vdim = (vdim == -1) ? Trans.GetSpaceDim() : vdim;
 
    elmat.SetSize(te_nd*vdim, tr_nd*vdim);
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, te_shape, vec;
+   DenseMatrix partelmat, mcoeff;
+#endif
    shape.SetSize(tr_nd);
    te_shape.SetSize(te_nd);
    partelmat.SetSize(te_nd, tr_nd);
@@ -57,6 +57,14 @@ public:
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalPA(Vector &diag);
 
+   /// Method defining element assembly.
+   /** The element matrices are added to the Vector @a emat, which stores them
+       contiguously, element by element, with the local dofs following the
+       E-vector ordering of the element restriction used for @a fes, see
+       EABilinearFormExtension. The default implementation computes the
+       element matrices one by one with AssembleElementMatrix(). */
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
    /// Method for partially assembled action.
    /** Perform the action of integrator on the input @a x and add the result to
        the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
@@ -75,6 +83,41 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on a range of elements.
+   /** Same as AddMultPA(), restricted to the elements in the range
+       [@a e_begin, @a e_end). The E-vectors @a x and @a y are those of all
+       elements and the entries of @a y of the other elements are not modified.
+       This method is used when SupportsPAElements() returns true. */
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   /// Return true if the method AddMultPAElements() is implemented.
+   virtual bool SupportsPAElements() const { return false; }
+
+   /// Method defining matrix-free assembly.
+   /** Only the data needed to recompute the quadrature point quantities on
+       the fly, e.g. the element-local mesh nodes, is stored internally. It is
+       used later in the methods AddMultMF() and AddMultTransposeMF(). */
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   /// Method for matrix-free action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   /// Method for matrix-free transposed action.
+   /** Perform the transpose action of integrator on the input @a x and add the
+       result to the output @a y. Both @a x and @a y are E-vectors, i.e. they
+       represent the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -1795,6 +1838,10 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   // MF extension
+   const IntegrationRule *mf_ir;  ///< Not owned
+   const DofToQuad *mf_nodes_maps; ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1809,6 +1856,8 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
+      mf_nodes_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1821,6 +1870,8 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
+      mf_nodes_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1833,6 +1884,8 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
+      mf_nodes_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1879,6 +1932,20 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   virtual bool SupportsPAElements() const { return true; }
+
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -1899,6 +1966,10 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   // MF extension
+   const IntegrationRule *mf_ir;  ///< Not owned
+   const DofToQuad *mf_nodes_maps; ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1912,6 +1983,8 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
+      mf_nodes_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1923,6 +1996,8 @@ public:
    {
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
+      mf_nodes_maps = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1952,6 +2027,20 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultPAElements(const Vector &x, Vector &y,
+                                  int e_begin, int e_end) const;
+
+   virtual bool SupportsPAElements() const { return true; }
+
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2037,9 +2126,11 @@ class VectorMassIntegrator: public BilinearFormIntegrator
 {
 private:
    int vdim;
+#ifndef MFEM_THREAD_SAFE
    Vector shape, te_shape, vec;
    DenseMatrix partelmat;
    DenseMatrix mcoeff;
+#endif
    int Q_order;
 
 protected:
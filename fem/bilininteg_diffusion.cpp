@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_registry.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
@@ -635,6 +636,46 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    });
 }
 
+// Range of (D1D,Q1D) pairs with specialized kernels in addition to the ones of
+// the switch tables, see KernelRange.
+static constexpr int REGISTRY_D1D_END = 11;
+static constexpr int REGISTRY_Q1D_EXTRA = 2;
+
+typedef void (*DiffusionDiagonalKernel)(const int, const Array<double>&,
+                                        const Array<double>&, const Vector&,
+                                        Vector&, const int, const int);
+
+template<int T_D1D, int T_Q1D> struct DiffusionDiagonal2DInstance
+{
+   static DiffusionDiagonalKernel Get()
+   { return SmemPADiffusionDiagonal2D<T_D1D,T_Q1D,KernelNBZ(T_Q1D)>; }
+};
+
+template<int T_D1D, int T_Q1D> struct DiffusionDiagonal3DInstance
+{
+   static DiffusionDiagonalKernel Get()
+   { return SmemPADiffusionDiagonal3D<T_D1D,T_Q1D>; }
+};
+
+static DiffusionDiagonalKernel FindDiffusionDiagonalKernel(const int dim,
+                                                           const int D1D,
+                                                           const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<DiffusionDiagonalKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<DiffusionDiagonal2DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k2D);
+         KernelRange<DiffusionDiagonal3DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
 static void PADiffusionAssembleDiagonal(const int dim,
                                         const int D1D,
                                         const int Q1D,
@@ -656,7 +697,7 @@ static void PADiffusionAssembleDiagonal(const int dim,
          case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,B,G,D,Y);
          case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,B,G,D,Y);
          case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+         default: break;
       }
    }
    else if (dim == 3)
@@ -671,10 +712,20 @@ static void PADiffusionAssembleDiagonal(const int dim,
          case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,B,G,D,Y);
          case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,B,G,D,Y);
          case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+         default: break;
       }
    }
-   MFEM_ABORT("Unknown kernel.");
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   if (DiffusionDiagonalKernel kernel = FindDiffusionDiagonalKernel(dim, D1D,
+                                                                    Q1D))
+   {
+      return kernel(NE,B,G,D,Y,0,0);
+   }
+   if (dim == 2) { return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D); }
+   return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
 }
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
@@ -943,14 +994,15 @@ static void SmemPADiffusionApply2D(const int NE,
       double (*G)[MD1] = (double (*)[MD1]) (sBG+1);
       double (*Bt)[MQ1] = (double (*)[MQ1]) (sBG+0);
       double (*Gt)[MQ1] = (double (*)[MQ1]) (sBG+1);
+      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
       MFEM_SHARED double Xz[NBZ][MD1][MD1];
-      MFEM_SHARED double GD[2][NBZ][MD1][MQ1];
-      MFEM_SHARED double GQ[2][NBZ][MD1][MQ1];
+      MFEM_SHARED double GD[2][NBZ][MDQ][MDQ];
+      MFEM_SHARED double GQ[2][NBZ][MDQ][MDQ];
       double (*X)[MD1] = (double (*)[MD1])(Xz + tidz);
-      double (*DQ0)[MD1] = (double (*)[MD1])(GD[0] + tidz);
-      double (*DQ1)[MD1] = (double (*)[MD1])(GD[1] + tidz);
-      double (*QQ0)[MD1] = (double (*)[MD1])(GQ[0] + tidz);
-      double (*QQ1)[MD1] = (double (*)[MD1])(GQ[1] + tidz);
+      double (*DQ0)[MDQ] = (double (*)[MDQ])(GD[0] + tidz);
+      double (*DQ1)[MDQ] = (double (*)[MDQ])(GD[1] + tidz);
+      double (*QQ0)[MDQ] = (double (*)[MDQ])(GQ[0] + tidz);
+      double (*QQ1)[MDQ] = (double (*)[MDQ])(GQ[1] + tidz);
       MFEM_FOREACH_THREAD(dy,y,D1D)
       {
          MFEM_FOREACH_THREAD(dx,x,D1D)
@@ -1493,6 +1545,463 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+// PA Diffusion Apply 2D kernel for Backend::SIMD. The elements are processed in
+// batches of SIMD_LANES: the E-vector and the quadrature data of a batch are
+// copied in lane-interleaved arrays, with the element as the innermost index,
+// so that the compiler vectorizes the sum factorization across the elements.
+template<int T_D1D, int T_Q1D>
+static void SimdPADiffusionApply2D(const int NE,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Array<double> &bt_,
+                                   const Array<double> &gt_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(gt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int VL = SIMD_LANES;
+   auto b = Reshape(b_.HostRead(), Q1D, D1D);
+   auto g = Reshape(g_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D, Q1D, 3, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, NE);
+   double B[Q1D][D1D], G[Q1D][D1D];
+   for (int q = 0; q < Q1D; ++q)
+   {
+      for (int d = 0; d < D1D; ++d)
+      {
+         B[q][d] = b(q,d);
+         G[q][d] = g(q,d);
+      }
+   }
+   for (int e0 = 0; e0 < NE; e0 += VL)
+   {
+      const int NV = (NE - e0 < VL) ? NE - e0 : VL;
+      double u[D1D][D1D][VL], dq[3][Q1D][Q1D][VL];
+      for (int v = 0; v < VL; ++v)
+      {
+         const bool valid = v < NV;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               u[dy][dx][v] = valid ? X(dx,dy,e0+v) : 0.0;
+            }
+         }
+         for (int k = 0; k < 3; ++k)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  dq[k][qy][qx][v] = valid ? D(qx,qy,k,e0+v) : 0.0;
+               }
+            }
+         }
+      }
+      double BX[D1D][Q1D][VL], GX[D1D][Q1D][VL];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double *sb = BX[dy][qx], *sg = GX[dy][qx];
+            for (int v = 0; v < VL; ++v) { sb[v] = sg[v] = 0.0; }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wb = B[qx][dx], wg = G[qx][dx];
+               for (int v = 0; v < VL; ++v)
+               {
+                  sb[v] += wb*u[dy][dx][v];
+                  sg[v] += wg*u[dy][dx][v];
+               }
+            }
+         }
+      }
+      double QQ0[Q1D][Q1D][VL], QQ1[Q1D][Q1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double gX[VL], gY[VL];
+            for (int v = 0; v < VL; ++v) { gX[v] = gY[v] = 0.0; }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wb = B[qy][dy], wg = G[qy][dy];
+               for (int v = 0; v < VL; ++v)
+               {
+                  gX[v] += wb*GX[dy][qx][v];
+                  gY[v] += wg*BX[dy][qx][v];
+               }
+            }
+            for (int v = 0; v < VL; ++v)
+            {
+               const double O11 = dq[0][qy][qx][v];
+               const double O12 = dq[1][qy][qx][v];
+               const double O22 = dq[2][qy][qx][v];
+               QQ0[qy][qx][v] = (O11 * gX[v]) + (O12 * gY[v]);
+               QQ1[qy][qx][v] = (O12 * gX[v]) + (O22 * gY[v]);
+            }
+         }
+      }
+      double DQ0[D1D][Q1D][VL], DQ1[D1D][Q1D][VL];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double *s0 = DQ0[dy][qx], *s1 = DQ1[dy][qx];
+            for (int v = 0; v < VL; ++v) { s0[v] = s1[v] = 0.0; }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wb = B[qy][dy], wg = G[qy][dy];
+               for (int v = 0; v < VL; ++v)
+               {
+                  s0[v] += wb*QQ0[qy][qx][v];
+                  s1[v] += wg*QQ1[qy][qx][v];
+               }
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double *s = u[dy][dx];
+            for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double wb = B[qx][dx], wg = G[qx][dx];
+               for (int v = 0; v < VL; ++v)
+               {
+                  s[v] += wg*DQ0[dy][qx][v] + wb*DQ1[dy][qx][v];
+               }
+            }
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx) { Y(dx,dy,e0+v) += u[dy][dx][v]; }
+         }
+      }
+   }
+}
+
+// PA Diffusion Apply 3D kernel for Backend::SIMD, see SimdPADiffusionApply2D.
+// The quadrature data of a batch is copied one z-plane at a time.
+template<int T_D1D, int T_Q1D>
+static void SimdPADiffusionApply3D(const int NE,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Array<double> &bt_,
+                                   const Array<double> &gt_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(gt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int VL = SIMD_LANES;
+   auto b = Reshape(b_.HostRead(), Q1D, D1D);
+   auto g = Reshape(g_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D, Q1D, Q1D, 6, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   double B[Q1D][D1D], G[Q1D][D1D];
+   for (int q = 0; q < Q1D; ++q)
+   {
+      for (int d = 0; d < D1D; ++d)
+      {
+         B[q][d] = b(q,d);
+         G[q][d] = g(q,d);
+      }
+   }
+   for (int e0 = 0; e0 < NE; e0 += VL)
+   {
+      const int NV = (NE - e0 < VL) ? NE - e0 : VL;
+      double u[D1D][D1D][D1D][VL];
+      for (int v = 0; v < VL; ++v)
+      {
+         const bool valid = v < NV;
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  u[dz][dy][dx][v] = valid ? X(dx,dy,dz,e0+v) : 0.0;
+               }
+            }
+         }
+      }
+      // Contraction in x
+      double BX[D1D][D1D][Q1D][VL], GX[D1D][D1D][Q1D][VL];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double *sb = BX[dz][dy][qx], *sg = GX[dz][dy][qx];
+               for (int v = 0; v < VL; ++v) { sb[v] = sg[v] = 0.0; }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wb = B[qx][dx], wg = G[qx][dx];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     sb[v] += wb*u[dz][dy][dx][v];
+                     sg[v] += wg*u[dz][dy][dx][v];
+                  }
+               }
+            }
+         }
+      }
+      // Contraction in y
+      double BBX[D1D][Q1D][Q1D][VL], BGX[D1D][Q1D][Q1D][VL],
+             GBX[D1D][Q1D][Q1D][VL];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double *sbb = BBX[dz][qy][qx], *sbg = BGX[dz][qy][qx],
+                       *sgb = GBX[dz][qy][qx];
+               for (int v = 0; v < VL; ++v) { sbb[v] = sbg[v] = sgb[v] = 0.0; }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wb = B[qy][dy], wg = G[qy][dy];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     sbb[v] += wb*BX[dz][dy][qx][v];
+                     sbg[v] += wb*GX[dz][dy][qx][v];
+                     sgb[v] += wg*BX[dz][dy][qx][v];
+                  }
+               }
+            }
+         }
+      }
+      // For each z-plane of quadrature points: evaluate the gradient, apply
+      // the quadrature data and contract back in z.
+      double QQD0[Q1D][Q1D][D1D][VL], QQD1[Q1D][Q1D][D1D][VL],
+             QQD2[Q1D][Q1D][D1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int v = 0; v < VL; ++v)
+               {
+                  QQD0[qy][qx][dz][v] = 0.0;
+                  QQD1[qy][qx][dz][v] = 0.0;
+                  QQD2[qy][qx][dz][v] = 0.0;
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double dq[6][Q1D][Q1D][VL];
+         for (int v = 0; v < VL; ++v)
+         {
+            const bool valid = v < NV;
+            for (int k = 0; k < 6; ++k)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     dq[k][qy][qx][v] = valid ? D(qx,qy,qz,k,e0+v) : 0.0;
+                  }
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double gX[VL], gY[VL], gZ[VL];
+               for (int v = 0; v < VL; ++v) { gX[v] = gY[v] = gZ[v] = 0.0; }
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double wb = B[qz][dz], wg = G[qz][dz];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     gX[v] += wb*BGX[dz][qy][qx][v];
+                     gY[v] += wb*GBX[dz][qy][qx][v];
+                     gZ[v] += wg*BBX[dz][qy][qx][v];
+                  }
+               }
+               double f0[VL], f1[VL], f2[VL];
+               for (int v = 0; v < VL; ++v)
+               {
+                  const double O11 = dq[0][qy][qx][v];
+                  const double O12 = dq[1][qy][qx][v];
+                  const double O13 = dq[2][qy][qx][v];
+                  const double O22 = dq[3][qy][qx][v];
+                  const double O23 = dq[4][qy][qx][v];
+                  const double O33 = dq[5][qy][qx][v];
+                  f0[v] = (O11*gX[v]) + (O12*gY[v]) + (O13*gZ[v]);
+                  f1[v] = (O12*gX[v]) + (O22*gY[v]) + (O23*gZ[v]);
+                  f2[v] = (O13*gX[v]) + (O23*gY[v]) + (O33*gZ[v]);
+               }
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double wb = B[qz][dz], wg = G[qz][dz];
+                  double *s0 = QQD0[qy][qx][dz], *s1 = QQD1[qy][qx][dz],
+                          *s2 = QQD2[qy][qx][dz];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     s0[v] += wb*f0[v];
+                     s1[v] += wb*f1[v];
+                     s2[v] += wg*f2[v];
+                  }
+               }
+            }
+         }
+      }
+      // Contraction back in y
+      double QDD0[Q1D][D1D][D1D][VL], QDD1[Q1D][D1D][D1D][VL];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               // QDD0: x-derivative term, QDD1: sum of the y and z terms
+               double *s0 = QDD0[qx][dz][dy], *s1 = QDD1[qx][dz][dy];
+               for (int v = 0; v < VL; ++v) { s0[v] = s1[v] = 0.0; }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wb = B[qy][dy], wg = G[qy][dy];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     s0[v] += wb*QQD0[qy][qx][dz][v];
+                     s1[v] += wg*QQD1[qy][qx][dz][v] + wb*QQD2[qy][qx][dz][v];
+                  }
+               }
+            }
+         }
+      }
+      // Contraction back in x
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double *s = u[dz][dy][dx];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double wb = B[qx][dx], wg = G[qx][dx];
+                  for (int v = 0; v < VL; ++v)
+                  {
+                     s[v] += wg*QDD0[qx][dz][dy][v] + wb*QDD1[qx][dz][dy][v];
+                  }
+               }
+            }
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,dz,e0+v) += u[dz][dy][dx][v];
+               }
+            }
+         }
+      }
+   }
+}
+
+typedef void (*DiffusionApplyKernel)(const int, const Array<double>&,
+                                     const Array<double>&, const Array<double>&,
+                                     const Array<double>&, const Vector&,
+                                     const Vector&, Vector&, const int,
+                                     const int);
+
+template<int T_D1D, int T_Q1D> struct DiffusionApply2DInstance
+{
+   static DiffusionApplyKernel Get()
+   { return SmemPADiffusionApply2D<T_D1D,T_Q1D,KernelNBZ(T_Q1D)>; }
+};
+
+template<int T_D1D, int T_Q1D> struct DiffusionApply3DInstance
+{
+   static DiffusionApplyKernel Get()
+   { return SmemPADiffusionApply3D<T_D1D,T_Q1D>; }
+};
+
+static DiffusionApplyKernel FindDiffusionApplyKernel(const int dim,
+                                                     const int D1D,
+                                                     const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<DiffusionApplyKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<DiffusionApply2DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k2D);
+         KernelRange<DiffusionApply3DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
+template<int T_D1D, int T_Q1D> struct SimdDiffusionApply2DInstance
+{
+   static DiffusionApplyKernel Get()
+   { return SimdPADiffusionApply2D<T_D1D,T_Q1D>; }
+};
+
+template<int T_D1D, int T_Q1D> struct SimdDiffusionApply3DInstance
+{
+   static DiffusionApplyKernel Get()
+   { return SimdPADiffusionApply3D<T_D1D,T_Q1D>; }
+};
+
+// The Backend::SIMD kernels are instantiated for low orders, where the
+// vectorization across the elements pays off.
+static DiffusionApplyKernel FindSimdDiffusionApplyKernel(const int dim,
+                                                         const int D1D,
+                                                         const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<DiffusionApplyKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<SimdDiffusionApply2DInstance, 2, 7, 2>::Add(k2D);
+         KernelRange<SimdDiffusionApply3DInstance, 2, 7, 2>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1521,6 +2030,14 @@ static void PADiffusionApply(const int dim,
       MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+   if (Device::Allows(Backend::SIMD) && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      DiffusionApplyKernel kernel = FindSimdDiffusionApplyKernel(dim, D1D, Q1D);
+      if (kernel)
+      {
+         return kernel(NE,B,G,Bt,Gt,D,X,Y,0,0);
+      }
+   }
    if (dim == 2)
    {
       switch ((D1D << 4 ) | Q1D)
@@ -1533,7 +2050,7 @@ static void PADiffusionApply(const int dim,
          case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,Bt,Gt,D,X,Y);
          case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,Bt,Gt,D,X,Y);
          case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:   break;
       }
    }
    else if (dim == 3)
@@ -1549,10 +2066,19 @@ static void PADiffusionApply(const int dim,
          case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,Bt,Gt,D,X,Y);
          case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,Bt,Gt,D,X,Y);
          case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:   break;
       }
    }
-   MFEM_ABORT("Unknown kernel.");
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   if (DiffusionApplyKernel kernel = FindDiffusionApplyKernel(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,G,Bt,Gt,D,X,Y,0,0);
+   }
+   if (dim == 2) { return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D); }
+   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
 }
 
 // PA Diffusion Apply kernel
@@ -1594,4 +2120,20 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void DiffusionIntegrator::AddMultPAElements(const Vector &x, Vector &y,
+                                            int e_begin, int e_end) const
+{
+   const int n = e_end - e_begin;
+   if (n <= 0) { return; }
+   // The E-vectors and the quadrature data are stored element by element
+   const int nd = x.Size()/ne, nqd = pa_data.Size()/ne;
+   Vector x_e, y_e, d_e;
+   x_e.MakeRef(const_cast<Vector&>(x), nd*e_begin, nd*n);
+   y_e.MakeRef(y, nd*e_begin, nd*n);
+   d_e.MakeRef(const_cast<Vector&>(pa_data), nqd*e_begin, nqd*n);
+   PADiffusionApply(dim, dofs1D, quad1D, n,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    d_e, x_e, y_e);
+}
+
 } // namespace mfem
@@ -0,0 +1,260 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// EA Diffusion Integrator
+
+// The element matrices are computed from the symmetric quadrature data of the
+// partial assembly with sum factorization. For each pair (a,b) of reference
+// derivative directions, the 1D factor in direction m is X(q,i)*Y(q,j) with X
+// (resp. Y) equal to G if m == a (resp. m == b) and to B otherwise.
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EADiffusionAssemble2D(const int NE,
+                                  const Array<double> &b,
+                                  const Array<double> &g,
+                                  const Vector &padata,
+                                  Vector &eadata,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, 3, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      for (int i2 = 0; i2 < D1D; ++i2)
+      {
+         for (int j2 = 0; j2 < D1D; ++j2)
+         {
+            // r_U[ab][k1]: contraction in y of the (a,b) term
+            double r_U[4][MQ1];
+            for (int k1 = 0; k1 < Q1D; ++k1)
+            {
+               double u00 = 0.0, u01 = 0.0, u10 = 0.0, u11 = 0.0;
+               for (int k2 = 0; k2 < Q1D; ++k2)
+               {
+                  const double D00 = D(k1,k2,0,e);
+                  const double D01 = D(k1,k2,1,e);
+                  const double D11 = D(k1,k2,2,e);
+                  u00 += r_B[k2][i2] * r_B[k2][j2] * D00;
+                  u01 += r_B[k2][i2] * r_G[k2][j2] * D01;
+                  u10 += r_G[k2][i2] * r_B[k2][j2] * D01;
+                  u11 += r_G[k2][i2] * r_G[k2][j2] * D11;
+               }
+               r_U[0][k1] = u00;
+               r_U[1][k1] = u01;
+               r_U[2][k1] = u10;
+               r_U[3][k1] = u11;
+            }
+            for (int i1 = 0; i1 < D1D; ++i1)
+            {
+               for (int j1 = 0; j1 < D1D; ++j1)
+               {
+                  double val = 0.0;
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     val += r_G[k1][i1] * r_G[k1][j1] * r_U[0][k1]
+                            + r_G[k1][i1] * r_B[k1][j1] * r_U[1][k1]
+                            + r_B[k1][i1] * r_G[k1][j1] * r_U[2][k1]
+                            + r_B[k1][i1] * r_B[k1][j1] * r_U[3][k1];
+                  }
+                  M(j1,j2,i1,i2,e) += val;
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EADiffusionAssemble3D(const int NE,
+                                  const Array<double> &b,
+                                  const Array<double> &g,
+                                  const Vector &padata,
+                                  Vector &eadata,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, 6, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      // index of the (a,b) entry in the symmetric quadrature data
+      const int sym[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      for (int i3 = 0; i3 < D1D; ++i3)
+      {
+         for (int j3 = 0; j3 < D1D; ++j3)
+         {
+            // r_T[a][b][k1][k2]: contraction in z of the (a,b) term
+            double r_T[3][3][MQ1][MQ1];
+            for (int a = 0; a < 3; ++a)
+            {
+               for (int bb = 0; bb < 3; ++bb)
+               {
+                  const int s = sym[a][bb];
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     for (int k2 = 0; k2 < Q1D; ++k2)
+                     {
+                        double val = 0.0;
+                        for (int k3 = 0; k3 < Q1D; ++k3)
+                        {
+                           const double X = (a == 2) ? r_G[k3][i3] : r_B[k3][i3];
+                           const double Y = (bb == 2) ? r_G[k3][j3] : r_B[k3][j3];
+                           val += X * Y * D(k1,k2,k3,s,e);
+                        }
+                        r_T[a][bb][k1][k2] = val;
+                     }
+                  }
+               }
+            }
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  // r_U[a][b][k1]: contraction in y of the (a,b) term
+                  double r_U[3][3][MQ1];
+                  for (int a = 0; a < 3; ++a)
+                  {
+                     for (int bb = 0; bb < 3; ++bb)
+                     {
+                        for (int k1 = 0; k1 < Q1D; ++k1)
+                        {
+                           double val = 0.0;
+                           for (int k2 = 0; k2 < Q1D; ++k2)
+                           {
+                              const double X =
+                                 (a == 1) ? r_G[k2][i2] : r_B[k2][i2];
+                              const double Y =
+                                 (bb == 1) ? r_G[k2][j2] : r_B[k2][j2];
+                              val += X * Y * r_T[a][bb][k1][k2];
+                           }
+                           r_U[a][bb][k1] = val;
+                        }
+                     }
+                  }
+                  for (int i1 = 0; i1 < D1D; ++i1)
+                  {
+                     for (int j1 = 0; j1 < D1D; ++j1)
+                     {
+                        double val = 0.0;
+                        for (int a = 0; a < 3; ++a)
+                        {
+                           for (int bb = 0; bb < 3; ++bb)
+                           {
+                              for (int k1 = 0; k1 < Q1D; ++k1)
+                              {
+                                 const double X =
+                                    (a == 0) ? r_G[k1][i1] : r_B[k1][i1];
+                                 const double Y =
+                                    (bb == 0) ? r_G[k1][j1] : r_B[k1][j1];
+                                 val += X * Y * r_U[a][bb][k1];
+                              }
+                           }
+                        }
+                        M(j1,j2,j3,i1,i2,i3,e) += val;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void DiffusionIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                     Vector &ea_data)
+{
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const int mdim = mesh->Dimension();
+   if (MQ || !UsesTensorBasis(fes) || fes.GetVDim() != 1 || mdim == 1)
+   {
+      return BilinearFormIntegrator::AssembleEA(fes, ea_data);
+   }
+   SetupPA(fes, true);
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x22: return EADiffusionAssemble2D<2,2>(ne,B,G,pa_data,ea_data);
+         case 0x33: return EADiffusionAssemble2D<3,3>(ne,B,G,pa_data,ea_data);
+         case 0x44: return EADiffusionAssemble2D<4,4>(ne,B,G,pa_data,ea_data);
+         case 0x55: return EADiffusionAssemble2D<5,5>(ne,B,G,pa_data,ea_data);
+         case 0x66: return EADiffusionAssemble2D<6,6>(ne,B,G,pa_data,ea_data);
+         default:   return EADiffusionAssemble2D(ne,B,G,pa_data,ea_data,
+                                                    dofs1D,quad1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x23: return EADiffusionAssemble3D<2,3>(ne,B,G,pa_data,ea_data);
+         case 0x34: return EADiffusionAssemble3D<3,4>(ne,B,G,pa_data,ea_data);
+         case 0x45: return EADiffusionAssemble3D<4,5>(ne,B,G,pa_data,ea_data);
+         case 0x56: return EADiffusionAssemble3D<5,6>(ne,B,G,pa_data,ea_data);
+         default:   return EADiffusionAssemble3D(ne,B,G,pa_data,ea_data,
+                                                    dofs1D,quad1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+}
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../general/kernel_registry.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/mass.hpp"
@@ -400,6 +401,46 @@ static void SmemPAMassAssembleDiagonal3D(const int NE,
    });
 }
 
+// Range of (D1D,Q1D) pairs with specialized kernels in addition to the ones of
+// the switch tables, see KernelRange.
+static constexpr int REGISTRY_D1D_END = 11;
+static constexpr int REGISTRY_Q1D_EXTRA = 2;
+
+typedef void (*MassDiagonalKernel)(const int, const Array<double>&,
+                                   const Vector&, Vector&, const int,
+                                   const int);
+
+template<int T_D1D, int T_Q1D> struct MassDiagonal2DInstance
+{
+   static MassDiagonalKernel Get()
+   { return SmemPAMassAssembleDiagonal2D<T_D1D,T_Q1D,KernelNBZ(T_Q1D)>; }
+};
+
+template<int T_D1D, int T_Q1D> struct MassDiagonal3DInstance
+{
+   static MassDiagonalKernel Get()
+   { return SmemPAMassAssembleDiagonal3D<T_D1D,T_Q1D>; }
+};
+
+static MassDiagonalKernel FindMassDiagonalKernel(const int dim,
+                                                 const int D1D,
+                                                 const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<MassDiagonalKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<MassDiagonal2DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k2D);
+         KernelRange<MassDiagonal3DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
 static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const int Q1D, const int NE,
                                    const Array<double> &B,
@@ -418,7 +459,7 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
          case 0x77: return SmemPAMassAssembleDiagonal2D<7,7,4>(NE,B,D,Y);
          case 0x88: return SmemPAMassAssembleDiagonal2D<8,8,2>(NE,B,D,Y);
          case 0x99: return SmemPAMassAssembleDiagonal2D<9,9,2>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
+         default:   break;
       }
    }
    else if (dim == 3)
@@ -432,10 +473,19 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
          case 0x67: return SmemPAMassAssembleDiagonal3D<6,7>(NE,B,D,Y);
          case 0x78: return SmemPAMassAssembleDiagonal3D<7,8>(NE,B,D,Y);
          case 0x89: return SmemPAMassAssembleDiagonal3D<8,9>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
+         default:   break;
       }
    }
-   MFEM_ABORT("Unknown kernel.");
+   else
+   {
+      MFEM_ABORT("Unknown kernel.");
+   }
+   if (MassDiagonalKernel kernel = FindMassDiagonalKernel(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,D,Y,0,0);
+   }
+   if (dim == 2) { return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D); }
+   return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
 }
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
@@ -1118,6 +1168,365 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+// PA Mass Apply 2D kernel for Backend::SIMD. The elements are processed in
+// batches of SIMD_LANES: the E-vector and the quadrature data of a batch are
+// copied in lane-interleaved arrays, with the element as the innermost index,
+// so that the compiler vectorizes the sum factorization across the elements.
+template<int T_D1D, int T_Q1D>
+static void SimdPAMassApply2D(const int NE,
+                              const Array<double> &b_,
+                              const Array<double> &bt_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int d1d = 0,
+                              const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int VL = SIMD_LANES;
+   auto b = Reshape(b_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, NE);
+   double B[Q1D][D1D];
+   for (int q = 0; q < Q1D; ++q)
+   {
+      for (int d = 0; d < D1D; ++d) { B[q][d] = b(q,d); }
+   }
+   for (int e0 = 0; e0 < NE; e0 += VL)
+   {
+      const int NV = (NE - e0 < VL) ? NE - e0 : VL;
+      double u[D1D][D1D][VL], dq[Q1D][Q1D][VL];
+      for (int v = 0; v < VL; ++v)
+      {
+         const bool valid = v < NV;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               u[dy][dx][v] = valid ? X(dx,dy,e0+v) : 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               dq[qy][qx][v] = valid ? D(qx,qy,e0+v) : 0.0;
+            }
+         }
+      }
+      double DQ[D1D][Q1D][VL];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double *s = DQ[dy][qx];
+            for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double w = B[qx][dx];
+               for (int v = 0; v < VL; ++v) { s[v] += w*u[dy][dx][v]; }
+            }
+         }
+      }
+      double QQ[Q1D][Q1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double *s = QQ[qy][qx];
+            for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double w = B[qy][dy];
+               for (int v = 0; v < VL; ++v) { s[v] += w*DQ[dy][qx][v]; }
+            }
+            for (int v = 0; v < VL; ++v) { s[v] *= dq[qy][qx][v]; }
+         }
+      }
+      double QD[Q1D][D1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double *s = QD[qy][dx];
+            for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double w = B[qx][dx];
+               for (int v = 0; v < VL; ++v) { s[v] += w*QQ[qy][qx][v]; }
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double *s = u[dy][dx];
+            for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double w = B[qy][dy];
+               for (int v = 0; v < VL; ++v) { s[v] += w*QD[qy][dx][v]; }
+            }
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx) { Y(dx,dy,e0+v) += u[dy][dx][v]; }
+         }
+      }
+   }
+}
+
+// PA Mass Apply 3D kernel for Backend::SIMD, see SimdPAMassApply2D. The
+// quadrature data of a batch is copied one z-plane at a time.
+template<int T_D1D, int T_Q1D>
+static void SimdPAMassApply3D(const int NE,
+                              const Array<double> &b_,
+                              const Array<double> &bt_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int d1d = 0,
+                              const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int VL = SIMD_LANES;
+   auto b = Reshape(b_.HostRead(), Q1D, D1D);
+   auto D = Reshape(d_.HostRead(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   double B[Q1D][D1D];
+   for (int q = 0; q < Q1D; ++q)
+   {
+      for (int d = 0; d < D1D; ++d) { B[q][d] = b(q,d); }
+   }
+   for (int e0 = 0; e0 < NE; e0 += VL)
+   {
+      const int NV = (NE - e0 < VL) ? NE - e0 : VL;
+      double u[D1D][D1D][D1D][VL];
+      for (int v = 0; v < VL; ++v)
+      {
+         const bool valid = v < NV;
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  u[dz][dy][dx][v] = valid ? X(dx,dy,dz,e0+v) : 0.0;
+               }
+            }
+         }
+      }
+      double DDQ[D1D][D1D][Q1D][VL];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double *s = DDQ[dz][dy][qx];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double w = B[qx][dx];
+                  for (int v = 0; v < VL; ++v) { s[v] += w*u[dz][dy][dx][v]; }
+               }
+            }
+         }
+      }
+      double DQQ[D1D][Q1D][Q1D][VL];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double *s = DQQ[dz][qy][qx];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double w = B[qy][dy];
+                  for (int v = 0; v < VL; ++v) { s[v] += w*DDQ[dz][dy][qx][v]; }
+               }
+            }
+         }
+      }
+      // For each z-plane of quadrature points: evaluate, scale by the
+      // quadrature data and contract back in z.
+      double QQD[Q1D][Q1D][D1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int v = 0; v < VL; ++v) { QQD[qy][qx][dz][v] = 0.0; }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double dq[Q1D][Q1D][VL];
+         for (int v = 0; v < VL; ++v)
+         {
+            const bool valid = v < NV;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  dq[qy][qx][v] = valid ? D(qx,qy,qz,e0+v) : 0.0;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double s[VL];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double w = B[qz][dz];
+                  for (int v = 0; v < VL; ++v) { s[v] += w*DQQ[dz][qy][qx][v]; }
+               }
+               for (int v = 0; v < VL; ++v) { s[v] *= dq[qy][qx][v]; }
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double w = B[qz][dz];
+                  double *t = QQD[qy][qx][dz];
+                  for (int v = 0; v < VL; ++v) { t[v] += w*s[v]; }
+               }
+            }
+         }
+      }
+      double QDD[Q1D][D1D][D1D][VL];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double *s = QDD[qy][dz][dx];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double w = B[qx][dx];
+                  for (int v = 0; v < VL; ++v) { s[v] += w*QQD[qy][qx][dz][v]; }
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double *s = u[dz][dy][dx];
+               for (int v = 0; v < VL; ++v) { s[v] = 0.0; }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double w = B[qy][dy];
+                  for (int v = 0; v < VL; ++v) { s[v] += w*QDD[qy][dz][dx][v]; }
+               }
+            }
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,dz,e0+v) += u[dz][dy][dx][v];
+               }
+            }
+         }
+      }
+   }
+}
+
+typedef void (*MassApplyKernel)(const int, const Array<double>&,
+                                const Array<double>&, const Vector&,
+                                const Vector&, Vector&, const int, const int);
+
+template<int T_D1D, int T_Q1D> struct MassApply2DInstance
+{
+   static MassApplyKernel Get()
+   { return SmemPAMassApply2D<T_D1D,T_Q1D,KernelNBZ(T_Q1D)>; }
+};
+
+template<int T_D1D, int T_Q1D> struct MassApply3DInstance
+{
+   static MassApplyKernel Get()
+   { return SmemPAMassApply3D<T_D1D,T_Q1D>; }
+};
+
+static MassApplyKernel FindMassApplyKernel(const int dim,
+                                           const int D1D,
+                                           const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<MassApplyKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<MassApply2DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k2D);
+         KernelRange<MassApply3DInstance, 2, REGISTRY_D1D_END,
+                     REGISTRY_Q1D_EXTRA>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
+template<int T_D1D, int T_Q1D> struct SimdMassApply2DInstance
+{
+   static MassApplyKernel Get()
+   { return SimdPAMassApply2D<T_D1D,T_Q1D>; }
+};
+
+template<int T_D1D, int T_Q1D> struct SimdMassApply3DInstance
+{
+   static MassApplyKernel Get()
+   { return SimdPAMassApply3D<T_D1D,T_Q1D>; }
+};
+
+// The Backend::SIMD kernels are instantiated for low orders, where the
+// vectorization across the elements pays off.
+static MassApplyKernel FindSimdMassApplyKernel(const int dim,
+                                               const int D1D,
+                                               const int Q1D)
+{
+   struct Registries
+   {
+      KernelRegistry<MassApplyKernel> k2D, k3D;
+      Registries()
+      {
+         KernelRange<SimdMassApply2DInstance, 2, 7, 2>::Add(k2D);
+         KernelRange<SimdMassApply3DInstance, 2, 7, 2>::Add(k3D);
+      }
+   };
+   static const Registries kernels;
+   return (dim == 2 ? kernels.k2D : kernels.k3D).Find(D1D, Q1D);
+}
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1142,6 +1551,13 @@ static void PAMassApply(const int dim,
       MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+   if (Device::Allows(Backend::SIMD) && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      if (MassApplyKernel kernel = FindSimdMassApplyKernel(dim, D1D, Q1D))
+      {
+         return kernel(NE,B,Bt,D,X,Y,0,0);
+      }
+   }
    const int id = (D1D << 4) | Q1D;
    if (dim == 2)
    {
@@ -1160,7 +1576,7 @@ static void PAMassApply(const int dim,
          case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
          case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
          case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:   break;
       }
    }
    else if (dim == 3)
@@ -1180,11 +1596,20 @@ static void PAMassApply(const int dim,
          case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
          case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
          case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:   break;
       }
    }
-   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
-   MFEM_ABORT("Unknown kernel.");
+   else
+   {
+      mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
+      MFEM_ABORT("Unknown kernel.");
+   }
+   if (MassApplyKernel kernel = FindMassApplyKernel(dim, D1D, Q1D))
+   {
+      return kernel(NE,B,Bt,D,X,Y,0,0);
+   }
+   if (dim == 2) { return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D); }
+   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
 }
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
@@ -1223,4 +1648,18 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void MassIntegrator::AddMultPAElements(const Vector &x, Vector &y,
+                                       int e_begin, int e_end) const
+{
+   const int n = e_end - e_begin;
+   if (n <= 0) { return; }
+   // The E-vectors and the quadrature data are stored element by element
+   const int nd = x.Size()/ne, nqd = pa_data.Size()/ne;
+   Vector x_e, y_e, d_e;
+   x_e.MakeRef(const_cast<Vector&>(x), nd*e_begin, nd*n);
+   y_e.MakeRef(y, nd*e_begin, nd*n);
+   d_e.MakeRef(const_cast<Vector&>(pa_data), nqd*e_begin, nqd*n);
+   PAMassApply(dim, dofs1D, quad1D, n, maps->B, maps->Bt, d_e, x_e, y_e);
+}
+
 } // namespace mfem
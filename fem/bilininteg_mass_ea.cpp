@@ -0,0 +1,205 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// EA Mass Integrator
+
+// The element matrices are computed from the quadrature data of the partial
+// assembly with sum factorization: the contractions over the quadrature points
+// are done one direction at a time, using the products B(q,i)*B(q,j) of the 1D
+// basis functions.
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAMassAssemble2D(const int NE,
+                             const Array<double> &basis,
+                             const Vector &padata,
+                             Vector &eadata,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(basis.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+         }
+      }
+      for (int i2 = 0; i2 < D1D; ++i2)
+      {
+         for (int j2 = 0; j2 < D1D; ++j2)
+         {
+            double r_U[MQ1];
+            for (int k1 = 0; k1 < Q1D; ++k1)
+            {
+               double val = 0.0;
+               for (int k2 = 0; k2 < Q1D; ++k2)
+               {
+                  val += r_B[k2][i2] * r_B[k2][j2] * D(k1,k2,e);
+               }
+               r_U[k1] = val;
+            }
+            for (int i1 = 0; i1 < D1D; ++i1)
+            {
+               for (int j1 = 0; j1 < D1D; ++j1)
+               {
+                  double val = 0.0;
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     val += r_B[k1][i1] * r_B[k1][j1] * r_U[k1];
+                  }
+                  M(j1,j2,i1,i2,e) += val;
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAMassAssemble3D(const int NE,
+                             const Array<double> &basis,
+                             const Vector &padata,
+                             Vector &eadata,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(basis.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, NE);
+   auto M = Reshape(eadata.ReadWrite(), D1D, D1D, D1D, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+         }
+      }
+      for (int i3 = 0; i3 < D1D; ++i3)
+      {
+         for (int j3 = 0; j3 < D1D; ++j3)
+         {
+            double r_T[MQ1][MQ1];
+            for (int k1 = 0; k1 < Q1D; ++k1)
+            {
+               for (int k2 = 0; k2 < Q1D; ++k2)
+               {
+                  double val = 0.0;
+                  for (int k3 = 0; k3 < Q1D; ++k3)
+                  {
+                     val += r_B[k3][i3] * r_B[k3][j3] * D(k1,k2,k3,e);
+                  }
+                  r_T[k1][k2] = val;
+               }
+            }
+            for (int i2 = 0; i2 < D1D; ++i2)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  double r_U[MQ1];
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     double val = 0.0;
+                     for (int k2 = 0; k2 < Q1D; ++k2)
+                     {
+                        val += r_B[k2][i2] * r_B[k2][j2] * r_T[k1][k2];
+                     }
+                     r_U[k1] = val;
+                  }
+                  for (int i1 = 0; i1 < D1D; ++i1)
+                  {
+                     for (int j1 = 0; j1 < D1D; ++j1)
+                     {
+                        double val = 0.0;
+                        for (int k1 = 0; k1 < Q1D; ++k1)
+                        {
+                           val += r_B[k1][i1] * r_B[k1][j1] * r_U[k1];
+                        }
+                        M(j1,j2,j3,i1,i2,i3,e) += val;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                Vector &ea_data)
+{
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const int mdim = mesh->Dimension();
+   if (!UsesTensorBasis(fes) || fes.GetVDim() != 1 || mdim == 1)
+   {
+      return BilinearFormIntegrator::AssembleEA(fes, ea_data);
+   }
+   SetupPA(fes, true);
+   const Array<double> &B = maps->B;
+   if (dim == 2)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x22: return EAMassAssemble2D<2,2>(ne,B,pa_data,ea_data);
+         case 0x33: return EAMassAssemble2D<3,3>(ne,B,pa_data,ea_data);
+         case 0x44: return EAMassAssemble2D<4,4>(ne,B,pa_data,ea_data);
+         case 0x55: return EAMassAssemble2D<5,5>(ne,B,pa_data,ea_data);
+         case 0x66: return EAMassAssemble2D<6,6>(ne,B,pa_data,ea_data);
+         default:   return EAMassAssemble2D(ne,B,pa_data,ea_data,
+                                               dofs1D,quad1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x23: return EAMassAssemble3D<2,3>(ne,B,pa_data,ea_data);
+         case 0x34: return EAMassAssemble3D<3,4>(ne,B,pa_data,ea_data);
+         case 0x45: return EAMassAssemble3D<4,5>(ne,B,pa_data,ea_data);
+         case 0x56: return EAMassAssemble3D<5,6>(ne,B,pa_data,ea_data);
+         default:   return EAMassAssemble3D(ne,B,pa_data,ea_data,
+                                               dofs1D,quad1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+}
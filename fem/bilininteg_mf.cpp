@@ -0,0 +1,1133 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// MF Mass and Diffusion Integrators
+
+// The matrix-free kernels do not store any data at the quadrature points: the
+// Jacobians of the element transformations are recomputed in each application
+// from the element-local mesh nodes, using the tensor-product structure of the
+// nodal finite element space. Only non-constant coefficients are evaluated
+// once, at setup.
+
+// Setup shared by the MF integrators: the E-vector of the mesh nodes in
+// lexicographic ordering, the 1D maps of the nodal basis and the values of the
+// coefficient at the quadrature points (a single value when it is constant).
+static void MFSetup(const FiniteElementSpace &fes,
+                    const IntegrationRule &ir,
+                    Coefficient *Q,
+                    Vector &nodes,
+                    const DofToQuad *&nodes_maps,
+                    Vector &coeff)
+{
+   MFEM_VERIFY(UsesTensorBasis(fes) && fes.GetVDim() == 1,
+               "matrix-free assembly requires a scalar tensor-product space");
+   Mesh *mesh = fes.GetMesh();
+   mesh->EnsureNodes();
+   const FiniteElementSpace *nfes = mesh->GetNodalFESpace();
+   MFEM_VERIFY(UsesTensorBasis(*nfes),
+               "matrix-free assembly requires tensor-product mesh nodes");
+   MFEM_VERIFY(nfes->GetVDim() == mesh->Dimension(),
+               "matrix-free assembly requires spaceDim == dim");
+   const Operator *nodes_restrict =
+      nfes->GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   nodes.SetSize(nodes_restrict->Height(), Device::GetDeviceMemoryType());
+   nodes_restrict->Mult(*mesh->GetNodes(), nodes);
+   nodes_maps = &nfes->GetFE(0)->GetDofToQuad(ir, DofToQuad::TENSOR);
+
+   const int ne = fes.GetNE();
+   const int nq = ir.GetNPoints();
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      coeff.SetSize(nq * ne);
+      auto C = Reshape(coeff.HostWrite(), nq, ne);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation& T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir.IntPoint(q));
+         }
+      }
+   }
+}
+
+// Values of a scalar field at the quadrature points of a 2D element
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFValues2D(const int D1D, const int Q1D,
+                const double (&B)[MQ1][MD1],
+                const double (&u)[MD1][MD1],
+                double (&val)[MQ1][MQ1])
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         val[qy][qx] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      double valX[MQ1];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         valX[qx] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const double s = u[dy][dx];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            valX[qx] += s * B[qx][dx];
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy = B[qy][dy];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            val[qy][qx] += valX[qx] * wy;
+         }
+      }
+   }
+}
+
+// Transpose of MFValues2D, added to y
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFValuesT2D(const int D1D, const int Q1D,
+                 const double (&B)[MQ1][MD1],
+                 const double (&val)[MQ1][MQ1],
+                 double (&y)[MD1][MD1])
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      double valX[MD1];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         valX[dx] = 0.0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const double s = val[qy][qx];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            valX[dx] += s * B[qx][dx];
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy = B[qy][dy];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            y[dy][dx] += valX[dx] * wy;
+         }
+      }
+   }
+}
+
+// Reference gradient of a scalar field at the quadrature points of a 2D element
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFGrad2D(const int D1D, const int Q1D,
+              const double (&B)[MQ1][MD1],
+              const double (&G)[MQ1][MD1],
+              const double (&u)[MD1][MD1],
+              double (&grad)[MQ1][MQ1][2])
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      double gradX[MQ1][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const double s = u[dy][dx];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B[qx][dx];
+            gradX[qx][1] += s * G[qx][dx];
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy  = B[qy][dy];
+         const double wDy = G[qy][dy];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+}
+
+// Transpose of MFGrad2D, added to y
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFGradT2D(const int D1D, const int Q1D,
+               const double (&B)[MQ1][MD1],
+               const double (&G)[MQ1][MD1],
+               const double (&grad)[MQ1][MQ1][2],
+               double (&y)[MD1][MD1])
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      double gradX[MD1][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0.0;
+         gradX[dx][1] = 0.0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const double gX = grad[qy][qx][0];
+         const double gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] += gX * G[qx][dx];
+            gradX[dx][1] += gY * B[qx][dx];
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy  = B[qy][dy];
+         const double wDy = G[qy][dy];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            y[dy][dx] += gradX[dx][0] * wy + gradX[dx][1] * wDy;
+         }
+      }
+   }
+}
+
+// Values of a scalar field at the quadrature points of a 3D element
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFValues3D(const int D1D, const int Q1D,
+                const double (&B)[MQ1][MD1],
+                const double (&u)[MD1][MD1][MD1],
+                double (&val)[MQ1][MQ1][MQ1])
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            val[qz][qy][qx] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      double valXY[MQ1][MQ1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            valXY[qy][qx] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double valX[MQ1];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            valX[qx] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = u[dz][dy][dx];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               valX[qx] += s * B[qx][dx];
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy = B[qy][dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               valXY[qy][qx] += valX[qx] * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz = B[qz][dz];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               val[qz][qy][qx] += valXY[qy][qx] * wz;
+            }
+         }
+      }
+   }
+}
+
+// Transpose of MFValues3D, added to y
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFValuesT3D(const int D1D, const int Q1D,
+                 const double (&B)[MQ1][MD1],
+                 const double (&val)[MQ1][MQ1][MQ1],
+                 double (&y)[MD1][MD1][MD1])
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      double valXY[MD1][MD1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            valXY[dy][dx] = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double valX[MD1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            valX[dx] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s = val[qz][qy][qx];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               valX[dx] += s * B[qx][dx];
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy = B[qy][dy];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               valXY[dy][dx] += valX[dx] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz = B[qz][dz];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y[dz][dy][dx] += valXY[dy][dx] * wz;
+            }
+         }
+      }
+   }
+}
+
+// Reference gradient of a scalar field at the quadrature points of a 3D element
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFGrad3D(const int D1D, const int Q1D,
+              const double (&B)[MQ1][MD1],
+              const double (&G)[MQ1][MD1],
+              const double (&u)[MD1][MD1][MD1],
+              double (&grad)[MQ1][MQ1][MQ1][3])
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      double gradXY[MQ1][MQ1][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[MQ1][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = u[dz][dy][dx];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B[qx][dx];
+               gradX[qx][1] += s * G[qx][dx];
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B[qy][dy];
+            const double wDy = G[qy][dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double wx  = gradX[qx][0];
+               const double wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz  = B[qz][dz];
+         const double wDz = G[qz][dz];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+            }
+         }
+      }
+   }
+}
+
+// Transpose of MFGrad3D, added to y
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void MFGradT3D(const int D1D, const int Q1D,
+               const double (&B)[MQ1][MD1],
+               const double (&G)[MQ1][MD1],
+               const double (&grad)[MQ1][MQ1][MQ1][3],
+               double (&y)[MD1][MD1][MD1])
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      double gradXY[MD1][MD1][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0.0;
+            gradXY[dy][dx][1] = 0.0;
+            gradXY[dy][dx][2] = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[MD1][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+            gradX[dx][2] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qz][qy][qx][0];
+            const double gY = grad[qz][qy][qx][1];
+            const double gZ = grad[qz][qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = B[qx][dx];
+               const double wDx = G[qx][dx];
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = B[qy][dy];
+            const double wDy = G[qy][dy];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz  = B[qz][dz];
+         const double wDz = G[qz][dz];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y[dz][dy][dx] += (gradXY[dy][dx][0] * wz) +
+                                (gradXY[dy][dx][1] * wz) +
+                                (gradXY[dy][dx][2] * wDz);
+            }
+         }
+      }
+   }
+}
+
+// MF Mass Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply2D(const int NE,
+                          const Array<double> &b_,
+                          const Array<double> &bn_,
+                          const Array<double> &gn_,
+                          const Array<double> &w_,
+                          const Vector &nodes_,
+                          const Vector &c_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int nd1d,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND1D = nd1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bn = Reshape(bn_.Read(), Q1D, ND1D);
+   auto Gn = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D);
+   auto N = Reshape(nodes_.Read(), ND1D, ND1D, 2, NE);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MN1 = MAX_D1D;
+      double r_B[MQ1][MD1];
+      double r_Bn[MQ1][MN1], r_Gn[MQ1][MN1];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int d = 0; d < D1D; ++d) { r_B[q][d] = B(q,d); }
+         for (int d = 0; d < ND1D; ++d)
+         {
+            r_Bn[q][d] = Bn(q,d);
+            r_Gn[q][d] = Gn(q,d);
+         }
+      }
+      // Jacobian of the element transformation at the quadrature points
+      double r_J[2][MQ1][MQ1][2];
+      for (int c = 0; c < 2; ++c)
+      {
+         double r_n[MN1][MN1];
+         for (int dy = 0; dy < ND1D; ++dy)
+         {
+            for (int dx = 0; dx < ND1D; ++dx)
+            {
+               r_n[dy][dx] = N(dx,dy,c,e);
+            }
+         }
+         MFGrad2D<MN1,MQ1>(ND1D, Q1D, r_Bn, r_Gn, r_n, r_J[c]);
+      }
+      double r_u[MD1][MD1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            r_u[dy][dx] = X(dx,dy,e);
+         }
+      }
+      double r_val[MQ1][MQ1];
+      MFValues2D<MD1,MQ1>(D1D, Q1D, r_B, r_u, r_val);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = r_J[0][qy][qx][0];
+            const double J12 = r_J[0][qy][qx][1];
+            const double J21 = r_J[1][qy][qx][0];
+            const double J22 = r_J[1][qy][qx][1];
+            const double detJ = (J11*J22)-(J21*J12);
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            r_val[qy][qx] *= W(qx,qy) * coeff * detJ;
+         }
+      }
+      double r_y[MD1][MD1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            r_y[dy][dx] = 0.0;
+         }
+      }
+      MFValuesT2D<MD1,MQ1>(D1D, Q1D, r_B, r_val, r_y);
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            Y(dx,dy,e) += r_y[dy][dx];
+         }
+      }
+   });
+}
+
+// MF Mass Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply3D(const int NE,
+                          const Array<double> &b_,
+                          const Array<double> &bn_,
+                          const Array<double> &gn_,
+                          const Array<double> &w_,
+                          const Vector &nodes_,
+                          const Vector &c_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int nd1d,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND1D = nd1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bn = Reshape(bn_.Read(), Q1D, ND1D);
+   auto Gn = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   auto N = Reshape(nodes_.Read(), ND1D, ND1D, ND1D, 3, NE);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MN1 = MAX_D1D;
+      double r_B[MQ1][MD1];
+      double r_Bn[MQ1][MN1], r_Gn[MQ1][MN1];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int d = 0; d < D1D; ++d) { r_B[q][d] = B(q,d); }
+         for (int d = 0; d < ND1D; ++d)
+         {
+            r_Bn[q][d] = Bn(q,d);
+            r_Gn[q][d] = Gn(q,d);
+         }
+      }
+      // Jacobian of the element transformation at the quadrature points
+      double r_J[3][MQ1][MQ1][MQ1][3];
+      for (int c = 0; c < 3; ++c)
+      {
+         double r_n[MN1][MN1][MN1];
+         for (int dz = 0; dz < ND1D; ++dz)
+         {
+            for (int dy = 0; dy < ND1D; ++dy)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  r_n[dz][dy][dx] = N(dx,dy,dz,c,e);
+               }
+            }
+         }
+         MFGrad3D<MN1,MQ1>(ND1D, Q1D, r_Bn, r_Gn, r_n, r_J[c]);
+      }
+      double r_u[MD1][MD1][MD1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               r_u[dz][dy][dx] = X(dx,dy,dz,e);
+            }
+         }
+      }
+      double r_val[MQ1][MQ1][MQ1];
+      MFValues3D<MD1,MQ1>(D1D, Q1D, r_B, r_u, r_val);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double J11 = r_J[0][qz][qy][qx][0];
+               const double J12 = r_J[0][qz][qy][qx][1];
+               const double J13 = r_J[0][qz][qy][qx][2];
+               const double J21 = r_J[1][qz][qy][qx][0];
+               const double J22 = r_J[1][qz][qy][qx][1];
+               const double J23 = r_J[1][qz][qy][qx][2];
+               const double J31 = r_J[2][qz][qy][qx][0];
+               const double J32 = r_J[2][qz][qy][qx][1];
+               const double J33 = r_J[2][qz][qy][qx][2];
+               const double detJ = J11 * (J22 * J33 - J32 * J23) -
+               /* */               J21 * (J12 * J33 - J32 * J13) +
+               /* */               J31 * (J12 * J23 - J22 * J13);
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               r_val[qz][qy][qx] *= W(qx,qy,qz) * coeff * detJ;
+            }
+         }
+      }
+      double r_y[MD1][MD1][MD1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               r_y[dz][dy][dx] = 0.0;
+            }
+         }
+      }
+      MFValuesT3D<MD1,MQ1>(D1D, Q1D, r_B, r_val, r_y);
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,dz,e) += r_y[dz][dy][dx];
+            }
+         }
+      }
+   });
+}
+
+void MassIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   mf_ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   nq = mf_ir->GetNPoints();
+   maps = &el.GetDofToQuad(*mf_ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   MFSetup(fes, *mf_ir, Q, mf_nodes, mf_nodes_maps, mf_coeff);
+}
+
+void MassIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int ND1D = mf_nodes_maps->ndof;
+   const Array<double> &B = maps->B;
+   const Array<double> &Bn = mf_nodes_maps->B;
+   const Array<double> &Gn = mf_nodes_maps->G;
+   const Array<double> &W = mf_ir->GetWeights();
+   const Vector &N = mf_nodes;
+   const Vector &C = mf_coeff;
+   const int id = (dofs1D << 4) | quad1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return MFMassApply2D<2,2>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x33: return MFMassApply2D<3,3>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x44: return MFMassApply2D<4,4>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x55: return MFMassApply2D<5,5>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         default: return MFMassApply2D(ne,B,Bn,Gn,W,N,C,x,y,ND1D,
+                                          dofs1D,quad1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: return MFMassApply3D<2,3>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x34: return MFMassApply3D<3,4>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x45: return MFMassApply3D<4,5>(ne,B,Bn,Gn,W,N,C,x,y,ND1D);
+         default: return MFMassApply3D(ne,B,Bn,Gn,W,N,C,x,y,ND1D,
+                                          dofs1D,quad1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// MF Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply2D(const int NE,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bn_,
+                               const Array<double> &gn_,
+                               const Array<double> &w_,
+                               const Vector &nodes_,
+                               const Vector &c_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int nd1d,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND1D = nd1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bn = Reshape(bn_.Read(), Q1D, ND1D);
+   auto Gn = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D);
+   auto N = Reshape(nodes_.Read(), ND1D, ND1D, 2, NE);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MN1 = MAX_D1D;
+      double r_B[MQ1][MD1], r_G[MQ1][MD1];
+      double r_Bn[MQ1][MN1], r_Gn[MQ1][MN1];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int d = 0; d < D1D; ++d)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+         for (int d = 0; d < ND1D; ++d)
+         {
+            r_Bn[q][d] = Bn(q,d);
+            r_Gn[q][d] = Gn(q,d);
+         }
+      }
+      // Jacobian of the element transformation at the quadrature points
+      double r_J[2][MQ1][MQ1][2];
+      for (int c = 0; c < 2; ++c)
+      {
+         double r_n[MN1][MN1];
+         for (int dy = 0; dy < ND1D; ++dy)
+         {
+            for (int dx = 0; dx < ND1D; ++dx)
+            {
+               r_n[dy][dx] = N(dx,dy,c,e);
+            }
+         }
+         MFGrad2D<MN1,MQ1>(ND1D, Q1D, r_Bn, r_Gn, r_n, r_J[c]);
+      }
+      double r_u[MD1][MD1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            r_u[dy][dx] = X(dx,dy,e);
+         }
+      }
+      double r_grad[MQ1][MQ1][2];
+      MFGrad2D<MD1,MQ1>(D1D, Q1D, r_B, r_G, r_u, r_grad);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = r_J[0][qy][qx][0];
+            const double J12 = r_J[0][qy][qx][1];
+            const double J21 = r_J[1][qy][qx][0];
+            const double J22 = r_J[1][qy][qx][1];
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            const double c_detJ = W(qx,qy) * coeff / ((J11*J22)-(J21*J12));
+            const double O11 =  c_detJ * (J12*J12 + J22*J22);
+            const double O12 = -c_detJ * (J12*J11 + J22*J21);
+            const double O22 =  c_detJ * (J11*J11 + J21*J21);
+            const double gradX = r_grad[qy][qx][0];
+            const double gradY = r_grad[qy][qx][1];
+            r_grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+            r_grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+         }
+      }
+      double r_y[MD1][MD1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            r_y[dy][dx] = 0.0;
+         }
+      }
+      MFGradT2D<MD1,MQ1>(D1D, Q1D, r_B, r_G, r_grad, r_y);
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            Y(dx,dy,e) += r_y[dy][dx];
+         }
+      }
+   });
+}
+
+// MF Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply3D(const int NE,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bn_,
+                               const Array<double> &gn_,
+                               const Array<double> &w_,
+                               const Vector &nodes_,
+                               const Vector &c_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int nd1d,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int ND1D = nd1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(ND1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bn = Reshape(bn_.Read(), Q1D, ND1D);
+   auto Gn = Reshape(gn_.Read(), Q1D, ND1D);
+   auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   auto N = Reshape(nodes_.Read(), ND1D, ND1D, ND1D, 3, NE);
+   auto C = const_c ? Reshape(c_.Read(), 1, 1, 1, 1) :
+            Reshape(c_.Read(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MN1 = MAX_D1D;
+      double r_B[MQ1][MD1], r_G[MQ1][MD1];
+      double r_Bn[MQ1][MN1], r_Gn[MQ1][MN1];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int d = 0; d < D1D; ++d)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+         for (int d = 0; d < ND1D; ++d)
+         {
+            r_Bn[q][d] = Bn(q,d);
+            r_Gn[q][d] = Gn(q,d);
+         }
+      }
+      // Jacobian of the element transformation at the quadrature points
+      double r_J[3][MQ1][MQ1][MQ1][3];
+      for (int c = 0; c < 3; ++c)
+      {
+         double r_n[MN1][MN1][MN1];
+         for (int dz = 0; dz < ND1D; ++dz)
+         {
+            for (int dy = 0; dy < ND1D; ++dy)
+            {
+               for (int dx = 0; dx < ND1D; ++dx)
+               {
+                  r_n[dz][dy][dx] = N(dx,dy,dz,c,e);
+               }
+            }
+         }
+         MFGrad3D<MN1,MQ1>(ND1D, Q1D, r_Bn, r_Gn, r_n, r_J[c]);
+      }
+      double r_u[MD1][MD1][MD1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               r_u[dz][dy][dx] = X(dx,dy,dz,e);
+            }
+         }
+      }
+      double r_grad[MQ1][MQ1][MQ1][3];
+      MFGrad3D<MD1,MQ1>(D1D, Q1D, r_B, r_G, r_u, r_grad);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double J11 = r_J[0][qz][qy][qx][0];
+               const double J12 = r_J[0][qz][qy][qx][1];
+               const double J13 = r_J[0][qz][qy][qx][2];
+               const double J21 = r_J[1][qz][qy][qx][0];
+               const double J22 = r_J[1][qz][qy][qx][1];
+               const double J23 = r_J[1][qz][qy][qx][2];
+               const double J31 = r_J[2][qz][qy][qx][0];
+               const double J32 = r_J[2][qz][qy][qx][1];
+               const double J33 = r_J[2][qz][qy][qx][2];
+               const double detJ = J11 * (J22 * J33 - J32 * J23) -
+               /* */               J21 * (J12 * J33 - J32 * J13) +
+               /* */               J31 * (J12 * J23 - J22 * J13);
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               const double c_detJ = W(qx,qy,qz) * coeff / detJ;
+               // adj(J)
+               const double A11 = (J22 * J33) - (J23 * J32);
+               const double A12 = (J32 * J13) - (J12 * J33);
+               const double A13 = (J12 * J23) - (J22 * J13);
+               const double A21 = (J31 * J23) - (J21 * J33);
+               const double A22 = (J11 * J33) - (J13 * J31);
+               const double A23 = (J21 * J13) - (J11 * J23);
+               const double A31 = (J21 * J32) - (J31 * J22);
+               const double A32 = (J31 * J12) - (J11 * J32);
+               const double A33 = (J11 * J22) - (J12 * J21);
+               // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
+               const double O11 = c_detJ * (A11*A11 + A12*A12 + A13*A13);
+               const double O12 = c_detJ * (A11*A21 + A12*A22 + A13*A23);
+               const double O13 = c_detJ * (A11*A31 + A12*A32 + A13*A33);
+               const double O22 = c_detJ * (A21*A21 + A22*A22 + A23*A23);
+               const double O23 = c_detJ * (A21*A31 + A22*A32 + A23*A33);
+               const double O33 = c_detJ * (A31*A31 + A32*A32 + A33*A33);
+               const double gradX = r_grad[qz][qy][qx][0];
+               const double gradY = r_grad[qz][qy][qx][1];
+               const double gradZ = r_grad[qz][qy][qx][2];
+               r_grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+               r_grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+               r_grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+            }
+         }
+      }
+      double r_y[MD1][MD1][MD1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               r_y[dz][dy][dx] = 0.0;
+            }
+         }
+      }
+      MFGradT3D<MD1,MQ1>(D1D, Q1D, r_B, r_G, r_grad, r_y);
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,dz,e) += r_y[dz][dy][dx];
+            }
+         }
+      }
+   });
+}
+
+void DiffusionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(MQ == NULL, "matrix coefficients are not supported in "
+               "matrix-free mode");
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   mf_ir = IntRule ? IntRule : &GetRule(el, el);
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   maps = &el.GetDofToQuad(*mf_ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   MFSetup(fes, *mf_ir, Q, mf_nodes, mf_nodes_maps, mf_coeff);
+}
+
+void DiffusionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int ND1D = mf_nodes_maps->ndof;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   const Array<double> &Bn = mf_nodes_maps->B;
+   const Array<double> &Gn = mf_nodes_maps->G;
+   const Array<double> &W = mf_ir->GetWeights();
+   const Vector &N = mf_nodes;
+   const Vector &C = mf_coeff;
+   const int id = (dofs1D << 4) | quad1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22:
+            return MFDiffusionApply2D<2,2>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x33:
+            return MFDiffusionApply2D<3,3>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x44:
+            return MFDiffusionApply2D<4,4>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x55:
+            return MFDiffusionApply2D<5,5>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         default:
+            return MFDiffusionApply2D(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D,
+                                      dofs1D,quad1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23:
+            return MFDiffusionApply3D<2,3>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x34:
+            return MFDiffusionApply3D<3,4>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         case 0x45:
+            return MFDiffusionApply3D<4,5>(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D);
+         default:
+            return MFDiffusionApply3D(ne,B,G,Bn,Gn,W,N,C,x,y,ND1D,
+                                      dofs1D,quad1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+}
@@ -16,7 +16,14 @@
 #include "picojson.h"
 
 #include <cerrno>      // errno
+#include <chrono>
 #include <sstream>
+#ifdef MFEM_USE_THREADS
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
 
 #ifndef _WIN32
 #include <sys/stat.h>  // mkdir
@@ -28,6 +35,247 @@
 namespace mfem
 {
 
+namespace internal
+{
+
+// Copy of a GridFunction or a QuadratureFunction, written by an asynchronous
+// save in the format of their Save() methods.
+struct FieldSnapshot
+{
+   std::string space; // description of the space
+   Vector data;
+   int width;         // number of values per line in the ascii format
+
+   FieldSnapshot(const GridFunction &gf);
+   FieldSnapshot(const QuadratureFunction &qf);
+
+   long Bytes() const { return space.size() + data.Size()*sizeof(double); }
+
+   void Save(std::ostream &out, bool binary) const;
+};
+
+FieldSnapshot::FieldSnapshot(const GridFunction &gf)
+{
+   const FiniteElementSpace *fes = gf.FESpace();
+   std::ostringstream os;
+   fes->Save(os);
+   space = os.str();
+   width = (fes->GetOrdering() == Ordering::byNODES) ? 1 : fes->GetVDim();
+
+   data.SetSize(gf.Size());
+   const double *d = gf.HostRead();
+   std::copy(d, d + gf.Size(), data.GetData());
+#ifdef MFEM_USE_MPI
+   // Apply the dof signs, as in ParGridFunction::Save()
+   const ParGridFunction *pgf = dynamic_cast<const ParGridFunction*>(&gf);
+   if (pgf)
+   {
+      for (int i = 0; i < data.Size(); i++)
+      {
+         if (pgf->ParFESpace()->GetDofSign(i) < 0) { data(i) = -data(i); }
+      }
+   }
+#endif
+}
+
+FieldSnapshot::FieldSnapshot(const QuadratureFunction &qf)
+{
+   std::ostringstream os;
+   qf.GetSpace()->Save(os);
+   os << "VDim: " << qf.GetVDim() << '\n';
+   space = os.str();
+   width = qf.GetVDim();
+
+   data.SetSize(qf.Size());
+   const double *d = qf.HostRead();
+   std::copy(d, d + qf.Size(), data.GetData());
+}
+
+void FieldSnapshot::Save(std::ostream &out, bool binary) const
+{
+   if (binary)
+   {
+      BinaryWriter writer;
+      writer.AddSection("fespace", space);
+      writer.AddSection("data", data.GetData(), data.Size());
+      writer.Write(out);
+      return;
+   }
+   out << space << '\n';
+   data.Print(out, width);
+   out.flush();
+}
+
+// Approximate memory used by a copy of @a mesh.
+static long MeshBytes(const Mesh &mesh)
+{
+   long bytes = 3*sizeof(double)*mesh.GetNV();
+   if (mesh.GetNodes()) { bytes += sizeof(double)*mesh.GetNodes()->Size(); }
+   // Elements and boundary elements, with their vertices and attributes
+   const int nv = (mesh.Dimension() == 3) ? 8 : 4;
+   bytes += (mesh.GetNE() + mesh.GetNBE())*(nv + 8)*sizeof(int);
+   return bytes;
+}
+
+} // namespace mfem::internal
+
+/** The files are written in the order in which they are queued. The value of
+    the future of a file is the error state after it is written: WRITE_ERROR if
+    this file, or a file queued before it, could not be written since the last
+    ResetError(). */
+class DataCollection::AsyncWriter
+{
+public:
+   typedef std::function<int()> Job; // writes a file, returns an error state
+
+private:
+   long max_bytes;
+   int error;
+#ifdef MFEM_USE_THREADS
+   struct Entry
+   {
+      Job job;
+      long bytes;
+      std::promise<int> done;
+   };
+   std::deque<Entry> queue; // the front entry is being written
+   long queued_bytes;
+   bool stop;
+   std::mutex mtx;
+   std::condition_variable work_cv, space_cv;
+   std::thread thread;
+
+   void Loop();
+#endif
+
+public:
+   AsyncWriter(long max_bytes_);
+
+   /// Write the queued files and stop the thread.
+   ~AsyncWriter();
+
+   void SetMaxBytes(long max_bytes_);
+
+   /// Queue the write @a job, which holds @a bytes of memory.
+   std::shared_future<int> Submit(Job job, long bytes);
+
+   void ResetError();
+};
+
+#ifdef MFEM_USE_THREADS
+
+DataCollection::AsyncWriter::AsyncWriter(long max_bytes_)
+   : max_bytes(max_bytes_), error(NO_ERROR), queued_bytes(0), stop(false) { }
+
+DataCollection::AsyncWriter::~AsyncWriter()
+{
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      stop = true;
+   }
+   work_cv.notify_one();
+   if (thread.joinable()) { thread.join(); }
+}
+
+void DataCollection::AsyncWriter::SetMaxBytes(long max_bytes_)
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   max_bytes = max_bytes_;
+   space_cv.notify_all();
+}
+
+void DataCollection::AsyncWriter::Loop()
+{
+   std::unique_lock<std::mutex> lock(mtx);
+   while (true)
+   {
+      work_cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) { return; }
+      // References to the entries of a deque remain valid when entries are
+      // added at the back
+      Entry &e = queue.front();
+      lock.unlock();
+      const int err = e.job();
+      e.job = nullptr; // release the snapshots
+      lock.lock();
+      if (err != NO_ERROR) { error = err; }
+      e.done.set_value(error);
+      queued_bytes -= e.bytes;
+      queue.pop_front();
+      space_cv.notify_all();
+   }
+}
+
+std::shared_future<int> DataCollection::AsyncWriter::Submit(Job job,
+                                                            long bytes)
+{
+   std::unique_lock<std::mutex> lock(mtx);
+   // Bound the memory of the queued snapshots
+   space_cv.wait(lock, [&]
+   {
+      return queue.empty() || queued_bytes + bytes <= max_bytes;
+   });
+   queue.emplace_back();
+   Entry &e = queue.back();
+   e.job = std::move(job);
+   e.bytes = bytes;
+   queued_bytes += bytes;
+   std::shared_future<int> result = e.done.get_future().share();
+   if (!thread.joinable())
+   {
+      thread = std::thread(&AsyncWriter::Loop, this);
+   }
+   lock.unlock();
+   work_cv.notify_one();
+   return result;
+}
+
+void DataCollection::AsyncWriter::ResetError()
+{
+   std::lock_guard<std::mutex> lock(mtx);
+   error = NO_ERROR;
+}
+
+#else // MFEM_USE_THREADS
+
+// Without threads, the files are written when they are queued.
+
+DataCollection::AsyncWriter::AsyncWriter(long max_bytes_)
+   : max_bytes(max_bytes_), error(NO_ERROR) { }
+
+DataCollection::AsyncWriter::~AsyncWriter() { }
+
+void DataCollection::AsyncWriter::SetMaxBytes(long max_bytes_)
+{
+   max_bytes = max_bytes_;
+}
+
+std::shared_future<int> DataCollection::AsyncWriter::Submit(Job job,
+                                                            long bytes)
+{
+   MFEM_CONTRACT_VAR(bytes);
+   const int err = job();
+   if (err != NO_ERROR) { error = err; }
+   std::promise<int> done;
+   done.set_value(error);
+   return done.get_future().share();
+}
+
+void DataCollection::AsyncWriter::ResetError() { error = NO_ERROR; }
+
+#endif // MFEM_USE_THREADS
+
+bool DataCollection::SaveHandle::IsDone() const
+{
+   return !result.valid() ||
+          result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+int DataCollection::SaveHandle::Wait() const
+{
+   return result.valid() ? result.get() : NO_ERROR;
+}
+
 // static method
 int DataCollection::create_directory(const std::string &dir_name,
                                      const Mesh *mesh, int myid)
@@ -110,6 +358,9 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    format = SERIAL_FORMAT; // use serial mesh format
    compression = false;
    error = NO_ERROR;
+   async = false;
+   async_max_bytes = 1L << 30;
+   async_writer = NULL;
 }
 
 void DataCollection::SetMesh(Mesh *new_mesh)
@@ -157,6 +408,7 @@ void DataCollection::SetFormat(int fmt)
 #ifdef MFEM_USE_MPI
       case PARALLEL_FORMAT: break;
 #endif
+      case BINARY_FORMAT: break;
       default: MFEM_ABORT("unknown format: " << fmt);
    }
    format = fmt;
@@ -186,6 +438,67 @@ void DataCollection::SetPrefixPath(const std::string& prefix)
    }
 }
 
+void DataCollection::SetAsync(bool async_, long max_queued_bytes)
+{
+   if (!async_ && async) { WaitForSaves(); }
+   async = async_;
+   async_max_bytes = max_queued_bytes;
+   if (async_writer) { async_writer->SetMaxBytes(async_max_bytes); }
+}
+
+int DataCollection::WaitForSaves()
+{
+   const int err = last_save.Wait();
+   if (err != NO_ERROR) { error = err; }
+   return error;
+}
+
+void DataCollection::ResetError(int err)
+{
+   error = err;
+   if (async_writer)
+   {
+      // Clear the errors of the files written so far
+      last_save.Wait();
+      async_writer->ResetError();
+   }
+}
+
+void DataCollection::WriteFile(const std::string &file_name, bool compress,
+                               const std::function<void(std::ostream&)> &write,
+                               long bytes, const std::string &error_msg)
+{
+   if (!async)
+   {
+      mfem::ofgzstream file(file_name, compress);
+      file.precision(precision);
+      write(file);
+      if (!file)
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING(error_msg);
+      }
+      return;
+   }
+
+   if (!async_writer) { async_writer = new AsyncWriter(async_max_bytes); }
+   const int prec = precision;
+   auto job = [=]()
+   {
+      try
+      {
+         mfem::ofgzstream file(file_name, compress);
+         file.precision(prec);
+         write(file);
+         if (file) { return (int) NO_ERROR; }
+      }
+      catch (std::exception &) { }
+      MFEM_WARNING(error_msg);
+      return (int) WRITE_ERROR;
+   };
+   last_save.result = async_writer->Submit(job, bytes);
+}
+
 void DataCollection::Load(int cycle)
 {
    MFEM_ABORT("this method is not implemented");
@@ -227,30 +540,54 @@ void DataCollection::SaveMesh()
       return; // do not even try to write the mesh
    }
 
-   std::string mesh_name = GetMeshFileName();
-   mfem::ofgzstream mesh_file(mesh_name, compression);
-   mesh_file.precision(precision);
-#ifdef MFEM_USE_MPI
-   const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
-   if (pmesh && format == PARALLEL_FORMAT)
+   // In asynchronous mode, write a copy of the mesh
+   std::shared_ptr<const Mesh> m;
+   long bytes = 0;
+   if (!async)
    {
-      pmesh->ParPrint(mesh_file);
+      m.reset(mesh, [](const Mesh *) { });
    }
    else
-#endif
    {
-      mesh->Print(mesh_file);
+#ifdef MFEM_USE_MPI
+      const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+      if (pmesh) { m.reset(new ParMesh(*pmesh, true)); }
+      else
+#endif
+      {
+         m.reset(new Mesh(*mesh, true));
+      }
+      bytes = internal::MeshBytes(*mesh);
    }
-   if (!mesh_file)
+
+   const int fmt = format;
+   auto write = [m, fmt](std::ostream &out)
    {
-      error = WRITE_ERROR;
-      MFEM_WARNING("Error writing mesh to file: " << mesh_name);
-   }
+#ifdef MFEM_USE_MPI
+      const ParMesh *pmesh = dynamic_cast<const ParMesh*>(m.get());
+      if (pmesh && fmt == PARALLEL_FORMAT)
+      {
+         pmesh->ParPrint(out);
+      }
+      else
+#endif
+      if (fmt == BINARY_FORMAT)
+      {
+         m->PrintBinary(out);
+      }
+      else
+      {
+         m->Print(out);
+      }
+   };
+   std::string mesh_name = GetMeshFileName();
+   WriteFile(mesh_name, compression, write, bytes,
+             "Error writing mesh to file: " + mesh_name);
 }
 
 std::string DataCollection::GetMeshShortFileName() const
 {
-   return (serial || format == SERIAL_FORMAT) ? "mesh" : "pmesh";
+   return (serial || format != PARALLEL_FORMAT) ? "mesh" : "pmesh";
 }
 
 std::string DataCollection::GetMeshFileName() const
@@ -276,28 +613,47 @@ const
 
 void DataCollection::SaveOneField(const FieldMapIterator &it)
 {
-   mfem::ofgzstream field_file(GetFieldFileName(it->first), compression);
-
-   field_file.precision(precision);
-   (it->second)->Save(field_file);
-   if (!field_file)
+   const bool binary = (format == BINARY_FORMAT);
+   std::function<void(std::ostream&)> write;
+   long bytes = 0;
+   if (!async)
    {
-      error = WRITE_ERROR;
-      MFEM_WARNING("Error writing field to file: " << it->first);
+      const GridFunction *gf = it->second;
+      write = [gf, binary](std::ostream &out)
+      {
+         if (binary) { gf->SaveBinary(out); }
+         else { gf->Save(out); }
+      };
+   }
+   else
+   {
+      std::shared_ptr<internal::FieldSnapshot> snap(
+         new internal::FieldSnapshot(*it->second));
+      bytes = snap->Bytes();
+      write = [snap, binary](std::ostream &out) { snap->Save(out, binary); };
    }
+   WriteFile(GetFieldFileName(it->first), compression, write, bytes,
+             "Error writing field to file: " + it->first);
 }
 
 void DataCollection::SaveOneQField(const QFieldMapIterator &it)
 {
-   mfem::ofgzstream q_field_file(GetFieldFileName(it->first), compression);
-
-   q_field_file.precision(precision);
-   (it->second)->Save(q_field_file);
-   if (!q_field_file)
+   std::function<void(std::ostream&)> write;
+   long bytes = 0;
+   if (!async)
    {
-      error = WRITE_ERROR;
-      MFEM_WARNING("Error writing q-field to file: " << it->first);
+      const QuadratureFunction *qf = it->second;
+      write = [qf](std::ostream &out) { qf->Save(out); };
    }
+   else
+   {
+      std::shared_ptr<internal::FieldSnapshot> snap(
+         new internal::FieldSnapshot(*it->second));
+      bytes = snap->Bytes();
+      write = [snap](std::ostream &out) { snap->Save(out, false); };
+   }
+   WriteFile(GetFieldFileName(it->first), compression, write, bytes,
+             "Error writing q-field to file: " + it->first);
 }
 
 void DataCollection::SaveField(const std::string &field_name)
@@ -337,6 +693,7 @@ void DataCollection::DeleteAll()
 
 DataCollection::~DataCollection()
 {
+   delete async_writer;
    DeleteData();
 }
 
@@ -463,13 +820,9 @@ void VisItDataCollection::SaveRootFile()
    std::string root_name = prefix_path + name + "_" +
                            to_padded_string(cycle, pad_digits_cycle) +
                            ".mfem_root";
-   std::ofstream root_file(root_name.c_str());
-   root_file << GetVisItRootString();
-   if (!root_file)
-   {
-      error = WRITE_ERROR;
-      MFEM_WARNING("Error writing VisIt root file: " << root_name);
-   }
+   const std::string root = GetVisItRootString();
+   WriteFile(root_name, false, [root](std::ostream &out) { out << root; },
+             root.size(), "Error writing VisIt root file: " + root_name);
 }
 
 void VisItDataCollection::Load(int cycle_)
@@ -482,7 +835,7 @@ void VisItDataCollection::Load(int cycle_)
                            to_padded_string(cycle, pad_digits_cycle) +
                            ".mfem_root";
    LoadVisItRootFile(root_name);
-   if (format != SERIAL_FORMAT || num_procs > 1)
+   if (format == PARALLEL_FORMAT || num_procs > 1)
    {
 #ifndef MFEM_USE_MPI
       MFEM_WARNING("Cannot load parallel VisIt root file in serial.");
@@ -555,7 +908,7 @@ void VisItDataCollection::LoadMesh()
       return;
    }
    // TODO: 1) load parallel mesh on one processor
-   if (format == SERIAL_FORMAT)
+   if (format != PARALLEL_FORMAT)
    {
       mesh = new Mesh(file, 1, 0, false);
       serial = true;
@@ -828,6 +1181,7 @@ void ParaViewDataCollection::Save()
    }
 
    // define the vtu file
+   if (!async)
    {
       std::string fname = GenerateCollectionPath()+"/"+GenerateVTUPath()+"/"
                           +GenerateVTUFileName();
@@ -836,6 +1190,41 @@ void ParaViewDataCollection::Save()
       SaveDataVTU(out,levels_of_detail);
       out.close();
    }
+   else
+   {
+      // Evaluate the fields and defer the encoding and the compression of
+      // their arrays to the background thread
+      struct VTUSnapshot
+      {
+         std::string text;
+         VTUArrays arrays;
+      };
+      std::shared_ptr<VTUSnapshot> snap(new VTUSnapshot);
+      std::ostringstream os;
+      os.precision(precision);
+      SaveDataVTU(os, levels_of_detail, &snap->arrays);
+      snap->text = os.str();
+      long bytes = snap->text.size();
+      for (const auto &a : snap->arrays) { bytes += a.second.size(); }
+
+      const int level = compression;
+      auto write = [snap, level](std::ostream &out)
+      {
+         const std::string &text = snap->text;
+         std::size_t pos = 0;
+         for (const auto &a : snap->arrays)
+         {
+            out.write(text.data() + pos, a.first - pos);
+            WriteVTKEncodedCompressed(out, a.second.data(), a.second.size(),
+                                      level);
+            pos = a.first;
+         }
+         out.write(text.data() + pos, text.size() - pos);
+      };
+      std::string fname = GenerateCollectionPath()+"/"+GenerateVTUPath()+"/"
+                          +GenerateVTUFileName();
+      WriteFile(fname, false, write, bytes, "Error writing VTU file: " + fname);
+   }
 
    // define the pvtu file only on process 0
    if (myid==0)
@@ -907,7 +1296,8 @@ void ParaViewDataCollection::Save()
    }
 }
 
-void ParaViewDataCollection::SaveDataVTU(std::ostream &out, int ref)
+void ParaViewDataCollection::SaveDataVTU(std::ostream &out, int ref,
+                                         VTUArrays *deferred)
 {
    out << "<VTKFile type=\"UnstructuredGrid\"";
    if (compression != 0)
@@ -924,7 +1314,7 @@ void ParaViewDataCollection::SaveDataVTU(std::ostream &out, int ref)
    // iterate over all grid functions
    for (FieldMapIterator it=field_map.begin(); it!=field_map.end(); ++it)
    {
-      SaveGFieldVTU(out,ref,it);
+      SaveGFieldVTU(out,ref,it,deferred);
    }
    // iterate over all quadrature functions
    // if the Quadrature functions are dumped as cell data
@@ -950,7 +1340,8 @@ void ParaViewDataCollection::SaveQFieldVTU(std::ostream &out, int ref,
 }
 
 void ParaViewDataCollection::SaveGFieldVTU(std::ostream &out, int ref_,
-                                           const FieldMapIterator& it)
+                                           const FieldMapIterator& it,
+                                           VTUArrays *deferred)
 {
    RefinedGeometry *RefG;
    Vector val;
@@ -1024,7 +1415,16 @@ void ParaViewDataCollection::SaveGFieldVTU(std::ostream &out, int ref_,
 
    if (IsBinaryFormat())
    {
-      WriteVTKEncodedCompressed(out,buf.data(),buf.size(),compression);
+      if (deferred)
+      {
+         deferred->push_back(std::make_pair((std::size_t)out.tellp(),
+                                            std::vector<char>()));
+         deferred->back().second.swap(buf);
+      }
+      else
+      {
+         WriteVTKEncodedCompressed(out,buf.data(),buf.size(),compression);
+      }
       out << '\n';
    }
    out << "</DataArray>" << std::endl;
@@ -20,6 +20,10 @@
 #include <string>
 #include <map>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
 
 namespace mfem
 {
@@ -149,9 +153,31 @@ public:
       SERIAL_FORMAT = 0, /**<
          MFEM's serial ascii format, using the methods Mesh::Print() /
          ParMesh::Print(), and GridFunction::Save() / ParGridFunction::Save().*/
-      PARALLEL_FORMAT = 1  /**<
+      PARALLEL_FORMAT = 1, /**<
          MFEM's parallel ascii format, using the methods ParMesh::ParPrint() and
          GridFunction::Save() / ParGridFunction::Save(). */
+      BINARY_FORMAT = 2    /**<
+         MFEM's binary format, using the methods Mesh::PrintBinary() and
+         GridFunction::SaveBinary() / ParGridFunction::SaveBinary(). In
+         parallel, the local meshes are saved, as with #SERIAL_FORMAT. The
+         QuadratureFunction%s are saved in ascii format. */
+   };
+
+   /// Handle of the files queued by an asynchronous save, see SetAsync().
+   class SaveHandle
+   {
+      friend class DataCollection;
+      std::shared_future<int> result;
+
+   public:
+      /** @brief Return true if the files are written, or if the handle does
+          not refer to an asynchronous save. */
+      bool IsDone() const;
+
+      /// Wait until the files are written.
+      /** Returns WRITE_ERROR if these files, or files queued before them, could
+          not be written, and NO_ERROR otherwise. */
+      int Wait() const;
    };
 
 protected:
@@ -214,6 +240,16 @@ protected:
    /// Error state
    int error;
 
+   /// Background thread of the asynchronous saves, defined in the source file
+   class AsyncWriter;
+
+   /// Asynchronous mode, see SetAsync()
+   bool async;
+   long async_max_bytes;
+   AsyncWriter *async_writer;
+   /// Handle of the last file queued in asynchronous mode
+   SaveHandle last_save;
+
    /// Delete data owned by the DataCollection keeping field information
    void DeleteData();
    /// Delete data owned by the DataCollection including field information
@@ -229,6 +265,16 @@ protected:
    /// Save one q-field to disk, assuming the collection directory exists
    void SaveOneQField(const QFieldMapIterator &it);
 
+   /** @brief Write the file @a file_name with the function @a write, which
+       receives the stream of the file. */
+   /** In asynchronous mode, the file is queued and written by the background
+       thread: @a write must then only access data owned by it, e.g. snapshots
+       held by shared pointers, and @a bytes is the memory used by this data.
+       On failure, the error state is set and @a error_msg is printed. */
+   void WriteFile(const std::string &file_name, bool compress,
+                  const std::function<void(std::ostream&)> &write, long bytes,
+                  const std::string &error_msg);
+
    // Helper method
    static int create_directory(const std::string &dir_name,
                                const Mesh *mesh, int myid);
@@ -357,6 +403,37 @@ public:
    /// Get the path where the DataCollection will be saved.
    const std::string &GetPrefixPath() const { return prefix_path; }
 
+   /// Enable or disable the asynchronous mode of Save().
+   /** In asynchronous mode, Save() copies the mesh and the fields into
+       snapshots and returns; the snapshots are serialized, compressed and
+       written to disk, in order, by a background thread. The mesh and the
+       fields can be modified, or deleted, as soon as Save() returns. Use
+       GetLastSave() or WaitForSaves() to wait for the files to be written.
+
+       The snapshots waiting to be written use at most @a max_queued_bytes of
+       memory: Save() blocks until enough queued files are written. A single
+       save larger than the limit is queued when nothing else is.
+
+       Without MFEM_USE_THREADS, the snapshots are written before Save()
+       returns. Disabling the asynchronous mode waits for the queued saves.
+       Derived classes which do not support this mode save synchronously.
+
+       @note In ParaViewDataCollection, the fields are evaluated and the mesh
+       is serialized by Save(); the compression and the encoding of the field
+       arrays, and the output of the VTU files, are done in the background. */
+   void SetAsync(bool async_, long max_queued_bytes = 1L << 30);
+
+   /// Return true if the asynchronous mode of Save() is enabled.
+   bool IsAsync() const { return async; }
+
+   /// Return a handle of the last save queued in asynchronous mode.
+   /** Waiting for the handle waits for all saves queued before it. */
+   SaveHandle GetLastSave() const { return last_save; }
+
+   /// Wait until all files queued in asynchronous mode are written.
+   /** Sets and returns the error state of the collection. */
+   int WaitForSaves();
+
    /// Save the collection to disk.
    /** By default, everything is saved in the "prefix_path" directory with
        subdirectory name "collection_name" or "collection_name_cycle" for
@@ -380,8 +457,8 @@ public:
 
    /// Get the current error state
    int Error() const { return error; }
-   /// Reset the error state
-   void ResetError(int err = NO_ERROR) { error = err; }
+   /// Reset the error state, including the errors of the asynchronous saves
+   void ResetError(int err = NO_ERROR);
 };
 
 
@@ -479,8 +556,15 @@ private:
    bool high_order_output;
 
 protected:
-   void SaveDataVTU(std::ostream &out, int ref);
-   void SaveGFieldVTU(std::ostream& out, int ref_, const FieldMapIterator& it);
+   /// Binary arrays of a VTU file whose encoding is deferred: their offsets in
+   /// the text of the file and their raw data.
+   typedef std::vector<std::pair<std::size_t, std::vector<char>>> VTUArrays;
+
+   /** With @a deferred, the binary field arrays are not encoded and written
+       to @a out, but appended to @a deferred with their offsets in @a out. */
+   void SaveDataVTU(std::ostream &out, int ref, VTUArrays *deferred = NULL);
+   void SaveGFieldVTU(std::ostream& out, int ref_, const FieldMapIterator& it,
+                      VTUArrays *deferred = NULL);
    void SaveQFieldVTU(std::ostream &out, int ref, const QFieldMapIterator& it);
    const char *GetDataFormatString() const;
    const char *GetDataTypeString() const;
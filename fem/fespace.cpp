@@ -13,6 +13,7 @@
 
 #include "../general/text.hpp"
 #include "../general/forall.hpp"
+#include "../general/profiler.hpp"
 #include "../mesh/mesh_headers.hpp"
 #include "fem.hpp"
 
@@ -1473,6 +1474,7 @@ void FiniteElementSpace::UpdateNURBS()
 
 void FiniteElementSpace::Construct()
 {
+   MFEM_PROFILE_REGION("FiniteElementSpace::Construct");
    // This method should be used only for non-NURBS spaces.
    MFEM_VERIFY(!NURBSext, "internal error");
 
@@ -2201,15 +2203,22 @@ void FiniteElementSpace::Save(std::ostream &out) const
 
 FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
 {
-   string buff;
+   string header;
+   input >> std::ws;
+   getline(input, header);  // 'FiniteElementSpace'
+   filter_dos(header);
+   return Load(m, input, header);
+}
+
+FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input,
+                                                  const string &header)
+{
+   string buff = header;
    int fes_format = 0, ord;
    FiniteElementCollection *r_fec;
 
    Destroy();
 
-   input >> std::ws;
-   getline(input, buff);  // 'FiniteElementSpace'
-   filter_dos(buff);
    if (buff == "FiniteElementSpace") { fes_format = 90; /* v0.9 */ }
    else if (buff == "MFEM FiniteElementSpace v1.0") { fes_format = 100; }
    else { MFEM_ABORT("input stream is not a FiniteElementSpace!"); }
@@ -668,6 +668,11 @@ public:
        FiniteElementCollection is owned by the caller. */
    FiniteElementCollection *Load(Mesh *m, std::istream &input);
 
+   /** @brief Same as Load(Mesh*, std::istream&), for a stream whose first
+       line, @a header, was already read, e.g. to detect the file format. */
+   FiniteElementCollection *Load(Mesh *m, std::istream &input,
+                                 const std::string &header);
+
    virtual ~FiniteElementSpace();
 };
 
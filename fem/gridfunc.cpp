@@ -20,6 +20,7 @@
 #include <string>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 
 namespace mfem
@@ -33,8 +34,21 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
    // Grid functions are stored on the device
    UseDevice(true);
 
+   // The first line identifies the binary format or the FiniteElementSpace
+   string header;
+   input >> std::ws;
+   getline(input, header);
+   filter_dos(header);
+   if (header == BinaryReader::magic)
+   {
+      BinaryReader reader;
+      reader.Read(input);
+      LoadBinary(m, reader, true);
+      return;
+   }
+
    fes = new FiniteElementSpace;
-   fec = fes->Load(m, input);
+   fec = fes->Load(m, input, header);
 
    skip_comment_lines(input, '#');
    istream::int_type next_char = input.peek();
@@ -61,6 +75,33 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
    sequence = fes->GetSequence();
 }
 
+GridFunction::GridFunction(Mesh *m, BinaryReader &reader)
+   : Vector()
+{
+   LoadBinary(m, reader, false);
+}
+
+void GridFunction::LoadBinary(Mesh *m, BinaryReader &reader, bool copy)
+{
+   std::istringstream fes_input(reader.GetString("fespace"));
+   fes = new FiniteElementSpace;
+   fec = fes->Load(m, fes_input);
+   int n;
+   double *gf_data = reader.GetDoubles("data", n);
+   MFEM_VERIFY(n == fes->GetVSize(), "invalid MFEM binary GridFunction");
+   if (copy)
+   {
+      SetSize(n);
+      std::copy(gf_data, gf_data + n, HostWrite());
+   }
+   else
+   {
+      NewDataAndSize(gf_data, n);
+   }
+   UseDevice(true);
+   sequence = fes->GetSequence();
+}
+
 GridFunction::GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces)
 {
    UseDevice(true);
@@ -2753,6 +2794,16 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::SaveBinary(std::ostream &out) const
+{
+   std::ostringstream fes_out;
+   fes->Save(fes_out);
+   BinaryWriter writer;
+   writer.AddSection("fespace", fes_out.str());
+   writer.AddSection("data", HostRead(), Size());
+   writer.Write(out);
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &out,
                         const std::string& variable_name,
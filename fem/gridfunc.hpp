@@ -67,6 +67,10 @@ protected:
        degree of freedom. */
    void ProjectDiscCoefficient(VectorCoefficient &coeff, Array<int> &dof_attr);
 
+   // Set up the space and the data from a container in MFEM's binary format;
+   // with @a copy == false, the data of @a reader is used in place.
+   void LoadBinary(Mesh *m, BinaryReader &reader, bool copy);
+
    void Destroy();
 
 public:
@@ -94,10 +98,17 @@ public:
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
    /** The content of @a input should be in the format created by the method
-       Save(). The reconstructed FiniteElementSpace and FiniteElementCollection
-       are owned by the GridFunction. */
+       Save() or SaveBinary(). The reconstructed FiniteElementSpace and
+       FiniteElementCollection are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
+   /** @brief Construct a GridFunction on the given Mesh from a container in
+       MFEM's binary format, e.g. a memory-mapped file, see SaveBinary() and
+       BinaryReader::Map(). */
+   /** The GridFunction uses the data of @a reader in place, so @a reader must
+       not be destroyed before the GridFunction. */
+   GridFunction(Mesh *m, BinaryReader &reader);
+
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
 
    /// Copy assignment. Only the data of the base class Vector is copied.
@@ -489,6 +500,12 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /// Save the GridFunction to an output stream in MFEM's binary format.
+   /** The data is stored exactly, in a section that can be used in place when
+       the file is memory-mapped, see GridFunction(Mesh*, BinaryReader&). The
+       format is also detected by GridFunction(Mesh*, std::istream&). */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
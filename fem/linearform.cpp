@@ -12,6 +12,7 @@
 // Implementation of class LinearForm
 
 #include "fem.hpp"
+#include "../general/profiler.hpp"
 
 namespace mfem
 {
@@ -24,6 +25,8 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   ext = NULL;
+   fast_assembly = false;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -76,8 +79,24 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+void LinearForm::UseFastAssembly(bool use_fa)
+{
+   fast_assembly = use_fa;
+   if (!fast_assembly) { delete ext; ext = NULL; }
+}
+
+bool LinearForm::SupportsDevice() const
+{
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice(*fes)) { return false; }
+   }
+   return true;
+}
+
 void LinearForm::Assemble()
 {
+   MFEM_PROFILE_REGION("LinearForm::Assemble");
    Array<int> vdofs;
    ElementTransformation *eltrans;
    Vector elemvect;
@@ -90,7 +109,14 @@ void LinearForm::Assemble()
    // The first use of AddElementVector() below will move it back to host
    // because both 'vdofs' and 'elemvect' are on host.
 
-   if (dlfi.Size())
+   // SupportsDevice() is checked every time, since the FE space may have
+   // been updated since the last assembly.
+   if (fast_assembly && dlfi.Size() && SupportsDevice())
+   {
+      if (!ext) { ext = new LinearFormExtension(this); }
+      ext->Assemble();
+   }
+   else if (dlfi.Size())
    {
       for (i = 0; i < fes -> GetNE(); i++)
       {
@@ -258,6 +284,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
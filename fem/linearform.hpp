@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "lininteg.hpp"
 #include "gridfunc.hpp"
+#include "linearform_ext.hpp"
 
 namespace mfem
 {
@@ -56,6 +57,12 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Extension for the fast (device) assembly of the domain integrators.
+   LinearFormExtension *ext;
+
+   /// Set by UseFastAssembly().
+   bool fast_assembly;
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -64,7 +71,10 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   {
+      fes = f; extern_lfs = 0; ext = NULL; fast_assembly = false;
+      UseDevice(true);
+   }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +89,11 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm()
+   {
+      fes = NULL; extern_lfs = 0; ext = NULL; fast_assembly = false;
+      UseDevice(true);
+   }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +101,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   { fes = f; extern_lfs = 0; ext = NULL; fast_assembly = false; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -152,6 +166,20 @@ public:
        corresponding pointer (to Array<int>) will be NULL. */
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
+   /** @brief Enable or disable the fast (device) assembly of the domain
+       integrators. */
+   /** When enabled and SupportsDevice() returns true, Assemble() evaluates
+       the domain integrators with batched quadrature kernels (using the
+       configured Device backend) followed by the transpose of the element
+       restriction, instead of the element-by-element loop. The delta,
+       boundary and boundary face integrators always use the element-by-element
+       assembly. */
+   void UseFastAssembly(bool use_fa);
+
+   /** @brief Return true if all domain integrators support the fast (device)
+       assembly on the current FE space. */
+   bool SupportsDevice() const;
+
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
    void Assemble();
 
@@ -0,0 +1,43 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class LinearFormExtension
+
+#include "fem.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *lf): lf(lf)
+{
+   b.UseDevice(true);
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const ElementDofOrdering ordering = UsesTensorBasis(fes) ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   const Operator *elem_restrict = fes.GetElementRestriction(ordering);
+   MFEM_VERIFY(elem_restrict, "element restriction is not available");
+
+   b.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+   b = 0.0;
+   Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
+   for (int k = 0; k < domain_integs.Size(); k++)
+   {
+      domain_integs[k]->AssembleDevice(fes, b);
+   }
+   elem_restrict->MultTranspose(b, *lf);
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LINEARFORM_EXT
+#define MFEM_LINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+
+/// Class extending the LinearForm class to support fast (device) assembly.
+/** The domain integrators add their contributions, computed with batched
+    quadrature kernels, to an element vector (E-vector) which is then summed
+    into the LinearForm with the transpose of the element restriction. */
+class LinearFormExtension
+{
+protected:
+   /// Linear form from which this extension depends. Not owned.
+   LinearForm *lf;
+
+   /// E-vector of the domain integrators.
+   Vector b;
+
+public:
+   LinearFormExtension(LinearForm *lf);
+
+   /// Assemble the domain integrators of the LinearForm into the LinearForm.
+   /** All domain integrators must support device assembly, see
+       LinearFormIntegrator::SupportsDevice(). */
+   void Assemble();
+};
+
+}
+
+#endif // MFEM_LINEARFORM_EXT
@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 #include "coefficient.hpp"
+#include "fespace.hpp"
 
 namespace mfem
 {
@@ -36,6 +37,17 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /** @brief Return true if the integrator can be assembled with
+       AssembleDevice() on the space @a fes. */
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const
+   { return false; }
+
+   /** @brief Add the element vectors of all elements of @a fes to the
+       E-vector @a b, using batched quadrature kernels. */
+   /** The E-vector uses the lexicographic element dof ordering when
+       UsesTensorBasis(fes) is true and the native ordering otherwise. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes, Vector &b);
+
    void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -116,6 +128,10 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -198,6 +214,10 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   virtual void AssembleDevice(const FiniteElementSpace &fes, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
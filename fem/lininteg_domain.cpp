@@ -0,0 +1,320 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Device assembly of the domain linear form integrators
+
+#include "../general/forall.hpp"
+#include "fem.hpp"
+
+namespace mfem
+{
+
+// Generic kernel: y(d,c,e) += sum_q B(q,d) w(q) detJ(q,e) F(c,q,e)
+static void DLFAssemble(const int vdim, const int NE, const int ND,
+                        const int NQ, const Array<double> &b,
+                        const Array<double> &w, const Vector &detJ,
+                        const Vector &coeff, Vector &y)
+{
+   const bool const_c = coeff.Size() == vdim;
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto W = w.Read();
+   auto D = Reshape(detJ.Read(), NQ, NE);
+   auto F = const_c ? Reshape(coeff.Read(), vdim, 1, 1) :
+            Reshape(coeff.Read(), vdim, NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int d = 0; d < ND; d++)
+         {
+            double s = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               const double f = const_c ? F(c,0,0) : F(c,q,e);
+               s += B(q,d) * W[q] * D(q,e) * f;
+            }
+            Y(d,c,e) += s;
+         }
+      }
+   });
+}
+
+// Sum factorization kernel for quadrilaterals, with lexicographic dofs and
+// tensor-product quadrature points
+static void DLFAssemble2D(const int vdim, const int NE, const int D1D,
+                          const int Q1D, const Array<double> &b,
+                          const Array<double> &w, const Vector &detJ,
+                          const Vector &coeff, Vector &y)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "order is too high");
+   const bool const_c = coeff.Size() == vdim;
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto W = Reshape(w.Read(), Q1D, Q1D);
+   auto D = Reshape(detJ.Read(), Q1D, Q1D, NE);
+   auto F = const_c ? Reshape(coeff.Read(), vdim, 1, 1, 1) :
+            Reshape(coeff.Read(), vdim, Q1D, Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      double QQ[max_Q1D][max_Q1D];
+      double QD[max_Q1D][max_D1D];
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               const double f = const_c ? F(c,0,0,0) : F(c,qx,qy,e);
+               QQ[qy][qx] = W(qx,qy) * D(qx,qy,e) * f;
+            }
+         }
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q1D; qx++) { s += B(qx,dx) * QQ[qy][qx]; }
+               QD[qy][dx] = s;
+            }
+         }
+         for (int dy = 0; dy < D1D; dy++)
+         {
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               double s = 0.0;
+               for (int qy = 0; qy < Q1D; qy++) { s += B(qy,dy) * QD[qy][dx]; }
+               Y(dx,dy,c,e) += s;
+            }
+         }
+      }
+   });
+}
+
+// Sum factorization kernel for hexahedra, with lexicographic dofs and
+// tensor-product quadrature points
+static void DLFAssemble3D(const int vdim, const int NE, const int D1D,
+                          const int Q1D, const Array<double> &b,
+                          const Array<double> &w, const Vector &detJ,
+                          const Vector &coeff, Vector &y)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D && Q1D <= MAX_Q1D, "order is too high");
+   const bool const_c = coeff.Size() == vdim;
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto W = Reshape(w.Read(), Q1D, Q1D, Q1D);
+   auto D = Reshape(detJ.Read(), Q1D, Q1D, Q1D, NE);
+   auto F = const_c ? Reshape(coeff.Read(), vdim, 1, 1, 1, 1) :
+            Reshape(coeff.Read(), vdim, Q1D, Q1D, Q1D, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      double QQQ[max_Q1D][max_Q1D][max_Q1D];
+      double QQD[max_Q1D][max_Q1D][max_D1D];
+      double QDD[max_Q1D][max_D1D][max_D1D];
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  const double f = const_c ? F(c,0,0,0,0) : F(c,qx,qy,qz,e);
+                  QQQ[qz][qy][qx] = W(qx,qy,qz) * D(qx,qy,qz,e) * f;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  double s = 0.0;
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     s += B(qx,dx) * QQQ[qz][qy][qx];
+                  }
+                  QQD[qz][qy][dx] = s;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  double s = 0.0;
+                  for (int qy = 0; qy < Q1D; qy++)
+                  {
+                     s += B(qy,dy) * QQD[qz][qy][dx];
+                  }
+                  QDD[qz][dy][dx] = s;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; dz++)
+         {
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  double s = 0.0;
+                  for (int qz = 0; qz < Q1D; qz++)
+                  {
+                     s += B(qz,dz) * QDD[qz][dy][dx];
+                  }
+                  Y(dx,dy,dz,c,e) += s;
+               }
+            }
+         }
+      }
+   });
+}
+
+// Add the E-vector of the integral of the coefficient values, given at the
+// quadrature points of @a ir, times the shape functions of @a fes to @a y.
+static void DomainLFAssemble(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir, const Vector &coeff,
+                             Vector &y)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int NE = fes.GetNE();
+   if (NE == 0) { return; }
+   const int dim = mesh->Dimension();
+   const int vdim = fes.GetVDim();
+   const FiniteElement &el = *fes.GetFE(0);
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+   const Array<double> &w = ir.GetWeights();
+
+   if (UsesTensorBasis(fes) && (dim == 2 || dim == 3))
+   {
+      const DofToQuad &maps = el.GetDofToQuad(ir, DofToQuad::TENSOR);
+      const int D1D = maps.ndof, Q1D = maps.nqpt;
+      if (dim == 2)
+      {
+         return DLFAssemble2D(vdim, NE, D1D, Q1D, maps.B, w, geom->detJ,
+                              coeff, y);
+      }
+      return DLFAssemble3D(vdim, NE, D1D, Q1D, maps.B, w, geom->detJ,
+                           coeff, y);
+   }
+   const DofToQuad &maps = el.GetDofToQuad(ir, DofToQuad::FULL);
+   DLFAssemble(vdim, NE, maps.ndof, maps.nqpt, maps.B, w, geom->detJ, coeff,
+               y);
+}
+
+// Return true if the device assembly can be used with the space @a fes
+static bool DomainLFSupportsDevice(const FiniteElementSpace &fes)
+{
+   const Mesh &mesh = *fes.GetMesh();
+   if (mesh.NURBSext || mesh.Dimension() < 2 ||
+       mesh.SpaceDimension() != mesh.Dimension() ||
+       mesh.GetNumGeometries(mesh.Dimension()) > 1)
+   {
+      return false;
+   }
+   if (fes.GetNE() == 0) { return true; }
+   const FiniteElement &el = *fes.GetFE(0);
+   return el.GetRangeType() == FiniteElement::SCALAR;
+}
+
+bool DomainLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == 1 && DomainLFSupportsDevice(fes);
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        Vector &b)
+{
+   const int NE = fes.GetNE();
+   if (NE == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   const int NQ = ir->GetNPoints();
+
+   Vector coeff;
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      coeff.SetSize(NQ * NE);
+      auto C = Reshape(coeff.HostWrite(), NQ, NE);
+      for (int e = 0; e < NE; e++)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            C(q,e) = Q.Eval(T, ip);
+         }
+      }
+   }
+   DomainLFAssemble(fes, *ir, coeff, b);
+}
+
+bool VectorDomainLFIntegrator::SupportsDevice(
+   const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == Q.GetVDim() && DomainLFSupportsDevice(fes);
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              Vector &b)
+{
+   const int NE = fes.GetNE();
+   if (NE == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2*el.GetOrder());
+   const int NQ = ir->GetNPoints();
+   const int vdim = Q.GetVDim();
+
+   Vector coeff;
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+   }
+   else
+   {
+      coeff.SetSize(vdim * NQ * NE);
+      auto C = Reshape(coeff.HostWrite(), vdim, NQ, NE);
+      Vector Qvec;
+      for (int e = 0; e < NE; e++)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            Q.Eval(Qvec, T, ip);
+            for (int c = 0; c < vdim; c++) { C(c,q,e) = Qvec(c); }
+         }
+      }
+   }
+   DomainLFAssemble(fes, *ir, coeff, b);
+}
+
+}
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -86,6 +87,13 @@ double NonlinearForm::GetGridFunctionEnergy(const Vector &x) const
    ElementTransformation *T;
    double energy = 0.0;
 
+   if (ext)
+   {
+      MFEM_VERIFY(!fnfi.Size() && !bfnfi.Size(), "face integrators are not"
+                  " supported with partial assembly");
+      return ext->GetGridFunctionEnergy(x);
+   }
+
    if (dnfi.Size())
    {
       for (int i = 0; i < fes->GetNE(); i++)
@@ -137,7 +145,18 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
 
    if (ext)
    {
+      MFEM_VERIFY(!fnfi.Size() && !bfnfi.Size(), "face integrators are not"
+                  " supported with partial assembly");
       ext->Mult(px, py);
+      if (Serial())
+      {
+         if (cP) { cP->MultTranspose(py, y); }
+         const int N = ess_tdof_list.Size();
+         const auto tdof = ess_tdof_list.Read();
+         auto Y = y.ReadWrite();
+         MFEM_FORALL(i, N, Y[tdof[i]] = 0.0; );
+      }
+      // In parallel, the result is in 'py' which is an alias for 'aux2'.
       return;
    }
 
@@ -264,7 +283,16 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
    if (ext)
    {
-      MFEM_ABORT("Not yet implemented!");
+      MFEM_VERIFY(!fnfi.Size() && !bfnfi.Size(), "face integrators are not"
+                  " supported with partial assembly");
+      hGrad.Clear();
+      Operator &grad = ext->GetGradient(Prolongate(x));
+      Operator *Gop;
+      grad.FormSystemOperator(ess_tdof_list, Gop);
+      hGrad.Reset(Gop);
+      // In both serial and parallel, the returned Operator acts on true dofs
+      // and has the essential boundary conditions imposed.
+      return *hGrad.Ptr();
    }
 
    const int skip_zeros = 0;
@@ -45,6 +45,8 @@ protected:
    Array<Array<int>*>              bfnfi_marker; // not owned
 
    mutable SparseMatrix *Grad, *cGrad; // owned
+   /// Gradient Operator when using the extension #ext.
+   mutable OperatorHandle hGrad; // owned
 
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
@@ -9,10 +9,11 @@
 // terms of the BSD-3 license. We welcome feedback and contributions, see file
 // CONTRIBUTING.md for details.
 
-// Implementations of classes FABilinearFormExtension, EABilinearFormExtension,
-// PABilinearFormExtension and MFBilinearFormExtension.
+// Implementations of classes NonlinearFormExtension and
+// PANonlinearFormExtension.
 
 #include "nonlinearform.hpp"
+#include "../general/profiler.hpp"
 
 namespace mfem
 {
@@ -24,20 +25,23 @@ NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
 }
 
 PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form):
-   NonlinearFormExtension(form), fes(*form->FESpace())
+   NonlinearFormExtension(form), fes(*form->FESpace()),
+   elem_restrict(fes.GetElementRestriction(
+                    UsesTensorBasis(fes) ? ElementDofOrdering::LEXICOGRAPHIC :
+                    ElementDofOrdering::NATIVE)),
+   grad(*this) // uses elem_restrict
 {
-   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
-   elem_restrict_lex = fes.GetElementRestriction(ordering);
-   if (elem_restrict_lex)
+   if (elem_restrict)
    {
-      localX.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
-      localY.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+      localX.SetSize(elem_restrict->Height(), Device::GetMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetMemoryType());
       localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
    }
 }
 
 void PANonlinearFormExtension::AssemblePA()
 {
+   MFEM_PROFILE_REGION("PANonlinearFormExtension::AssemblePA");
    Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
    const int Ni = integrators.Size();
    for (int i = 0; i < Ni; ++i)
@@ -48,17 +52,18 @@ void PANonlinearFormExtension::AssemblePA()
 
 void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PROFILE_REGION("PANonlinearFormExtension::Mult");
    Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
    const int iSz = integrators.Size();
-   if (elem_restrict_lex)
+   if (elem_restrict)
    {
-      elem_restrict_lex->Mult(x, localX);
+      elem_restrict->Mult(x, localX);
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
          integrators[i]->AddMultPA(localX, localY);
       }
-      elem_restrict_lex->MultTranspose(localY, y);
+      elem_restrict->MultTranspose(localY, y);
    }
    else
    {
@@ -71,4 +76,76 @@ void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+double PANonlinearFormExtension::GetGridFunctionEnergy(const Vector &x) const
+{
+   MFEM_PROFILE_REGION("PANonlinearFormExtension::GetGridFunctionEnergy");
+   const Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const Vector *e_x = &x;
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      e_x = &localX;
+   }
+   double energy = 0.0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      energy += integrators[i]->GetLocalStateEnergyPA(*e_x);
+   }
+   return energy;
+}
+
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   MFEM_PROFILE_REGION("PANonlinearFormExtension::GetGradient");
+   const Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const Vector *e_x = &x;
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      e_x = &localX;
+   }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AssembleGradPA(*e_x, fes);
+   }
+   return grad;
+}
+
+PANonlinearFormExtension::Gradient::Gradient(
+   const PANonlinearFormExtension &e)
+   : Operator(e.fes.GetVSize()), ext(e)
+{
+   if (ext.elem_restrict)
+   {
+      ge.SetSize(ext.elem_restrict->Height(), Device::GetMemoryType());
+      gy.SetSize(ext.elem_restrict->Height(), Device::GetMemoryType());
+      gy.UseDevice(true);
+   }
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_PROFILE_REGION("PANonlinearFormExtension::Gradient::Mult");
+   const Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   if (ext.elem_restrict)
+   {
+      ext.elem_restrict->Mult(x, ge);
+      gy = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         integrators[i]->AddMultGradPA(ge, gy);
+      }
+      ext.elem_restrict->MultTranspose(gy, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         integrators[i]->AddMultGradPA(x, y);
+      }
+   }
+}
+
 }
@@ -26,19 +26,46 @@ protected:
 public:
    NonlinearFormExtension(NonlinearForm *form);
    virtual void AssemblePA() = 0;
+
+   /// Compute the energy of the state @a x, a "GridFunction size" vector.
+   virtual double GetGridFunctionEnergy(const Vector &x) const = 0;
+
+   /// Return the gradient Operator at the state @a x, an L-vector.
+   /** The returned Operator acts on L-vectors and does not impose any essential
+       boundary conditions. It is valid until the next call to this method. */
+   virtual Operator &GetGradient(const Vector &x) const = 0;
 };
 
 /// Data and methods for partially-assembled nonlinear forms
 class PANonlinearFormExtension : public NonlinearFormExtension
 {
+public:
+   /// Action of the partially assembled gradient on L-vectors.
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+      mutable Vector ge, gy;
+   public:
+      Gradient(const PANonlinearFormExtension &e);
+      virtual void Mult(const Vector &x, Vector &y) const;
+      virtual const Operator *GetProlongation() const
+      { return ext.fes.GetProlongationMatrix(); }
+      virtual const Operator *GetRestriction() const
+      { return ext.fes.GetRestrictionMatrix(); }
+   };
+
 protected:
    const FiniteElementSpace &fes; // Not owned
    mutable Vector localX, localY;
-   const Operator *elem_restrict_lex; // Not owned
+   const Operator *elem_restrict; // Not owned
+   mutable Gradient grad;
 public:
    PANonlinearFormExtension(NonlinearForm*);
    void AssemblePA();
    void Mult(const Vector &x, Vector &y) const;
+   double GetGridFunctionEnergy(const Vector &x) const;
+   Operator &GetGradient(const Vector &x) const;
 };
 }
 #endif // NONLINEARFORM_EXT_HPP
@@ -89,6 +89,24 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Method defining partial assembly of the gradient.
+   /** Prepare the action of the gradient of the integrator at the state given
+       by the E-vector @a x, to be used later in the method AddMultGradPA().
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for partially assembled gradient action.
+   /** Perform the action of the gradient assembled with AssembleGradPA() on
+       the E-vector @a x and add the result to the E-vector @a y. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   /// Compute the local energy of the state given by the E-vector @a x.
+   /** This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual double GetLocalStateEnergyPA(const Vector &x) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -15,6 +15,7 @@
 
 #include "fem.hpp"
 #include "../general/sort_pairs.hpp"
+#include "../general/profiler.hpp"
 
 namespace mfem
 {
@@ -117,12 +118,14 @@ void ParBilinearForm::pAllocMat()
 
    mat = new SparseMatrix(I, J, data, nrows, height + nbr_size);
    *mat = 0.0;
+   elem_csr_offsets.DeleteAll();
 
    dof_dof.LoseData();
 }
 
 void ParBilinearForm::ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local)
 {
+   MFEM_PROFILE_REGION("ParBilinearForm::ParallelAssemble");
    A.Clear();
 
    if (A_local == NULL) { return; }
@@ -232,6 +235,13 @@ void ParBilinearForm::AssembleSharedFaces(int skip_zeros)
 
 void ParBilinearForm::Assemble(int skip_zeros)
 {
+   if (numeric_reassembly)
+   {
+      // The parallel matrices are recomputed from the refilled local matrix
+      p_mat.Clear();
+      p_mat_e.Clear();
+   }
+
    if (mat == NULL && fbfi.Size() > 0)
    {
       pfes->ExchangeFaceNbrData();
@@ -291,6 +301,7 @@ void ParBilinearForm::FormLinearSystem(
    const Array<int> &ess_tdof_list, Vector &x, Vector &b,
    OperatorHandle &A, Vector &X, Vector &B, int copy_interior)
 {
+   MFEM_PROFILE_REGION("ParBilinearForm::FormLinearSystem");
    if (ext)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
@@ -340,6 +351,7 @@ void ParBilinearForm::FormLinearSystem(
 void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                        OperatorHandle &A)
 {
+   MFEM_PROFILE_REGION("ParBilinearForm::FormSystemMatrix");
    if (ext)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
@@ -360,7 +372,9 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
    }
    else
    {
-      if (mat)
+      // With numeric reassembly, the local matrix is kept for the next
+      // Assemble() call, which clears p_mat.
+      if (mat && !(numeric_reassembly && p_mat.Ptr()))
       {
          const int remove_zeros = 0;
          Finalize(remove_zeros);
@@ -368,8 +382,11 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                      "The ParBilinearForm must be updated with Update() before "
                      "re-assembling the ParBilinearForm.");
          ParallelAssemble(p_mat, mat);
-         delete mat;
-         mat = NULL;
+         if (!numeric_reassembly)
+         {
+            delete mat;
+            mat = NULL;
+         }
          delete mat_e;
          mat_e = NULL;
          p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
@@ -19,6 +19,7 @@
 #include "../general/sort_pairs.hpp"
 #include "../mesh/mesh_headers.hpp"
 #include "../general/binaryio.hpp"
+#include "../general/profiler.hpp"
 
 #include <climits> // INT_MAX
 #include <limits>
@@ -90,6 +91,7 @@ ParNURBSExtension *ParFiniteElementSpace::MakeLocalNURBSext(
 
 void ParFiniteElementSpace::ParInit(ParMesh *pm)
 {
+   MFEM_PROFILE_REGION("ParFiniteElementSpace::ParInit");
    pmesh = pm;
    pncmesh = pm->pncmesh;
 
@@ -639,6 +641,7 @@ void ParFiniteElementSpace::GenerateGlobalOffsets() const
 
 void ParFiniteElementSpace::Build_Dof_TrueDof_Matrix() const // matrix P
 {
+   MFEM_PROFILE_REGION("ParFiniteElementSpace::Build_Dof_TrueDof_Matrix");
    MFEM_ASSERT(Conforming(), "wrong code path");
 
    if (P) { return; }
@@ -2867,6 +2870,7 @@ void ParFiniteElementSpace::GetTrueTransferOperator(
 
 void ParFiniteElementSpace::Update(bool want_transform)
 {
+   MFEM_PROFILE_REGION("ParFiniteElementSpace::Update");
    if (mesh->GetSequence() == sequence)
    {
       return; // no need to update, no-op
@@ -2997,6 +3001,20 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 }
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void ConformingProlongationOperator::MultTranspose(
+   const Vector &x, Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void ConformingProlongationOperator::MultBegin(
+   const Vector &x, Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
@@ -3016,12 +3034,22 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
       j = end+1;
    }
    std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
 
+void ConformingProlongationOperator::MultEnd(Vector &y) const
+{
    const int out_layout = 0; // 0 - output is ldofs array
-   gc.BcastEnd(ydata, out_layout);
+   gc.BcastEnd(y.HostReadWrite(), out_layout);
 }
 
-void ConformingProlongationOperator::MultTranspose(
+void ConformingProlongationOperator::MultTransposeBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   gc.ReduceBegin(x.HostRead());
+}
+
+void ConformingProlongationOperator::MultTransposeEnd(
    const Vector &x, Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Height(), "");
@@ -3031,8 +3059,6 @@ void ConformingProlongationOperator::MultTranspose(
    double *ydata = y.HostWrite();
    const int m = external_ldofs.Size();
 
-   gc.ReduceBegin(xdata);
-
    int j = 0;
    for (int i = 0; i < m; i++)
    {
@@ -3113,6 +3139,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   num_requests = 0;
 }
 
 static void ExtractSubVector(const int N,
@@ -3162,8 +3189,8 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
    SetSubVector(ext_ldof.Size(), ext_ldof, ext_buf, y);
 }
 
-void DeviceConformingProlongationOperator::Mult(const Vector &x,
-                                                Vector &y) const
+void DeviceConformingProlongationOperator::MultBegin(const Vector &x,
+                                                     Vector &y) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    BcastBeginCopy(x); // copy to 'shr_buf'
@@ -3190,7 +3217,16 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
       }
    }
    BcastLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultEnd(Vector &y) const
+{
+   {
+      MFEM_PROFILE_MPI_WAIT();
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   }
+   num_requests = 0;
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
@@ -3250,8 +3286,8 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
    AddSubVector(unq_ltdof_size, unq_ltdof, unq_shr_i, unq_shr_j, shr_buf, y);
 }
 
-void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
-                                                         Vector &y) const
+void DeviceConformingProlongationOperator::MultTransposeBegin(
+   const Vector &x) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    ReduceBeginCopy(x); // copy to 'ext_buf'
@@ -3277,8 +3313,18 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                    gtopo.GetComm(), &requests[req_counter++]);
       }
    }
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultTransposeEnd(const Vector &x,
+                                                            Vector &y) const
+{
    ReduceLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   {
+      MFEM_PROFILE_MPI_WAIT();
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   }
+   num_requests = 0;
    ReduceEndAssemble(y); // assemble from 'shr_buf'
 }
 
@@ -391,9 +391,33 @@ protected:
 public:
    ConformingProlongationOperator(const ParFiniteElementSpace &pfes);
 
+   /// Return the sorted list of ldofs owned by a neighbor.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @name Split application
+       Mult() and MultTranspose() in two phases, which allow other computations
+       to overlap with the neighbor communication, see PAOverlappedRAPOperator.
+       Only one operation can be in progress at a time. */
+   ///@{
+   /** @brief Start y = P x: set the owned entries of @a y and start the
+       exchange of the external ones. */
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   /// Finish y = P x, started by MultBegin(): set the external entries of @a y.
+   virtual void MultEnd(Vector &y) const;
+
+   /** @brief Start y = P^T x: start the exchange of the external entries of
+       @a x, which are the only entries read by this call. */
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   /** @brief Finish y = P^T x, started by MultTransposeBegin(): the external
+       entries of @a x are not read. */
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
+   ///@}
 };
 
 /// Auxiliary device class used by ParFiniteElementSpace.
@@ -408,6 +432,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_requests; // number of pending requests
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
    void BcastBeginCopy(const Vector &src) const;
@@ -437,9 +462,13 @@ public:
 
    virtual ~DeviceConformingProlongationOperator();
 
-   virtual void Mult(const Vector &x, Vector &y) const;
+   virtual void MultBegin(const Vector &x, Vector &y) const;
 
-   virtual void MultTranspose(const Vector &x, Vector &y) const;
+   virtual void MultEnd(Vector &y) const;
+
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 }
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <limits>
 #include "../general/forall.hpp"
+#include "../general/profiler.hpp"
 using namespace std;
 
 namespace mfem
@@ -253,8 +254,11 @@ void ParGridFunction::ExchangeFaceNbrData()
                 MPI_DOUBLE, nbr_rank, tag, MyComm, &recv_requests[fn]);
    }
 
-   MPI_Waitall(num_face_nbrs, send_requests, statuses);
-   MPI_Waitall(num_face_nbrs, recv_requests, statuses);
+   {
+      MFEM_PROFILE_MPI_WAIT();
+      MPI_Waitall(num_face_nbrs, send_requests, statuses);
+      MPI_Waitall(num_face_nbrs, recv_requests, statuses);
+   }
 
    delete [] statuses;
    delete [] requests;
@@ -498,6 +502,22 @@ void ParGridFunction::Save(std::ostream &out) const
    }
 }
 
+void ParGridFunction::SaveBinary(std::ostream &out) const
+{
+   double *data_  = const_cast<double*>(HostRead());
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+
+   GridFunction::SaveBinary(out);
+
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+}
+
 #ifdef MFEM_USE_ADIOS2
 void ParGridFunction::Save(adios2stream &out,
                            const std::string& variable_name,
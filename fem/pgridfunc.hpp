@@ -315,6 +315,10 @@ public:
        the local dofs. */
    virtual void Save(std::ostream &out) const;
 
+   /// Save the local portion of the ParGridFunction in MFEM's binary format.
+   /** The signs of the local dofs are taken into account as in Save(). */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /** Save the local portion of the ParGridFunction. This differs from the
        serial GridFunction::Save in that it takes into account the signs of
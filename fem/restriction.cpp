@@ -13,6 +13,7 @@
 #include "gridfunc.hpp"
 #include "fespace.hpp"
 #include "../general/forall.hpp"
+#include "../general/profiler.hpp"
 
 namespace mfem
 {
@@ -148,6 +149,9 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("ElementRestriction::Mult");
+   MFEM_PROFILE_BYTES((x.Size() + y.Size())*sizeof(double) +
+                      gatherMap.Size()*sizeof(int));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -170,6 +174,9 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PROFILE_REGION("ElementRestriction::MultTranspose");
+   MFEM_PROFILE_BYTES((x.Size() + y.Size())*sizeof(double) +
+                      (offsets.Size() + indices.Size())*sizeof(int));
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -223,6 +230,62 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultElements(const Vector& x, Vector& y,
+                                      int e_begin, int e_end) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int first = nd*e_begin;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(k, nd*(e_end - e_begin),
+   {
+      const int i = first + k;
+      const int gid = d_gatherMap[i];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(i % nd, c, i / nd) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeDofs(const Vector& x, Vector& y,
+                                           const Array<int> &dofs) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_dofs = dofs.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(k, dofs.Size(),
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            dofValue += (d_indices[j] >= 0) ? d_x(idx_j % nd, c,
+            idx_j / nd) : -d_x(idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 /// Return the face degrees of freedom returned in Lexicographic order.
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap)
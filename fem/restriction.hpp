@@ -49,6 +49,17 @@ public:
 
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
+
+   /** @brief Compute the part of the E-vector @a y = R @a x of the elements in
+       the range [@a e_begin, @a e_end). The other entries of @a y are not
+       modified. */
+   void MultElements(const Vector &x, Vector &y, int e_begin, int e_end) const;
+
+   /** @brief Compute the entries of @a y = R^T @a x of the scalar dofs in the
+       list @a dofs, for all vector components. The other entries of @a y are
+       not modified. */
+   void MultTransposeDofs(const Vector &x, Vector &y,
+                          const Array<int> &dofs) const;
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
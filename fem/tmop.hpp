@@ -42,6 +42,14 @@ public:
        Jpt. */
    void SetTargetJacobian(const DenseMatrix &_Jtr) { Jtr = &_Jtr; }
 
+   /** @brief Return a new metric of the same type and with the same
+       parameters, or NULL if the metric can not be copied. */
+   /** The metrics keep per-point state (the target Jacobian, the invariants of
+       Jpt), so the partially assembled TMOP_Integrator evaluates them with one
+       copy per host thread. Metrics that return NULL are evaluated by a single
+       thread. */
+   virtual TMOP_QualityMetric *Clone() const { return NULL; }
+
    /** @brief Evaluate the strain energy density function, W = W(Jpt).
        @param[in] Jpt  Represents the target->physical transformation
                        Jacobian matrix. */
@@ -85,6 +93,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_001; }
 };
 
 /// Skew metric, 2D.
@@ -100,6 +111,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_skew2D; }
 };
 
 /// Skew metric, 3D.
@@ -115,6 +129,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_skew3D; }
 };
 
 /// Aspect ratio metric, 2D.
@@ -130,6 +147,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_aspratio2D; }
 };
 
 /// Aspect ratio metric, 3D.
@@ -145,6 +165,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_aspratio3D; }
 };
 
 /// Shape+Size+Orientation metric, 2D.
@@ -160,6 +183,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_SSA2D; }
 };
 
 /// Shape+Size metric, 2D.
@@ -175,6 +201,9 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const
    { MFEM_ABORT("Not implemented"); }
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_SS2D; }
 };
 
 /// Shape, ideal barrier metric, 2D
@@ -191,6 +220,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_002; }
 };
 
 /// Shape & area, ideal barrier metric, 2D
@@ -207,6 +239,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_007; }
 };
 
 /// Shape & area metric, 2D
@@ -223,6 +258,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_009; }
 };
 
 /// Shifted barrier form of metric 2 (shape, ideal barrier metric), 2D
@@ -242,6 +280,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_022(tau0); }
 };
 
 /// Shape, ideal barrier metric, 2D
@@ -258,6 +299,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_050; }
 };
 
 /// Area metric, 2D
@@ -275,6 +319,8 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_055; }
 };
 
 /// Area, ideal barrier metric, 2D
@@ -294,6 +340,8 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_056; }
 };
 
 /// Shape, ideal barrier metric, 2D
@@ -312,6 +360,8 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_058; }
 };
 
 /// Area, ideal barrier metric, 2D
@@ -329,6 +379,8 @@ public:
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
 
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_077; }
 };
 
 /// Untangling metric, 2D
@@ -348,6 +400,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_211(eps); }
 };
 
 /// Shifted barrier form of metric 56 (area, ideal barrier metric), 2D
@@ -368,6 +423,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_252(tau0); }
 };
 
 /// Shape, ideal barrier metric, 3D
@@ -384,6 +442,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_301; }
 };
 
 /// Shape, ideal barrier metric, 3D
@@ -400,6 +461,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_302; }
 };
 
 /// Shape, ideal barrier metric, 3D
@@ -416,6 +480,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_303; }
 };
 
 /// Volume metric, 3D
@@ -432,6 +499,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_315; }
 };
 
 /// Volume, ideal barrier metric, 3D
@@ -450,6 +520,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_316; }
 };
 
 /// Shape & volume, ideal barrier metric, 3D
@@ -466,6 +539,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_321; }
 };
 
 /// Shifted barrier form of 3D metric 16 (volume, ideal barrier metric), 3D
@@ -485,6 +561,9 @@ public:
 
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   virtual TMOP_QualityMetric *Clone() const
+   { return new TMOP_Metric_352(tau0); }
 };
 
 
@@ -832,6 +911,31 @@ protected:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // Partial assembly data, see AssemblePA().
+   struct
+   {
+      bool enabled;
+      // Lexicographic E-vectors and 1D maps (tensor-product elements), or
+      // native E-vectors and full maps.
+      bool tensor;
+      int dim, ne, nq, nd;
+      const FiniteElementSpace *fes; // not owned
+      const IntegrationRule *ir;     // not owned
+      const DofToQuad *maps;         // not owned
+      const Operator *R;             // element restriction, not owned
+      // Copies of the metric used by the host threads 1, 2, ...; owned.
+      Array<TMOP_QualityMetric *> metrics;
+      // Quadrature point data computed serially before each evaluation:
+      // target Jacobians, weights of the metric and the limiting terms, and
+      // limiting distances.
+      mutable DenseTensor Jtr;
+      mutable Vector W1, W0, LD;
+      // E-vector of the limiting nodes.
+      mutable Vector X0;
+      // Gradient data at the quadrature points, see AssembleGradPA().
+      Vector H, H0;
+   } PA;
+
    void ComputeNormalizationEnergies(const GridFunction &x,
                                      double &metric_energy, double &lim_energy);
 
@@ -865,6 +969,11 @@ protected:
 #endif
    void ComputeMinJac(const Vector &x, const FiniteElementSpace &fes);
 
+   // Compute PA.Jtr, PA.W1, PA.W0, PA.LD and PA.X0 for the E-vector x.
+   void ComputeQuadDataPA(const Vector &x) const;
+   // Number of host threads used by the PA methods.
+   int NumThreadsPA() const;
+
 public:
    /** @param[in] m  TMOP_QualityMetric that will be integrated (not owned).
        @param[in] tc Target-matrix construction algorithm to use (not owned). */
@@ -875,11 +984,12 @@ public:
         lim_dist(NULL), lim_func(NULL), lim_normal(1.0),
         discr_tc(dynamic_cast<DiscreteAdaptTC *>(tc)),
         fdflag(false), dxscale(1.0e3)
-   { }
+   { PA.enabled = false; }
 
    ~TMOP_Integrator()
    {
       delete lim_func;
+      for (int i = 0; i < PA.metrics.Size(); i++) { delete PA.metrics[i]; }
       for (int i = 0; i < ElemDer.Size(); i++)
       {
          delete ElemDer[i];
@@ -933,6 +1043,29 @@ public:
                                     ElementTransformation &T,
                                     const Vector &elfun, DenseMatrix &elmat);
 
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /// Prepare the partially assembled evaluation on the space @a fes.
+   /** The E-vectors of the PA methods are in lexicographic ordering for
+       tensor-product elements and in native ordering otherwise, and all
+       elements must have the same geometry. The metric and its derivatives are
+       evaluated element-wise with sum factorization on tensor-product
+       elements. When the host has several threads, see
+       Device::NumHostThreads(), the elements are split between the threads,
+       each with its own copy of the metric (TMOP_QualityMetric::Clone()). The
+       target construction and the coefficients are evaluated by a single
+       thread, while the limiting function must be safe to call from several
+       threads. The finite difference approximations are not supported. */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   virtual double GetLocalStateEnergyPA(const Vector &x) const;
+
    DiscreteAdaptTC *GetDiscreteAdaptTC() { return discr_tc; }
 
    /** @brief Computes the normalization factors of the metric and limiting
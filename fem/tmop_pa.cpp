@@ -0,0 +1,655 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Partial assembly and threaded evaluation of TMOP_Integrator.
+
+#include "tmop.hpp"
+#include "fem.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+// The element kernels below work with the positions x(d,c) of the nd dofs of
+// one element, c = 0,...,dim-1, and with the quadrature point values u(c,q) and
+// reference gradients du(c,k,q) = d x_c / d xi_k, i.e. du(.,.,q) is the
+// ref->physical Jacobian Jpr at the point q. All arrays are column-major.
+
+// Size of the workspace used by EvalQuad() and EvalQuadT().
+static int WorkSizePA(const DofToQuad &maps, bool tensor, int dim)
+{
+   if (!tensor) { return 0; }
+   const int D = maps.ndof, Q = maps.nqpt;
+   return (dim == 2) ? 2*Q*D : 2*Q*D*D + 3*Q*Q*D;
+}
+
+// Compute u and du from x.
+static void EvalQuad(const DofToQuad &maps, bool tensor, int dim,
+                     const double *x, double *u, double *du, double *w)
+{
+   const double *B = maps.B.GetData(), *G = maps.G.GetData();
+   if (!tensor)
+   {
+      const int nd = maps.ndof, nq = maps.nqpt;
+      for (int q = 0; q < nq; q++)
+      {
+         for (int c = 0; c < dim; c++)
+         {
+            const double *xc = x + nd*c;
+            double v = 0.0;
+            for (int d = 0; d < nd; d++) { v += B[q + nq*d] * xc[d]; }
+            u[c + dim*q] = v;
+            for (int k = 0; k < dim; k++)
+            {
+               double g = 0.0;
+               for (int d = 0; d < nd; d++)
+               {
+                  g += G[q + nq*(k + dim*d)] * xc[d];
+               }
+               du[c + dim*(k + dim*q)] = g;
+            }
+         }
+      }
+      return;
+   }
+   const int D = maps.ndof, Q = maps.nqpt;
+   if (dim == 2)
+   {
+      double *bx = w, *gx = w + Q*D;
+      for (int c = 0; c < 2; c++)
+      {
+         const double *xc = x + D*D*c;
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double b = 0.0, g = 0.0;
+               for (int dx = 0; dx < D; dx++)
+               {
+                  const double s = xc[dx + D*dy];
+                  b += B[qx + Q*dx] * s;
+                  g += G[qx + Q*dx] * s;
+               }
+               bx[qx + Q*dy] = b;
+               gx[qx + Q*dy] = g;
+            }
+         }
+         for (int qy = 0; qy < Q; qy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double v = 0.0, d0 = 0.0, d1 = 0.0;
+               for (int dy = 0; dy < D; dy++)
+               {
+                  v  += bx[qx + Q*dy] * B[qy + Q*dy];
+                  d0 += gx[qx + Q*dy] * B[qy + Q*dy];
+                  d1 += bx[qx + Q*dy] * G[qy + Q*dy];
+               }
+               const int q = qx + Q*qy;
+               u[c + 2*q] = v;
+               du[c + 2*(0 + 2*q)] = d0;
+               du[c + 2*(1 + 2*q)] = d1;
+            }
+         }
+      }
+      return;
+   }
+   double *b1 = w, *g1 = b1 + Q*D*D;
+   double *bb = g1 + Q*D*D, *gb = bb + Q*Q*D, *bg = gb + Q*Q*D;
+   for (int c = 0; c < 3; c++)
+   {
+      const double *xc = x + D*D*D*c;
+      for (int dz = 0; dz < D; dz++)
+      {
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double b = 0.0, g = 0.0;
+               for (int dx = 0; dx < D; dx++)
+               {
+                  const double s = xc[dx + D*(dy + D*dz)];
+                  b += B[qx + Q*dx] * s;
+                  g += G[qx + Q*dx] * s;
+               }
+               b1[qx + Q*(dy + D*dz)] = b;
+               g1[qx + Q*(dy + D*dz)] = g;
+            }
+         }
+      }
+      for (int dz = 0; dz < D; dz++)
+      {
+         for (int qy = 0; qy < Q; qy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double v_bb = 0.0, v_gb = 0.0, v_bg = 0.0;
+               for (int dy = 0; dy < D; dy++)
+               {
+                  const double b = b1[qx + Q*(dy + D*dz)];
+                  const double g = g1[qx + Q*(dy + D*dz)];
+                  v_bb += b * B[qy + Q*dy];
+                  v_gb += g * B[qy + Q*dy];
+                  v_bg += b * G[qy + Q*dy];
+               }
+               bb[qx + Q*(qy + Q*dz)] = v_bb;
+               gb[qx + Q*(qy + Q*dz)] = v_gb;
+               bg[qx + Q*(qy + Q*dz)] = v_bg;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q; qz++)
+      {
+         for (int qy = 0; qy < Q; qy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double v = 0.0, d0 = 0.0, d1 = 0.0, d2 = 0.0;
+               for (int dz = 0; dz < D; dz++)
+               {
+                  const int i = qx + Q*(qy + Q*dz);
+                  v  += bb[i] * B[qz + Q*dz];
+                  d0 += gb[i] * B[qz + Q*dz];
+                  d1 += bg[i] * B[qz + Q*dz];
+                  d2 += bb[i] * G[qz + Q*dz];
+               }
+               const int q = qx + Q*(qy + Q*qz);
+               u[c + 3*q] = v;
+               du[c + 3*(0 + 3*q)] = d0;
+               du[c + 3*(1 + 3*q)] = d1;
+               du[c + 3*(2 + 3*q)] = d2;
+            }
+         }
+      }
+   }
+}
+
+// Add to y(d,c) the transpose of EvalQuad() applied to u and du, i.e. the sum
+// over the quadrature points of shape_d u(c,q) + sum_k dshape_dk du(c,k,q). The
+// values u may be NULL.
+static void EvalQuadT(const DofToQuad &maps, bool tensor, int dim,
+                      const double *u, const double *du, double *y, double *w)
+{
+   const double *B = maps.B.GetData(), *G = maps.G.GetData();
+   if (!tensor)
+   {
+      const int nd = maps.ndof, nq = maps.nqpt;
+      for (int c = 0; c < dim; c++)
+      {
+         double *yc = y + nd*c;
+         for (int d = 0; d < nd; d++)
+         {
+            double s = 0.0;
+            for (int q = 0; q < nq; q++)
+            {
+               if (u) { s += B[q + nq*d] * u[c + dim*q]; }
+               for (int k = 0; k < dim; k++)
+               {
+                  s += G[q + nq*(k + dim*d)] * du[c + dim*(k + dim*q)];
+               }
+            }
+            yc[d] += s;
+         }
+      }
+      return;
+   }
+   const int D = maps.ndof, Q = maps.nqpt;
+   if (dim == 2)
+   {
+      double *tb = w, *tg = w + Q*D;
+      for (int c = 0; c < 2; c++)
+      {
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double b = 0.0, g = 0.0;
+               for (int qy = 0; qy < Q; qy++)
+               {
+                  const int q = qx + Q*qy;
+                  const double v = u ? u[c + 2*q] : 0.0;
+                  b += v * B[qy + Q*dy] + du[c + 2*(1 + 2*q)] * G[qy + Q*dy];
+                  g += du[c + 2*(0 + 2*q)] * B[qy + Q*dy];
+               }
+               tb[qx + Q*dy] = b;
+               tg[qx + Q*dy] = g;
+            }
+         }
+         double *yc = y + D*D*c;
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int dx = 0; dx < D; dx++)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  s += tb[qx + Q*dy] * B[qx + Q*dx] +
+                       tg[qx + Q*dy] * G[qx + Q*dx];
+               }
+               yc[dx + D*dy] += s;
+            }
+         }
+      }
+      return;
+   }
+   double *b1 = w, *g1 = b1 + Q*D*D;
+   double *bb = g1 + Q*D*D, *gb = bb + Q*Q*D, *bg = gb + Q*Q*D;
+   for (int c = 0; c < 3; c++)
+   {
+      for (int dz = 0; dz < D; dz++)
+      {
+         for (int qy = 0; qy < Q; qy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double v_bb = 0.0, v_gb = 0.0, v_bg = 0.0;
+               for (int qz = 0; qz < Q; qz++)
+               {
+                  const int q = qx + Q*(qy + Q*qz);
+                  const double v = u ? u[c + 3*q] : 0.0;
+                  v_bb += v * B[qz + Q*dz] + du[c + 3*(2 + 3*q)] * G[qz + Q*dz];
+                  v_gb += du[c + 3*(0 + 3*q)] * B[qz + Q*dz];
+                  v_bg += du[c + 3*(1 + 3*q)] * B[qz + Q*dz];
+               }
+               bb[qx + Q*(qy + Q*dz)] = v_bb;
+               gb[qx + Q*(qy + Q*dz)] = v_gb;
+               bg[qx + Q*(qy + Q*dz)] = v_bg;
+            }
+         }
+      }
+      for (int dz = 0; dz < D; dz++)
+      {
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               double b = 0.0, g = 0.0;
+               for (int qy = 0; qy < Q; qy++)
+               {
+                  const int i = qx + Q*(qy + Q*dz);
+                  b += bb[i] * B[qy + Q*dy] + bg[i] * G[qy + Q*dy];
+                  g += gb[i] * B[qy + Q*dy];
+               }
+               b1[qx + Q*(dy + D*dz)] = b;
+               g1[qx + Q*(dy + D*dz)] = g;
+            }
+         }
+      }
+      double *yc = y + D*D*D*c;
+      for (int dz = 0; dz < D; dz++)
+      {
+         for (int dy = 0; dy < D; dy++)
+         {
+            for (int dx = 0; dx < D; dx++)
+            {
+               double s = 0.0;
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  const int i = qx + Q*(dy + D*dz);
+                  s += b1[i] * B[qx + Q*dx] + g1[i] * G[qx + Q*dx];
+               }
+               yc[dx + D*(dy + D*dz)] += s;
+            }
+         }
+      }
+   }
+}
+
+// Call body(t, begin, end) for the elements [begin, end) of the nt tasks.
+template <typename BODY>
+static void ForallElementsPA(const int ne, const int nt, BODY &&body)
+{
+   HostParallelFor(nt, [&](int t)
+   {
+      const int begin = (int)((long long)t*ne/nt);
+      const int end = (int)((long long)(t+1)*ne/nt);
+      body(t, begin, end);
+   });
+}
+
+void TMOP_Integrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(!fdflag, "finite differences are not supported with PA");
+   const Mesh *mesh = fes.GetMesh();
+   PA.enabled = true;
+   PA.fes = &fes;
+   PA.dim = mesh->Dimension();
+   PA.ne = fes.GetNE();
+   MFEM_VERIFY(fes.GetVDim() == PA.dim, "the space must have vdim == dim");
+   for (int i = 0; i < PA.metrics.Size(); i++) { delete PA.metrics[i]; }
+   PA.metrics.SetSize(0);
+   if (PA.ne == 0) { return; }
+
+   const FiniteElement &el = *fes.GetFE(0);
+   const Geometry::Type geom = el.GetGeomType();
+   for (int e = 1; e < PA.ne; e++)
+   {
+      MFEM_VERIFY(fes.GetFE(e)->GetGeomType() == geom,
+                  "PA requires elements of a single geometry");
+   }
+   PA.ir = IntRule ? IntRule : &IntRules.Get(geom, 2*el.GetOrder() + 3);
+   PA.nq = PA.ir->GetNPoints();
+   PA.nd = el.GetDof();
+   // The ordering of the E-vectors of PANonlinearFormExtension.
+   PA.tensor = UsesTensorBasis(fes) && !fes.IsDGSpace();
+   const ElementDofOrdering ordering = PA.tensor ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   PA.R = fes.GetElementRestriction(ordering);
+   PA.maps = &el.GetDofToQuad(*PA.ir, PA.tensor ? DofToQuad::TENSOR :
+                              DofToQuad::FULL);
+   PA.Jtr.SetSize(PA.dim, PA.dim, PA.nq*PA.ne);
+
+   const int nt = std::min(Device::NumHostThreads(), PA.ne);
+   for (int t = 1; t < nt; t++)
+   {
+      TMOP_QualityMetric *m = metric->Clone();
+      if (m == NULL) { break; }
+      PA.metrics.Append(m);
+   }
+}
+
+int TMOP_Integrator::NumThreadsPA() const
+{
+   return std::max(1, std::min(PA.ne, 1 + PA.metrics.Size()));
+}
+
+void TMOP_Integrator::ComputeQuadDataPA(const Vector &x) const
+{
+   const int dim = PA.dim, ne = PA.ne, nq = PA.nq, nd = PA.nd;
+   const FiniteElementSpace &fes = *PA.fes;
+   const IntegrationRule &ir = *PA.ir;
+
+   // Native -> lexicographic dof map, if needed.
+   const int *dof_map = NULL;
+   if (PA.tensor)
+   {
+      const TensorBasisElement *tbe =
+         dynamic_cast<const TensorBasisElement *>(fes.GetFE(0));
+      if (tbe->GetDofMap().Size() > 0) { dof_map = tbe->GetDofMap().GetData(); }
+   }
+
+   PA.W1.SetSize(nq*ne);
+   if (coeff0)
+   {
+      PA.W0.SetSize(nq*ne);
+      PA.LD.SetSize(nq*ne);
+      MFEM_VERIFY(nodes0->Size() == fes.GetVSize() &&
+                  nodes0->FESpace()->GetOrdering() == fes.GetOrdering(),
+                  "the limiting nodes must be in the space of the positions");
+      PA.X0.SetSize(PA.R->Height());
+      PA.R->Mult(*nodes0, PA.X0);
+      PA.X0.HostRead();
+   }
+
+   const double *X = x.HostRead();
+   Vector elfun(nd*dim), d_vals;
+   DenseMatrix PMat(elfun.GetData(), nd, dim);
+   DenseTensor Jtr_e(dim, dim, nq);
+   IsoparametricTransformation Tpr;
+   for (int e = 0; e < ne; e++)
+   {
+      const FiniteElement &el = *fes.GetFE(e);
+      for (int c = 0; c < dim; c++)
+      {
+         for (int d = 0; d < nd; d++)
+         {
+            const int dn = dof_map ? dof_map[d] : d;
+            elfun(dn + nd*c) = X[d + nd*(c + dim*e)];
+         }
+      }
+      targetC->ComputeElementTargets(e, el, ir, elfun, Jtr_e);
+      if (coeff1 || coeff0)
+      {
+         Tpr.SetFE(&el);
+         Tpr.ElementNo = e;
+         Tpr.Attribute = fes.GetAttribute(e);
+         Tpr.GetPointMat().Transpose(PMat);
+      }
+      if (coeff0)
+      {
+         if (lim_dist) { lim_dist->GetValues(e, ir, d_vals); }
+         else { d_vals.SetSize(nq); d_vals = 1.0; }
+      }
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         const int i = q + nq*e;
+         PA.Jtr(i) = Jtr_e(q);
+         const double weight = ip.weight * Jtr_e(q).Det();
+         if (coeff1 || coeff0) { Tpr.SetIntPoint(&ip); }
+         PA.W1(i) = weight * metric_normal;
+         if (coeff1) { PA.W1(i) *= coeff1->Eval(Tpr, ip); }
+         if (coeff0)
+         {
+            PA.W0(i) = weight * lim_normal * coeff0->Eval(Tpr, ip);
+            PA.LD(i) = d_vals(q);
+         }
+      }
+   }
+}
+
+double TMOP_Integrator::GetLocalStateEnergyPA(const Vector &x) const
+{
+   MFEM_VERIFY(PA.enabled, "AssemblePA() must be called first");
+   if (PA.ne == 0) { return 0.0; }
+   ComputeQuadDataPA(x);
+
+   const int dim = PA.dim, nq = PA.nq, nd = PA.nd;
+   const DofToQuad &maps = *PA.maps;
+   const bool tensor = PA.tensor;
+   const double *X = x.HostRead();
+   const int nt = NumThreadsPA();
+   Array<double> energy(nt);
+   ForallElementsPA(PA.ne, nt, [&](int t, int begin, int end)
+   {
+      TMOP_QualityMetric &m = (t == 0) ? *metric : *PA.metrics[t-1];
+      Vector u(dim*nq), du(dim*dim*nq), u0(dim*nq), du0(dim*dim*nq);
+      Vector w(WorkSizePA(maps, tensor, dim));
+      DenseMatrix Jrt(dim), Jpt(dim);
+      double en = 0.0;
+      for (int e = begin; e < end; e++)
+      {
+         EvalQuad(maps, tensor, dim, X + nd*dim*e, u, du, w);
+         if (coeff0)
+         {
+            EvalQuad(maps, tensor, dim, PA.X0.GetData() + nd*dim*e, u0, du0, w);
+         }
+         for (int q = 0; q < nq; q++)
+         {
+            const int i = q + nq*e;
+            const DenseMatrix Jtr(PA.Jtr.GetData(i), dim, dim);
+            const DenseMatrix Jpr(du.GetData() + dim*dim*q, dim, dim);
+            m.SetTargetJacobian(Jtr);
+            CalcInverse(Jtr, Jrt);
+            Mult(Jpr, Jrt, Jpt);
+            en += PA.W1(i) * m.EvalW(Jpt);
+            if (coeff0)
+            {
+               const Vector p(u.GetData() + dim*q, dim);
+               const Vector p0(u0.GetData() + dim*q, dim);
+               en += PA.W0(i) * lim_func->Eval(p, p0, PA.LD(i));
+            }
+         }
+      }
+      energy[t] = en;
+   });
+   double sum = 0.0;
+   for (int t = 0; t < nt; t++) { sum += energy[t]; }
+   return sum;
+}
+
+void TMOP_Integrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(PA.enabled, "AssemblePA() must be called first");
+   MFEM_VERIFY(!fdflag, "finite differences are not supported with PA");
+   if (PA.ne == 0) { return; }
+   ComputeQuadDataPA(x);
+
+   const int dim = PA.dim, nq = PA.nq, nd = PA.nd;
+   const DofToQuad &maps = *PA.maps;
+   const bool tensor = PA.tensor;
+   const double *X = x.HostRead();
+   double *Y = y.HostReadWrite();
+   ForallElementsPA(PA.ne, NumThreadsPA(), [&](int t, int begin, int end)
+   {
+      TMOP_QualityMetric &m = (t == 0) ? *metric : *PA.metrics[t-1];
+      Vector u(dim*nq), du(dim*dim*nq), u0(dim*nq), du0(dim*dim*nq);
+      Vector w(WorkSizePA(maps, tensor, dim)), d1;
+      DenseMatrix Jrt(dim), Jpt(dim), P(dim);
+      for (int e = begin; e < end; e++)
+      {
+         EvalQuad(maps, tensor, dim, X + nd*dim*e, u, du, w);
+         if (coeff0)
+         {
+            EvalQuad(maps, tensor, dim, PA.X0.GetData() + nd*dim*e, u0, du0, w);
+         }
+         for (int q = 0; q < nq; q++)
+         {
+            const int i = q + nq*e;
+            const DenseMatrix Jtr(PA.Jtr.GetData(i), dim, dim);
+            DenseMatrix Jpr(du.GetData() + dim*dim*q, dim, dim);
+            m.SetTargetJacobian(Jtr);
+            CalcInverse(Jtr, Jrt);
+            Mult(Jpr, Jrt, Jpt);
+            m.EvalP(Jpt, P);
+            P *= PA.W1(i);
+            // The reference gradient coefficients P Jrt^t replace Jpr.
+            MultABt(P, Jrt, Jpr);
+            if (coeff0)
+            {
+               Vector p(u.GetData() + dim*q, dim);
+               const Vector p0(u0.GetData() + dim*q, dim);
+               lim_func->Eval_d1(p, p0, PA.LD(i), d1);
+               for (int c = 0; c < dim; c++) { p(c) = PA.W0(i) * d1(c); }
+            }
+         }
+         EvalQuadT(maps, tensor, dim, coeff0 ? u.GetData() : NULL, du,
+                   Y + nd*dim*e, w);
+      }
+   });
+}
+
+void TMOP_Integrator::AssembleGradPA(const Vector &x,
+                                     const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(PA.enabled && PA.fes == &fes,
+               "AssemblePA() must be called first");
+   MFEM_VERIFY(!fdflag, "finite differences are not supported with PA");
+   if (PA.ne == 0) { return; }
+   ComputeQuadDataPA(x);
+
+   const int dim = PA.dim, nq = PA.nq, nd = PA.nd, dim2 = dim*dim;
+   const DofToQuad &maps = *PA.maps;
+   const bool tensor = PA.tensor;
+   const double *X = x.HostRead();
+   PA.H.SetSize(dim2*dim2*nq*PA.ne);
+   PA.H0.SetSize(coeff0 ? dim2*nq*PA.ne : 0);
+   ForallElementsPA(PA.ne, NumThreadsPA(), [&](int t, int begin, int end)
+   {
+      TMOP_QualityMetric &m = (t == 0) ? *metric : *PA.metrics[t-1];
+      Vector u(dim*nq), du(dim*dim*nq), u0(dim*nq), du0(dim*dim*nq);
+      Vector w(WorkSizePA(maps, tensor, dim));
+      DenseMatrix Jrt(dim), Jpt(dim), d2;
+      for (int e = begin; e < end; e++)
+      {
+         EvalQuad(maps, tensor, dim, X + nd*dim*e, u, du, w);
+         if (coeff0)
+         {
+            EvalQuad(maps, tensor, dim, PA.X0.GetData() + nd*dim*e, u0, du0, w);
+         }
+         for (int q = 0; q < nq; q++)
+         {
+            const int i = q + nq*e;
+            const DenseMatrix Jtr(PA.Jtr.GetData(i), dim, dim);
+            const DenseMatrix Jpr(du.GetData() + dim*dim*q, dim, dim);
+            m.SetTargetJacobian(Jtr);
+            CalcInverse(Jtr, Jrt);
+            Mult(Jpr, Jrt, Jpt);
+            // With DS = Jrt, A(m + dim*j, n + dim*l) is the derivative of the
+            // coefficient (j,m) of P Jrt^t with respect to Jpr(l,n).
+            DenseMatrix A(PA.H.GetData() + dim2*dim2*i, dim2, dim2);
+            A = 0.0;
+            m.AssembleH(Jpt, Jrt, PA.W1(i), A);
+            if (coeff0)
+            {
+               const Vector p(u.GetData() + dim*q, dim);
+               const Vector p0(u0.GetData() + dim*q, dim);
+               lim_func->Eval_d2(p, p0, PA.LD(i), d2);
+               DenseMatrix H0(PA.H0.GetData() + dim2*i, dim, dim);
+               H0.Set(PA.W0(i), d2);
+            }
+         }
+      }
+   });
+}
+
+void TMOP_Integrator::AddMultGradPA(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(PA.enabled, "AssemblePA() must be called first");
+   if (PA.ne == 0) { return; }
+
+   const int dim = PA.dim, nq = PA.nq, nd = PA.nd, dim2 = dim*dim;
+   const DofToQuad &maps = *PA.maps;
+   const bool tensor = PA.tensor;
+   const bool lim = PA.H0.Size() > 0;
+   const double *X = x.HostRead();
+   double *Y = y.HostReadWrite();
+   const double *H = PA.H.HostRead(), *H0 = PA.H0.HostRead();
+   ForallElementsPA(PA.ne, NumThreadsPA(), [&](int t, int begin, int end)
+   {
+      Vector u(dim*nq), du(dim2*nq), v(dim*nq), dv(dim2*nq);
+      Vector w(WorkSizePA(maps, tensor, dim));
+      for (int e = begin; e < end; e++)
+      {
+         EvalQuad(maps, tensor, dim, X + nd*dim*e, u, du, w);
+         for (int q = 0; q < nq; q++)
+         {
+            const int i = q + nq*e;
+            const double *A = H + dim2*dim2*i;
+            const double *dJ = du.GetData() + dim2*q;
+            for (int j = 0; j < dim; j++)
+            {
+               for (int m = 0; m < dim; m++)
+               {
+                  double s = 0.0;
+                  for (int n = 0; n < dim; n++)
+                  {
+                     for (int l = 0; l < dim; l++)
+                     {
+                        s += A[(m + dim*j) + dim2*(n + dim*l)] *
+                             dJ[l + dim*n];
+                     }
+                  }
+                  dv(j + dim*(m + dim*q)) = s;
+               }
+            }
+            if (lim)
+            {
+               const double *A0 = H0 + dim2*i;
+               for (int c = 0; c < dim; c++)
+               {
+                  double s = 0.0;
+                  for (int k = 0; k < dim; k++)
+                  {
+                     s += A0[c + dim*k] * u(k + dim*q);
+                  }
+                  v(c + dim*q) = s;
+               }
+            }
+         }
+         EvalQuadT(maps, tensor, dim, lim ? v.GetData() : NULL, dv,
+                   Y + nd*dim*e, w);
+      }
+   });
+}
+
+} // namespace mfem
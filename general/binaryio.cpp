@@ -12,6 +12,17 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mfem
 {
 namespace bin_io
@@ -52,4 +63,245 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes)
 }
 
 } // namespace mfem::bin_io
+
+
+// Layout of the binary container: the first line "MFEM binary v1.0\n", padded
+// with zeros to 24 bytes, the byte order mark (uint32), the number of sections
+// (uint32) and the total size in bytes (uint64), followed by the table of the
+// sections. Each entry of the table has the name of the section (48 chars,
+// padded with zeros), the type (uint32), a reserved field (uint32), the offset
+// of the data from the beginning of the container (uint64) and the number of
+// entries (uint64).
+namespace internal
+{
+
+static const size_t bin_header_size = 40;
+static const size_t bin_entry_size = 72;
+static const size_t bin_name_size = 48;
+static const size_t bin_alignment = 64;
+static const std::uint32_t bin_byte_order = 0x01020304;
+
+static size_t BinTypeSize(int type)
+{
+   switch (type)
+   {
+      case BinaryWriter::INT: return sizeof(std::int32_t);
+      case BinaryWriter::DOUBLE: return sizeof(double);
+      case BinaryWriter::CHAR: return 1;
+   }
+   return 0;
+}
+
+} // namespace mfem::internal
+
+void BinaryWriter::Add(const std::string &name, int type, const void *data,
+                       size_t count)
+{
+   MFEM_VERIFY(!name.empty() && name.size() < internal::bin_name_size,
+               "invalid section name: '" << name << "'");
+   MFEM_VERIFY(sizeof(int) == sizeof(std::int32_t), "int must be 32-bit");
+   Section sec;
+   sec.name = name;
+   sec.type = type;
+   sec.data = data;
+   sec.count = count;
+   sections.push_back(sec);
+}
+
+void BinaryWriter::AddSection(const std::string &name,
+                              const std::string &text)
+{
+   Add(name, CHAR, NULL, text.size());
+   sections.back().text = text;
+}
+
+void BinaryWriter::Write(std::ostream &out) const
+{
+   using namespace internal;
+   const size_t ns = sections.size();
+   const size_t table_end = bin_header_size + bin_entry_size*ns;
+
+   // Offsets of the aligned section data
+   std::vector<std::uint64_t> offsets(ns);
+   size_t pos = table_end;
+   for (size_t i = 0; i < ns; i++)
+   {
+      pos = (pos + bin_alignment - 1)/bin_alignment*bin_alignment;
+      offsets[i] = pos;
+      pos += sections[i].count*BinTypeSize(sections[i].type);
+   }
+   const std::uint64_t total = pos;
+
+   std::vector<char> header(table_end, 0);
+   std::memcpy(header.data(), BinaryReader::magic,
+               std::strlen(BinaryReader::magic));
+   header[std::strlen(BinaryReader::magic)] = '\n';
+   const std::uint32_t num_sections = (std::uint32_t)ns;
+   std::memcpy(&header[24], &bin_byte_order, 4);
+   std::memcpy(&header[28], &num_sections, 4);
+   std::memcpy(&header[32], &total, 8);
+   for (size_t i = 0; i < ns; i++)
+   {
+      char *entry = &header[bin_header_size + bin_entry_size*i];
+      const std::uint32_t type = sections[i].type;
+      const std::uint64_t count = sections[i].count;
+      std::memcpy(entry, sections[i].name.data(), sections[i].name.size());
+      std::memcpy(entry + 48, &type, 4);
+      std::memcpy(entry + 56, &offsets[i], 8);
+      std::memcpy(entry + 64, &count, 8);
+   }
+   out.write(header.data(), header.size());
+
+   const char zeros[bin_alignment] = { 0 };
+   pos = table_end;
+   for (size_t i = 0; i < ns; i++)
+   {
+      const Section &sec = sections[i];
+      out.write(zeros, offsets[i] - pos);
+      const size_t bytes = sec.count*BinTypeSize(sec.type);
+      const void *sec_data = (sec.type == CHAR) ? sec.text.data() : sec.data;
+      out.write(static_cast<const char*>(sec_data), bytes);
+      pos = offsets[i] + bytes;
+   }
+}
+
+
+const char BinaryReader::magic[] = "MFEM binary v1.0";
+
+void BinaryReader::Unmap()
+{
+#ifndef _WIN32
+   if (mapped) { munmap(data, size); }
+#endif
+   buffer.clear();
+   sections.clear();
+   data = NULL;
+   size = 0;
+   mapped = false;
+}
+
+void BinaryReader::ParseHeader()
+{
+   using namespace internal;
+   MFEM_VERIFY(size >= bin_header_size &&
+               std::memcmp(data, magic, std::strlen(magic)) == 0,
+               "invalid MFEM binary container");
+   std::uint32_t byte_order, num_sections;
+   std::uint64_t total;
+   std::memcpy(&byte_order, data + 24, 4);
+   std::memcpy(&num_sections, data + 28, 4);
+   std::memcpy(&total, data + 32, 8);
+   MFEM_VERIFY(byte_order == bin_byte_order,
+               "the binary container was written with a different byte order");
+   MFEM_VERIFY(total <= size &&
+               bin_header_size + bin_entry_size*num_sections <= total,
+               "truncated MFEM binary container");
+
+   sections.clear();
+   for (size_t i = 0; i < num_sections; i++)
+   {
+      const char *entry = data + bin_header_size + bin_entry_size*i;
+      std::uint32_t type;
+      std::uint64_t offset, count;
+      std::memcpy(&type, entry + 48, 4);
+      std::memcpy(&offset, entry + 56, 8);
+      std::memcpy(&count, entry + 64, 8);
+      const std::string name(entry, strnlen(entry, bin_name_size - 1));
+      MFEM_VERIFY(BinTypeSize(type) > 0 &&
+                  offset + count*BinTypeSize(type) <= total,
+                  "invalid section in MFEM binary container: " << name);
+      Section &sec = sections[name];
+      sec.type = type;
+      sec.offset = offset;
+      sec.count = count;
+   }
+}
+
+const BinaryReader::Section &BinaryReader::Find(const std::string &name,
+                                                int type) const
+{
+   std::map<std::string, Section>::const_iterator it = sections.find(name);
+   MFEM_VERIFY(it != sections.end(), "section not found: " << name);
+   MFEM_VERIFY(it->second.type == type, "invalid type of section " << name);
+   return it->second;
+}
+
+void BinaryReader::Map(const std::string &filename)
+{
+   Unmap();
+#ifndef _WIN32
+   const int fd = open(filename.c_str(), O_RDONLY);
+   MFEM_VERIFY(fd >= 0, "cannot open file: " << filename);
+   struct stat st;
+   const int err = fstat(fd, &st);
+   MFEM_VERIFY(err == 0 && (size_t)st.st_size >= internal::bin_header_size,
+               "invalid MFEM binary file: " << filename);
+   // Private mapping: the pages written to are copied, not the file
+   void *ptr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    fd, 0);
+   close(fd);
+   MFEM_VERIFY(ptr != MAP_FAILED, "mmap failed for file: " << filename);
+   data = static_cast<char*>(ptr);
+   size = st.st_size;
+   mapped = true;
+#else
+   std::ifstream in(filename.c_str(), std::ios::binary);
+   MFEM_VERIFY(in, "cannot open file: " << filename);
+   in.seekg(0, std::ios::end);
+   buffer.resize((size_t)in.tellg());
+   in.seekg(0, std::ios::beg);
+   in.read(buffer.data(), buffer.size());
+   data = buffer.data();
+   size = buffer.size();
+#endif
+   ParseHeader();
+}
+
+void BinaryReader::Read(std::istream &in)
+{
+   using namespace internal;
+   Unmap();
+   char header[bin_header_size] = { 0 };
+   const size_t magic_len = std::strlen(magic);
+   std::memcpy(header, magic, magic_len);
+   header[magic_len] = '\n';
+   in.read(header + magic_len + 1, bin_header_size - magic_len - 1);
+   MFEM_VERIFY(in, "error reading MFEM binary container");
+   std::uint32_t byte_order;
+   std::uint64_t total;
+   std::memcpy(&byte_order, header + 24, 4);
+   std::memcpy(&total, header + 32, 8);
+   MFEM_VERIFY(byte_order == bin_byte_order,
+               "the binary container was written with a different byte order");
+   MFEM_VERIFY(total >= bin_header_size, "invalid MFEM binary container");
+
+   buffer.resize(total);
+   std::memcpy(buffer.data(), header, bin_header_size);
+   in.read(buffer.data() + bin_header_size, total - bin_header_size);
+   MFEM_VERIFY(in, "error reading MFEM binary container");
+   data = buffer.data();
+   size = buffer.size();
+   ParseHeader();
+}
+
+int *BinaryReader::GetInts(const std::string &name, int &count)
+{
+   const Section &sec = Find(name, BinaryWriter::INT);
+   count = (int)sec.count;
+   return reinterpret_cast<int*>(data + sec.offset);
+}
+
+double *BinaryReader::GetDoubles(const std::string &name, int &count)
+{
+   const Section &sec = Find(name, BinaryWriter::DOUBLE);
+   count = (int)sec.count;
+   return reinterpret_cast<double*>(data + sec.offset);
+}
+
+std::string BinaryReader::GetString(const std::string &name) const
+{
+   const Section &sec = Find(name, BinaryWriter::CHAR);
+   return std::string(data + sec.offset, sec.count);
+}
+
 } // namespace mfem
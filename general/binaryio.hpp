@@ -16,6 +16,8 @@
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <map>
 
 namespace mfem
 {
@@ -50,6 +52,118 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t length);
 
 } // namespace mfem::bin_io
 
+
+/** @brief Writer of MFEM's binary container format: a versioned set of named
+    sections of int, double or char data. */
+/** The container starts with the line "MFEM binary v1.0" followed by a table
+    of the sections. The data of every section starts at an offset from the
+    beginning of the container which is a multiple of 64 bytes, so that the
+    sections of a memory-mapped file can be used in place, see BinaryReader.
+    The data is written in the byte order of the machine, which is recorded in
+    the header and checked by the reader.
+
+    The int and double sections are not copied: their data must remain valid
+    until Write() is called. */
+class BinaryWriter
+{
+public:
+   /// Types of the section data.
+   enum Type { INT = 0, DOUBLE = 1, CHAR = 2 };
+
+protected:
+   struct Section
+   {
+      std::string name;
+      int type;
+      const void *data;
+      size_t count;
+      std::string text; // data of the CHAR sections
+   };
+   std::vector<Section> sections;
+
+   void Add(const std::string &name, int type, const void *data,
+            size_t count);
+
+public:
+   /// Add a section of @a count ints.
+   void AddSection(const std::string &name, const int *data, size_t count)
+   { Add(name, INT, data, count); }
+
+   /// Add a section of @a count doubles.
+   void AddSection(const std::string &name, const double *data, size_t count)
+   { Add(name, DOUBLE, data, count); }
+
+   /// Add a section with a copy of the string @a text.
+   void AddSection(const std::string &name, const std::string &text);
+
+   /// Write the container with all sections added so far to @a out.
+   void Write(std::ostream &out) const;
+};
+
+
+/// Reader of MFEM's binary container format, see BinaryWriter.
+/** The container can be read from a stream, which copies it into memory, or
+    memory-mapped from a file with Map(). In the latter case, the file is
+    mapped copy-on-write: the section data can be modified in place without
+    changing the file. In both cases, the pointers returned by GetInts() and
+    GetDoubles() refer to the storage of the reader and are valid while the
+    reader exists. */
+class BinaryReader
+{
+protected:
+   struct Section
+   {
+      int type;
+      size_t offset, count;
+   };
+   std::map<std::string, Section> sections;
+
+   char *data;  // beginning of the container
+   size_t size; // size of the container in bytes
+   std::vector<char> buffer; // storage of a container read from a stream
+   bool mapped;
+
+   void Unmap();
+   void ParseHeader();
+   const Section &Find(const std::string &name, int type) const;
+
+public:
+   /// The first line of the container, which identifies the format.
+   static const char magic[];
+
+   BinaryReader() : data(NULL), size(0), mapped(false) { }
+
+   BinaryReader(const BinaryReader &) = delete;
+   BinaryReader &operator=(const BinaryReader &) = delete;
+
+   ~BinaryReader() { Unmap(); }
+
+   /// Memory-map the container stored in the file @a filename.
+   /** On platforms without mmap(), the file is read into memory instead. */
+   void Map(const std::string &filename);
+
+   /** @brief Read the container from @a in, whose first line (the format
+       identifier #magic) has already been read. */
+   /** The stream is left at the end of the container. */
+   void Read(std::istream &in);
+
+   /// Return true if the container is a memory-mapped file.
+   bool IsMapped() const { return mapped; }
+
+   /// Return true if the container has a section with the given name.
+   bool HasSection(const std::string &name) const
+   { return sections.find(name) != sections.end(); }
+
+   /// Return the data of an int section and set @a count to its size.
+   int *GetInts(const std::string &name, int &count);
+
+   /// Return the data of a double section and set @a count to its size.
+   double *GetDoubles(const std::string &name, int &count);
+
+   /// Return the contents of a char section.
+   std::string GetString(const std::string &name) const;
+};
+
 } // namespace mfem
 
 #endif
@@ -25,6 +25,7 @@
 #include "text.hpp"
 #include "sort_pairs.hpp"
 #include "globals.hpp"
+#include "profiler.hpp"
 
 #include <iostream>
 #include <map>
@@ -837,6 +838,9 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
    // The above also handles the case (group_buf_size == 0).
    MFEM_VERIFY(comm_lock == 1, "object is NOT locked for Bcast");
 
+   // The wait time includes the copies of the data received while waiting
+   MFEM_PROFILE_MPI_WAIT();
+
    switch (mode)
    {
       case byGroup: // ***** Communication by groups *****
@@ -1019,6 +1023,9 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
    // The above also handles the case (group_buf_size == 0).
    MFEM_VERIFY(comm_lock == 2, "object is NOT locked for Reduce");
 
+   // The wait time includes the reductions of the data received while waiting
+   MFEM_PROFILE_MPI_WAIT();
+
    switch (mode)
    {
       case byGroup: // ***** Communication by groups *****
@@ -11,10 +11,15 @@
 
 #include "forall.hpp"
 #include "occa.hpp"
+#include "threads.hpp"
 #ifdef MFEM_USE_CEED
 #include <ceed.h>
 #endif
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 #include <string>
 #include <map>
 
@@ -40,7 +45,8 @@ static const Backend::Id backend_list[Backend::NUM_BACKENDS] =
 {
    Backend::CEED_CUDA, Backend::OCCA_CUDA, Backend::RAJA_CUDA, Backend::CUDA,
    Backend::HIP, Backend::DEBUG,
-   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP,
+   Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP, Backend::THREADS,
+   Backend::SIMD,
    Backend::CEED_CPU, Backend::OCCA_CPU, Backend::RAJA_CPU, Backend::CPU
 };
 
@@ -49,7 +55,7 @@ static const char *backend_name[Backend::NUM_BACKENDS] =
 {
    "ceed-cuda", "occa-cuda", "raja-cuda", "cuda",
    "hip", "debug",
-   "occa-omp", "raja-omp", "omp",
+   "occa-omp", "raja-omp", "omp", "threads", "simd",
    "ceed-cpu", "occa-cpu", "raja-cpu", "cpu"
 };
 
@@ -92,6 +98,12 @@ Device::Device() : mode(Device::SEQUENTIAL),
          host_mem_type = MemoryType::HOST_64;
          device_mem_type = MemoryType::HOST_64;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         device_mem_type = MemoryType::HOST_POOL;
+      }
       else if (mem_backend == "umpire")
       {
          mem_host_env = true;
@@ -247,6 +259,12 @@ void Device::Print(std::ostream &out)
       }
    }
    out << '\n';
+#ifdef MFEM_USE_THREADS
+   if (Allows(Backend::THREADS))
+   {
+      out << "Number of threads: " << ThreadPool::Get().NumThreads() << '\n';
+   }
+#endif
 #ifdef MFEM_USE_CEED
    if (Allows(Backend::CEED_MASK))
    {
@@ -324,6 +342,13 @@ void Device::UpdateMemoryTypeAndClass()
    mm.Configure(host_mem_type, device_mem_type);
 }
 
+void Device::SetHostMemoryType(MemoryType h_mt)
+{
+   MFEM_VERIFY(IsHostMemory(h_mt), "invalid host memory type");
+   Get().host_mem_type = h_mt;
+   mm.Configure(h_mt, Get().device_mem_type);
+}
+
 void Device::Enable()
 {
    const bool accelerated = Get().backends & ~(Backend::CPU);
@@ -429,6 +454,27 @@ static void OccaDeviceSetup(const int dev)
 #endif
 }
 
+static void ThreadsDeviceSetup(const char *option)
+{
+#ifdef MFEM_USE_THREADS
+   // The option is the number of threads, e.g. 'threads:8'.
+   ThreadPool::Get().Setup(option ? atoi(option) : 0);
+#else
+   MFEM_CONTRACT_VAR(option);
+#endif
+}
+
+int Device::NumHostThreads()
+{
+#ifdef MFEM_USE_THREADS
+   if (Allows(Backend::THREADS)) { return ThreadPool::Get().NumThreads(); }
+#endif
+#ifdef MFEM_USE_OPENMP
+   if (Allows(Backend::OMP_MASK)) { return omp_get_max_threads(); }
+#endif
+   return 1;
+}
+
 static void CeedDeviceSetup(const char* ceed_spec)
 {
 #ifdef MFEM_USE_CEED
@@ -469,6 +515,11 @@ void Device::Setup(const int device)
                "the OpenMP and RAJA OpenMP backends require MFEM built with"
                " MFEM_USE_OPENMP=YES");
 #endif
+#ifndef MFEM_USE_THREADS
+   MFEM_VERIFY(!Allows(Backend::THREADS),
+               "the thread pool backend requires MFEM built with"
+               " MFEM_USE_THREADS=YES");
+#endif
 #ifndef MFEM_USE_CEED
    MFEM_VERIFY(!Allows(Backend::CEED_MASK),
                "the CEED backends require MFEM built with MFEM_USE_CEED=YES");
@@ -481,6 +532,7 @@ void Device::Setup(const int device)
    if (Allows(Backend::RAJA_CUDA)) { RajaDeviceSetup(dev, ngpu); }
    // The check for MFEM_USE_OCCA is in the function OccaDeviceSetup().
    if (Allows(Backend::OCCA_MASK)) { OccaDeviceSetup(dev); }
+   if (Allows(Backend::THREADS)) { ThreadsDeviceSetup(device_option); }
    if (Allows(Backend::CEED_CPU))
    {
       if (!device_option)
@@ -65,7 +65,15 @@ struct Backend
           while a device is in use. It allows to test the "device" code-path
           (using separate host/device memory pools and host <-> device
           transfers) without any GPU hardware. */
-      DEBUG = 1 << 12
+      DEBUG = 1 << 12,
+      /** @brief [host] CPU backend with partial assembly kernels vectorized
+          across elements: the elements are processed in batches of
+          SIMD_LANES with lane-interleaved data. Kernels without such a
+          variant use the Backend::CPU implementation. */
+      SIMD = 1 << 13,
+      /** @brief [host] Thread pool backend with work stealing, see class
+          ThreadPool. Enabled when MFEM_USE_THREADS = YES. */
+      THREADS = 1 << 14
    };
 
    /** @brief Additional useful constants. For example, the *_MASK constants can
@@ -73,10 +81,10 @@ struct Backend
    enum
    {
       /// Number of backends: from (1 << 0) to (1 << (NUM_BACKENDS-1)).
-      NUM_BACKENDS = 13,
+      NUM_BACKENDS = 15,
 
       /// Biwise-OR of all CPU backends
-      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU,
+      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU | SIMD,
       /// Biwise-OR of all CUDA backends
       CUDA_MASK = CUDA | RAJA_CUDA | OCCA_CUDA | CEED_CUDA,
       /// Biwise-OR of all HIP backends
@@ -197,7 +205,7 @@ public:
        * The 'cpu' backend is always enabled with lowest priority.
        * The current backend priority from highest to lowest is:
          'ceed-cuda', 'occa-cuda', 'raja-cuda', 'cuda', 'hip', 'debug',
-         'occa-omp', 'raja-omp', 'omp',
+         'occa-omp', 'raja-omp', 'omp', 'threads', 'simd',
          'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu'.
        * Multiple backends can be configured at the same time.
        * Only one 'occa-*' backend can be configured at a time.
@@ -209,6 +217,11 @@ public:
          and evaluation of the operator and enables the 'cuda' backend to avoid
          transfer between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The 'simd' backend is ignored by the kernels when a device backend is
+         also configured.
+       * The number of threads of the 'threads' backend can be given as its
+         option, e.g. 'threads:8'; by default, it is taken from the environment
+         variable MFEM_NUM_THREADS or from the hardware concurrency.
    */
    void Configure(const std::string &device, const int dev = 0);
 
@@ -227,6 +240,11 @@ public:
    /// The opposite of IsEnabled().
    static inline bool IsDisabled() { return !IsEnabled(); }
 
+   /** @brief Return the number of host threads used by the enabled
+       multithreaded host backend (Backend::THREADS or the OpenMP backends),
+       or 1 if no such backend is enabled. */
+   static int NumHostThreads();
+
    /** @brief Return true if any of the backends in the backend mask, @a b_mask,
        are allowed. */
    /** This method can be used with any of the Backend::Id constants, the
@@ -239,6 +257,13 @@ public:
    */
    static inline MemoryType GetHostMemoryType() { return Get().host_mem_type; }
 
+   /** @brief Set the Host MemoryType used for new allocations, e.g.
+       MemoryType::HOST_POOL to use the pooled host allocator. */
+   /** Memory objects allocated before the call keep their MemoryType. The
+       type can also be selected with the environment variable MFEM_MEMORY,
+       e.g. MFEM_MEMORY=pool. */
+   static void SetHostMemoryType(MemoryType h_mt);
+
    /** @brief Get the current Host MemoryClass. This is the MemoryClass used
        by most MFEM host Memory objects. */
    static inline MemoryClass GetHostMemoryClass() { return Get().host_mem_class; }
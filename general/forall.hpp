@@ -19,6 +19,7 @@
 #include "occa.hpp"
 #include "device.hpp"
 #include "mem_manager.hpp"
+#include "threads.hpp"
 #include "../linalg/dtensor.hpp"
 
 #ifdef MFEM_USE_RAJA
@@ -35,6 +36,16 @@ namespace mfem
 const int MAX_D1D = 14;
 const int MAX_Q1D = 14;
 
+// Number of elements in the batches of the Backend::SIMD kernels: the number of
+// double precision lanes of 256-bit (AVX) or 128-bit (SSE2, NEON) vectors. The
+// batch arrays of the 3D kernels do not fit in the L1 cache with 512-bit
+// vectors, so AVX-512 builds also use 4 lanes.
+#if defined(__AVX__)
+const int SIMD_LANES = 4;
+#else
+const int SIMD_LANES = 2;
+#endif
+
 // MFEM pragma macros that can be used inside MFEM_FORALL macros.
 #define MFEM_PRAGMA(X) _Pragma(#X)
 
@@ -167,6 +178,47 @@ void RajaOmpWrap(const int N, HBODY &&h_body)
 #endif
 
 
+/// Thread pool backend
+template <typename HBODY>
+void ThreadsWrap(const int N, HBODY &&h_body)
+{
+#ifdef MFEM_USE_THREADS
+   ThreadPool::Get().Forall(N, h_body);
+#else
+   MFEM_CONTRACT_VAR(N);
+   MFEM_CONTRACT_VAR(h_body);
+   MFEM_ABORT("Threads requested for MFEM but threads are not enabled!");
+#endif
+}
+
+
+/** @brief Call @a body(t) for t = 0,...,nt-1 on the host, using the threads
+    of the enabled multithreaded host backend, if any. */
+/** This is used by host-only setup algorithms, e.g. the products of sparse
+    matrices, where each of the @a nt tasks processes a contiguous range of
+    rows with its own workspace; @a nt is usually Device::NumHostThreads(). */
+template <typename BODY>
+void HostParallelFor(const int nt, BODY &&body)
+{
+#ifdef MFEM_USE_THREADS
+   if (Device::Allows(Backend::THREADS))
+   {
+      ThreadPool::Get().Forall(nt, body);
+      return;
+   }
+#endif
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      #pragma omp parallel for schedule(static,1)
+      for (int t = 0; t < nt; t++) { body(t); }
+      return;
+   }
+#endif
+   for (int t = 0; t < nt; t++) { body(t); }
+}
+
+
 /// RAJA sequential loop backend
 template <typename HBODY>
 void RajaSeqWrap(const int N, HBODY &&h_body)
@@ -365,6 +417,11 @@ inline void ForallWrap(const bool use_dev, const int N,
    if (Device::Allows(Backend::OMP_MASK)) { return OmpWrap(N, h_body); }
 #endif
 
+#ifdef MFEM_USE_THREADS
+   // Handle the thread pool backend
+   if (Device::Allows(Backend::THREADS)) { return ThreadsWrap(N, h_body); }
+#endif
+
 #ifdef MFEM_USE_RAJA
    // Handle all allowed CPU backends except Backend::CPU
    if (Device::Allows(Backend::CPU_MASK & ~Backend::CPU))
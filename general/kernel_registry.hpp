@@ -0,0 +1,91 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_REGISTRY_HPP
+#define MFEM_KERNEL_REGISTRY_HPP
+
+#include "forall.hpp"
+#include <unordered_map>
+
+namespace mfem
+{
+
+/** @brief Table of specialized kernel instances indexed by the number of 1D
+    dofs and 1D quadrature points, (D1D,Q1D).
+
+    The registry complements the hand-written switch tables of the partial
+    assembly dispatchers: it is filled once with the template instances of a
+    kernel for a whole range of (D1D,Q1D) pairs (see KernelRange) and queried
+    in their default branch, before falling back to the non-templated kernel
+    with runtime sizes. The @a Kernel type is a function pointer. */
+template <typename Kernel>
+class KernelRegistry
+{
+private:
+   std::unordered_map<int, Kernel> kernels;
+
+   static int Key(const int D1D, const int Q1D) { return (D1D << 8) | Q1D; }
+
+public:
+   /// Register the @a kernel specialized for the given pair (D1D,Q1D).
+   void Add(const int D1D, const int Q1D, Kernel kernel)
+   { kernels[Key(D1D, Q1D)] = kernel; }
+
+   /// Return the kernel specialized for (D1D,Q1D), or NULL if there is none.
+   Kernel Find(const int D1D, const int Q1D) const
+   {
+      auto it = kernels.find(Key(D1D, Q1D));
+      return (it == kernels.end()) ? nullptr : it->second;
+   }
+
+   /// Return the number of registered kernels.
+   int Size() const { return static_cast<int>(kernels.size()); }
+};
+
+/** @brief Compile-time loop adding the instances K<D1D,Q1D>::Get() of a
+    kernel family to a KernelRegistry.
+
+    The pairs span D1D = D_BEGIN, ..., D_END-1 and, for each D1D, Q1D = D1D,
+    ..., D1D+Q_EXTRA, limited to MAX_Q1D. The class template @a K wraps a
+    kernel template in a static function Get() returning the function pointer
+    of the instance. */
+template <template<int,int> class K, int D_BEGIN, int D_END, int Q_EXTRA,
+          int Q1D = D_BEGIN>
+struct KernelRange
+{
+   template <typename Registry>
+   static void Add(Registry &registry)
+   {
+      registry.Add(D_BEGIN, Q1D, K<D_BEGIN,Q1D>::Get());
+      constexpr bool next_d = (Q1D >= D_BEGIN + Q_EXTRA) || (Q1D >= MAX_Q1D);
+      KernelRange<K, next_d ? D_BEGIN + 1 : D_BEGIN, D_END, Q_EXTRA,
+                  next_d ? D_BEGIN + 1 : Q1D + 1>::Add(registry);
+   }
+};
+
+template <template<int,int> class K, int D_END, int Q_EXTRA, int Q1D>
+struct KernelRange<K, D_END, D_END, Q_EXTRA, Q1D>
+{
+   template <typename Registry>
+   static void Add(Registry &) { }
+};
+
+/** @brief Number of elements processed by a thread block in the 2D shared
+    memory partial assembly kernels, for the given number of 1D quadrature
+    points. */
+constexpr int KernelNBZ(const int Q1D)
+{
+   return Q1D <= 3 ? 16 : Q1D <= 5 ? 8 : Q1D <= 7 ? 4 : 2;
+}
+
+} // namespace mfem
+
+#endif
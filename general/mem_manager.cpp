@@ -16,6 +16,9 @@
 #include <cstring> // std::memcpy, std::memcmp
 #include <unordered_map>
 #include <algorithm> // std::max
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 // Uncomment to try _WIN32 platform
 //#define _WIN32
@@ -68,6 +71,7 @@ MemoryType MemoryManager::GetDualMemoryType_(MemoryType mt)
       case MemoryType::HOST:           return MemoryType::DEVICE;
       case MemoryType::HOST_32:        return MemoryType::DEVICE;
       case MemoryType::HOST_64:        return MemoryType::DEVICE;
+      case MemoryType::HOST_POOL:      return MemoryType::DEVICE;
       case MemoryType::HOST_DEBUG:     return MemoryType::DEVICE_DEBUG;
       case MemoryType::HOST_UMPIRE:    return MemoryType::DEVICE_UMPIRE;
       case MemoryType::MANAGED:        return MemoryType::MANAGED;
@@ -88,6 +92,7 @@ static void MFEM_VERIFY_TYPES(const MemoryType h_mt, const MemoryType d_mt)
       (h_mt == MemoryType::HOST_UMPIRE && d_mt == MemoryType::DEVICE_UMPIRE) ||
       (h_mt == MemoryType::HOST_DEBUG && d_mt == MemoryType::DEVICE_DEBUG) ||
       (h_mt == MemoryType::MANAGED && d_mt == MemoryType::MANAGED) ||
+      (h_mt == MemoryType::HOST_POOL && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_64 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_32 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST && d_mt == MemoryType::DEVICE);
@@ -224,6 +229,204 @@ public:
    { if (mfem_memalign(ptr, 64, bytes) != 0) { throw ::std::bad_alloc(); } }
 };
 
+/** @brief Size-class pool of 64-byte aligned host blocks.
+
+    The requests are rounded up to a power of two between 2^MinClass and
+    2^MaxClass bytes; larger requests are forwarded to the system. Each block
+    starts with a 64-byte header storing its size class, so that Dealloc()
+    does not need a lookup. The free blocks are kept in one list per size
+    class, guarded by a mutex, and in a small per-thread cache which is
+    accessed without locking. The pool is never destroyed, so that memory
+    released during the static destruction is still handled correctly. */
+class HostPool
+{
+public:
+   static constexpr int MinClass = 6, MaxClass = 25;
+   static constexpr int NumClasses = MaxClass - MinClass + 1;
+   static constexpr int CacheSize = 8;
+   static constexpr size_t HeaderSize = 64;
+
+private:
+   struct Header
+   {
+      size_t magic;
+      int size_class; // -1 for blocks allocated directly from the system
+      size_t bytes;   // requested size
+   };
+   static constexpr size_t Magic = 0x6d66656d706f6f6cULL;
+
+   /// Per-thread cache. It is trivially destructible, so that it can still
+   /// be accessed after the destructor of its Flusher was called.
+   struct Cache
+   {
+      void *blocks[NumClasses][CacheSize];
+      int count[NumClasses];
+      bool closed;
+   };
+   static thread_local Cache cache;
+
+   /// Returns the cached blocks of the thread to the shared lists at exit.
+   struct Flusher
+   {
+      bool active = false;
+      ~Flusher() { Get().Flush(cache); cache.closed = true; }
+   };
+   static thread_local Flusher flusher;
+
+   std::mutex mtx;
+   std::vector<void*> lists[NumClasses];
+
+   std::atomic<long> allocations, pool_hits, system_allocations;
+   std::atomic<long> bytes_in_use, peak_bytes_in_use, bytes_cached;
+
+   HostPool() : allocations(0), pool_hits(0), system_allocations(0),
+      bytes_in_use(0), peak_bytes_in_use(0), bytes_cached(0) { }
+
+   static int SizeClass(size_t bytes)
+   {
+      int c = MinClass;
+      while (c <= MaxClass && (size_t(1) << c) < bytes) { c++; }
+      return c - MinClass; // == NumClasses if the request is too large
+   }
+
+   static size_t ClassBytes(int c) { return size_t(1) << (c + MinClass); }
+
+   static Header *GetHeader(void *ptr)
+   { return (Header*)((char*)ptr - HeaderSize); }
+
+   void *SystemAlloc(size_t bytes)
+   {
+      void *block;
+      if (mfem_memalign(&block, 64, HeaderSize + bytes) != 0)
+      {
+         throw ::std::bad_alloc();
+      }
+      system_allocations++;
+      return block;
+   }
+
+   void Flush(Cache &c)
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      for (int i = 0; i < NumClasses; i++)
+      {
+         for (int k = 0; k < c.count[i]; k++)
+         {
+            lists[i].push_back(c.blocks[i][k]);
+         }
+         c.count[i] = 0;
+      }
+   }
+
+   void UpdatePeak(long in_use)
+   {
+      long peak = peak_bytes_in_use.load();
+      while (in_use > peak &&
+             !peak_bytes_in_use.compare_exchange_weak(peak, in_use)) { }
+   }
+
+public:
+   static HostPool &Get()
+   {
+      static HostPool *pool = new HostPool();
+      return *pool;
+   }
+
+   void *Alloc(size_t bytes)
+   {
+      allocations++;
+      UpdatePeak(bytes_in_use += bytes);
+      const int c = SizeClass(bytes);
+      void *block = nullptr;
+      if (c < NumClasses)
+      {
+         if (!cache.closed && cache.count[c] > 0)
+         {
+            block = cache.blocks[c][--cache.count[c]];
+         }
+         else
+         {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!lists[c].empty())
+            {
+               block = lists[c].back();
+               lists[c].pop_back();
+            }
+         }
+         if (block)
+         {
+            pool_hits++;
+            bytes_cached -= ClassBytes(c);
+         }
+         else { block = SystemAlloc(ClassBytes(c)); }
+      }
+      else { block = SystemAlloc(bytes); }
+      Header *h = (Header*)block;
+      h->magic = Magic;
+      h->size_class = (c < NumClasses) ? c : -1;
+      h->bytes = bytes;
+      return (char*)block + HeaderSize;
+   }
+
+   void Dealloc(void *ptr)
+   {
+      if (ptr == nullptr) { return; }
+      Header *h = GetHeader(ptr);
+      MFEM_VERIFY(h->magic == Magic, "The pointer was not allocated by the "
+                  "host memory pool!");
+      const int c = h->size_class;
+      bytes_in_use -= h->bytes;
+      if (c < 0) { std::free(h); return; }
+      bytes_cached += ClassBytes(c);
+      if (!cache.closed && cache.count[c] < CacheSize)
+      {
+         flusher.active = true; // register the flush at the thread exit
+         cache.blocks[c][cache.count[c]++] = h;
+         return;
+      }
+      std::lock_guard<std::mutex> lock(mtx);
+      lists[c].push_back(h);
+   }
+
+   void Release()
+   {
+      if (!cache.closed) { Flush(cache); }
+      std::lock_guard<std::mutex> lock(mtx);
+      for (int i = 0; i < NumClasses; i++)
+      {
+         for (void *block : lists[i])
+         {
+            std::free(block);
+            bytes_cached -= ClassBytes(i);
+         }
+         lists[i].clear();
+         lists[i].shrink_to_fit();
+      }
+   }
+
+   void GetStats(MemoryPoolStats &stats) const
+   {
+      stats.allocations = allocations;
+      stats.pool_hits = pool_hits;
+      stats.system_allocations = system_allocations;
+      stats.bytes_in_use = bytes_in_use;
+      stats.peak_bytes_in_use = peak_bytes_in_use;
+      stats.bytes_cached = bytes_cached;
+   }
+};
+
+thread_local HostPool::Cache HostPool::cache;
+thread_local HostPool::Flusher HostPool::flusher;
+
+/// The pooled host memory space, see MemoryType::HOST_POOL
+class PoolHostMemorySpace : public HostMemorySpace
+{
+public:
+   PoolHostMemorySpace(): HostMemorySpace() { }
+   void Alloc(void **ptr, size_t bytes) { *ptr = HostPool::Get().Alloc(bytes); }
+   void Dealloc(void *ptr) { HostPool::Get().Dealloc(ptr); }
+};
+
 #ifndef _WIN32
 static uintptr_t pagesize = 0;
 static uintptr_t pagemask = 0;
@@ -558,11 +761,12 @@ public:
       }
 
       // Filling the host memory backends
-      // HOST, HOST_32 & HOST_64 are always ready
+      // HOST, HOST_32, HOST_64 & HOST_POOL are always ready
       // MFEM_USE_UMPIRE will set either [No/Umpire] HostMemorySpace
       host[static_cast<int>(MT::HOST)] = new StdHostMemorySpace();
       host[static_cast<int>(MT::HOST_32)] = new Aligned32HostMemorySpace();
       host[static_cast<int>(MT::HOST_64)] = new Aligned64HostMemorySpace();
+      host[static_cast<int>(MT::HOST_POOL)] = new PoolHostMemorySpace();
       // HOST_DEBUG is delayed, as it reroutes signals
       host[static_cast<int>(MT::HOST_DEBUG)] = nullptr;
       host[static_cast<int>(MT::HOST_UMPIRE)] = new UmpireHostMemorySpace();
@@ -702,6 +906,38 @@ void *MemoryManager::Register_(void *ptr, void *h_tmp, size_t bytes,
    return h_ptr;
 }
 
+void *MemoryManager::PoolAlloc_(size_t bytes)
+{
+   return internal::HostPool::Get().Alloc(bytes);
+}
+
+void MemoryManager::PoolDealloc_(void *h_ptr)
+{
+   internal::HostPool::Get().Dealloc(h_ptr);
+}
+
+void MemoryManager::GetHostPoolStats(MemoryPoolStats &stats)
+{
+   internal::HostPool::Get().GetStats(stats);
+}
+
+void MemoryManager::ReleaseHostPool()
+{
+   internal::HostPool::Get().Release();
+}
+
+void MemoryPoolStats::Print(std::ostream &out) const
+{
+   out << "Host memory pool:"
+       << "\n   allocations        = " << allocations
+       << "\n   pool hits          = " << pool_hits
+       << "\n   system allocations = " << system_allocations
+       << "\n   bytes in use       = " << bytes_in_use
+       << "\n   peak bytes in use  = " << peak_bytes_in_use
+       << "\n   bytes cached       = " << bytes_cached
+       << std::endl;
+}
+
 void MemoryManager::Alias_(void *base_h_ptr, size_t offset, size_t bytes,
                            unsigned base_flags, unsigned &flags)
 {
@@ -767,12 +1003,14 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
       case MemoryClass::HOST_32:
       {
          MFEM_VERIFY(h_mt == MemoryType::HOST_32 ||
-                     h_mt == MemoryType::HOST_64,"");
+                     h_mt == MemoryType::HOST_64 ||
+                     h_mt == MemoryType::HOST_POOL,"");
          return true;
       }
       case MemoryClass::HOST_64:
       {
-         MFEM_VERIFY(h_mt == MemoryType::HOST_64,"");
+         MFEM_VERIFY(h_mt == MemoryType::HOST_64 ||
+                     h_mt == MemoryType::HOST_POOL,"");
          return true;
       }
       case MemoryClass::DEVICE:
@@ -1387,7 +1625,8 @@ MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
 
 const char *MemoryTypeName[MemoryTypeSize] =
 {
-   "host-std", "host-32", "host-64", "host-debug", "host-umpire",
+   "host-std", "host-32", "host-64", "host-pool", "host-debug",
+   "host-umpire",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
@@ -14,6 +14,7 @@
 
 #include "globals.hpp"
 #include "error.hpp"
+#include <cstddef> // std::size_t
 #include <cstring> // std::memcpy
 #include <type_traits> // std::is_const
 
@@ -29,6 +30,9 @@ enum class MemoryType
    HOST,           ///< Host memory; using new[] and delete[]
    HOST_32,        ///< Host memory; aligned at 32 bytes
    HOST_64,        ///< Host memory; aligned at 64 bytes
+   HOST_POOL,      /**< Host memory; aligned at 64 bytes, allocated from a
+                        size-class pool with thread-local caches, see
+                        MemoryManager::GetHostPoolStats() */
    HOST_DEBUG,     ///< Host memory; allocated from a "host-debug" pool
    HOST_UMPIRE,    ///< Host memory; using Umpire
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
@@ -56,10 +60,10 @@ extern const char *MemoryTypeName[MemoryTypeSize];
  *  use MemoryClass::DEVICE for their inputs. */
 enum class MemoryClass
 {
-   HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, MANAGED } */
-   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
-   HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
+   HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_POOL,
+                                 HOST_DEBUG, HOST_UMPIRE, MANAGED } */
+   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_POOL, HOST_DEBUG }
+   HOST_64, ///< Memory types: { HOST_64, HOST_POOL, HOST_DEBUG }
    DEVICE,  ///< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, MANAGED }
    MANAGED  ///< Memory types: { MANAGED }
 };
@@ -81,6 +85,27 @@ MemoryType GetMemoryType(MemoryClass mc);
     HOST < HOST_32 < HOST_64 < DEVICE < MANAGED. */
 MemoryClass operator*(MemoryClass mc1, MemoryClass mc2);
 
+/// Usage statistics of the MemoryType::HOST_POOL allocator.
+struct MemoryPoolStats
+{
+   long allocations;        ///< Number of allocations
+   long pool_hits;          ///< Allocations served by a cached block
+   long system_allocations; ///< Blocks allocated from the system
+   long bytes_in_use;       ///< Bytes currently requested by the users
+   long peak_bytes_in_use;  ///< Maximum of bytes_in_use
+   long bytes_cached;       ///< Bytes in free blocks kept by the pool
+
+   /// Print the statistics.
+   void Print(std::ostream &out = mfem::out) const;
+};
+
+#ifdef MFEM_USE_THREADS
+/** @brief When Backend::THREADS is enabled, distribute the pages of a large
+    new host allocation among the threads of the pool, see
+    ThreadPool::FirstTouch(). */
+void ThreadsFirstTouch(void *ptr, std::size_t bytes);
+#endif
+
 /// Class used by MFEM to store pointers to host and/or device memory.
 /** The template class parameter, T, must be a plain-old-data (POD) type.
 
@@ -456,6 +481,10 @@ private: // Static methods used by the Memory<T> class
    static void *Register_(void *ptr, void *h_ptr, size_t bytes, MemoryType mt,
                           bool own, bool alias, unsigned &flags);
 
+   /// Allocate and deallocate unregistered MemoryType::HOST_POOL memory.
+   static void *PoolAlloc_(size_t bytes);
+   static void PoolDealloc_(void *h_ptr);
+
    /// Register an alias. Note: base_h_ptr may be an alias.
    static void Alias_(void *base_h_ptr, size_t offset, size_t bytes,
                       unsigned base_flags, unsigned &flags);
@@ -596,6 +625,14 @@ public:
 
    static MemoryType GetHostMemoryType() { return host_mem_type; }
    static MemoryType GetDeviceMemoryType() { return device_mem_type; }
+
+   /// Return the usage statistics of the MemoryType::HOST_POOL allocator.
+   static void GetHostPoolStats(MemoryPoolStats &stats);
+
+   /** @brief Return the free blocks kept by the MemoryType::HOST_POOL
+       allocator (in the shared lists and in the cache of the calling thread)
+       to the system. */
+   static void ReleaseHostPool();
 };
 
 
@@ -626,7 +663,12 @@ inline void Memory<T>::New(int size)
    flags = OWNS_HOST | VALID_HOST;
    h_mt = MemoryManager::host_mem_type;
    h_ptr = (h_mt == MemoryType::HOST) ? new T[size] :
+           (h_mt == MemoryType::HOST_POOL) ?
+           (T*)MemoryManager::PoolAlloc_(size*sizeof(T)) :
            (T*)MemoryManager::New_(nullptr, size*sizeof(T), h_mt, flags);
+#ifdef MFEM_USE_THREADS
+   if (h_mt == MemoryType::HOST) { ThreadsFirstTouch(h_ptr, size*sizeof(T)); }
+#endif
 }
 
 template <typename T>
@@ -635,10 +677,16 @@ inline void Memory<T>::New(int size, MemoryType mt)
    capacity = size;
    const size_t bytes = size*sizeof(T);
    const bool mt_host = mt == MemoryType::HOST;
-   if (mt_host) { flags = OWNS_HOST | VALID_HOST; }
+   const bool mt_pool = mt == MemoryType::HOST_POOL;
+   if (mt_host || mt_pool) { flags = OWNS_HOST | VALID_HOST; }
    h_mt = IsHostMemory(mt) ? mt : MemoryManager::GetDualMemoryType_(mt);
    T *h_tmp = (h_mt == MemoryType::HOST) ? new T[size] : nullptr;
-   h_ptr = (mt_host) ? h_tmp: (T*)MemoryManager::New_(h_tmp, bytes, mt, flags);
+   h_ptr = (mt_host) ? h_tmp : (mt_pool) ?
+           (T*)MemoryManager::PoolAlloc_(bytes) :
+           (T*)MemoryManager::New_(h_tmp, bytes, mt, flags);
+#ifdef MFEM_USE_THREADS
+   if (mt_host) { ThreadsFirstTouch(h_ptr, bytes); }
+#endif
 }
 
 template <typename T>
@@ -653,6 +701,8 @@ inline void Memory<T>::Wrap(T *ptr, int size, bool own)
    if (own && MemoryManager::Exists())
    { MFEM_VERIFY(h_mt == MemoryManager::GetHostMemoryType_(h_ptr),""); }
 #endif
+   // Wrapped pointers are not allocated by the pool
+   if (h_mt == MemoryType::HOST_POOL) { h_mt = MemoryType::HOST; }
    if (own && h_mt != MemoryType::HOST)
    { MemoryManager::Register_(ptr, ptr, bytes, h_mt, own, false, flags); }
 }
@@ -705,6 +755,12 @@ inline void Memory<T>::Delete()
    const bool mt_host = h_mt == MemoryType::HOST;
    const bool std_delete = !registered && mt_host;
 
+   if (!registered && h_mt == MemoryType::HOST_POOL)
+   {
+      if (flags & OWNS_HOST) { MemoryManager::PoolDealloc_(h_ptr); }
+      return;
+   }
+
    if (std_delete ||
        MemoryManager::Delete_((void*)h_ptr, h_mt, flags) == MemoryType::HOST)
    {
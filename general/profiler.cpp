@@ -0,0 +1,400 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "profiler.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Write the string @a s as a JSON string literal.
+static void PrintJSONString(std::ostream &out, const char *s)
+{
+   out << '"';
+   for (; *s; s++)
+   {
+      if (*s == '"' || *s == '\\') { out << '\\' << *s; }
+      else if ((unsigned char)*s < 0x20) { out << ' '; }
+      else { out << *s; }
+   }
+   out << '"';
+}
+
+} // namespace mfem::internal
+
+Profiler::Profiler()
+   : enabled(false), tracing(false), current(0)
+{
+   Reset();
+}
+
+Profiler &Profiler::Get()
+{
+   static Profiler profiler;
+   return profiler;
+}
+
+void Profiler::Enable(bool enable)
+{
+   if (enable) { owner = std::this_thread::get_id(); }
+   enabled = enable;
+}
+
+void Profiler::Reset()
+{
+   MFEM_VERIFY(current == 0, "cannot reset the profiler with open regions");
+   regions.clear();
+   regions.resize(1);
+   Region &root = regions[0];
+   root.name = "";
+   root.parent = -1;
+   root.depth = 0;
+   root.calls = 0;
+   root.inclusive = root.children_time = 0.0;
+   root.bytes = root.mpi_wait = 0.0;
+   start.clear();
+   open_events.clear();
+   events.clear();
+   origin = Clock::now();
+}
+
+int Profiler::FindChild(const char *name)
+{
+   const std::vector<int> &children = regions[current].children;
+   for (int c : children)
+   {
+      const char *c_name = regions[c].name;
+      if (c_name == name || std::strcmp(c_name, name) == 0) { return c; }
+   }
+   Region r;
+   r.name = name;
+   r.parent = current;
+   r.depth = regions[current].depth + 1;
+   r.calls = 0;
+   r.inclusive = r.children_time = 0.0;
+   r.bytes = r.mpi_wait = 0.0;
+   regions.push_back(r);
+   const int c = (int)regions.size() - 1;
+   regions[current].children.push_back(c);
+   return c;
+}
+
+void Profiler::BeginRegion(const char *name)
+{
+   current = FindChild(name);
+   if (tracing)
+   {
+      Event e;
+      e.region = current;
+      e.duration = 0.0;
+      events.push_back(e);
+      open_events.push_back((int)events.size() - 1);
+   }
+   else
+   {
+      open_events.push_back(-1);
+   }
+   // Read the clock last, so that the bookkeeping is not timed
+   start.push_back(Clock::now());
+}
+
+void Profiler::EndRegion()
+{
+   const Clock::time_point now = Clock::now();
+   // Ignore the End() of regions opened before the profiler was enabled
+   if (current == 0) { return; }
+   const double t = std::chrono::duration<double>(now - start.back()).count();
+   Region &r = regions[current];
+   r.calls++;
+   r.inclusive += t;
+   regions[r.parent].children_time += t;
+   if (open_events.back() >= 0)
+   {
+      Event &e = events[open_events.back()];
+      e.start = std::chrono::duration<double>(start.back() - origin).count();
+      e.duration = t;
+   }
+   open_events.pop_back();
+   start.pop_back();
+   current = r.parent;
+}
+
+std::string Profiler::Path(int r) const
+{
+   std::string path = regions[r].name;
+   for (r = regions[r].parent; r > 0; r = regions[r].parent)
+   {
+      path = std::string(regions[r].name) + '/' + path;
+   }
+   return path;
+}
+
+int Profiler::FindRegion(const std::string &path) const
+{
+   int r = 0;
+   std::string::size_type pos = 0;
+   while (r >= 0 && pos <= path.size())
+   {
+      std::string::size_type end = path.find('/', pos);
+      if (end == std::string::npos) { end = path.size(); }
+      const std::string name = path.substr(pos, end - pos);
+      int child = -1;
+      for (int c : regions[r].children)
+      {
+         if (name == regions[c].name) { child = c; break; }
+      }
+      r = child;
+      pos = end + 1;
+   }
+   return r;
+}
+
+void Profiler::PrintTree(std::ostream &out, int r, double total) const
+{
+   const Region &reg = regions[r];
+   const int indent = 2*(reg.depth - 1);
+   const int width = std::max(48 - indent, (int)std::strlen(reg.name));
+   out << std::string(indent, ' ') << std::left << std::setw(width)
+       << reg.name << std::right
+       << std::setw(9) << reg.calls
+       << std::setw(12) << reg.inclusive
+       << std::setw(12) << reg.Exclusive()
+       << std::setw(8) << std::fixed << std::setprecision(1)
+       << (total > 0.0 ? 100.0*reg.inclusive/total : 0.0)
+       << std::scientific << std::setprecision(3)
+       << std::setw(12) << reg.bytes
+       << std::setw(12) << reg.mpi_wait << '\n';
+   for (int c : reg.children) { PrintTree(out, c, total); }
+}
+
+void Profiler::Print(std::ostream &out) const
+{
+   double total = 0.0;
+   for (int c : regions[0].children) { total += regions[c].inclusive; }
+
+   const std::ios::fmtflags flags = out.flags();
+   const std::streamsize prec = out.precision();
+   out << std::left << std::setw(48) << "Region" << std::right
+       << std::setw(9) << "calls"
+       << std::setw(12) << "incl (s)"
+       << std::setw(12) << "excl (s)"
+       << std::setw(8) << "%"
+       << std::setw(12) << "bytes"
+       << std::setw(12) << "MPI (s)" << '\n';
+   out << std::scientific << std::setprecision(3);
+   for (int c : regions[0].children) { PrintTree(out, c, total); }
+   out.flags(flags);
+   out.precision(prec);
+}
+
+void Profiler::PrintTraceEvents(std::ostream &out, int pid) const
+{
+   const std::ios::fmtflags flags = out.flags();
+   const std::streamsize prec = out.precision();
+   out << std::fixed << std::setprecision(3);
+   for (size_t i = 0; i < events.size(); i++)
+   {
+      const Event &e = events[i];
+      out << (i ? ",\n" : "") << "{\"name\": ";
+      internal::PrintJSONString(out, regions[e.region].name);
+      // The Chrome trace format uses microseconds
+      out << ", \"ph\": \"X\", \"pid\": " << pid << ", \"tid\": 0"
+          << ", \"ts\": " << 1e6*e.start << ", \"dur\": " << 1e6*e.duration
+          << '}';
+   }
+   out.flags(flags);
+   out.precision(prec);
+}
+
+void Profiler::PrintTrace(std::ostream &out, int pid) const
+{
+   out << "{\"traceEvents\": [\n";
+   PrintTraceEvents(out, pid);
+   out << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+}
+
+#ifdef MFEM_USE_MPI
+
+namespace internal
+{
+
+// Gather the strings @a s of all ranks of @a comm on rank 0.
+static std::vector<std::string> GatherStrings(MPI_Comm comm,
+                                              const std::string &s)
+{
+   int rank, size;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &size);
+   int len = (int)s.size();
+   std::vector<int> lens(rank == 0 ? size : 0), displs(lens.size());
+   MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, comm);
+   int total = 0;
+   for (size_t i = 0; i < lens.size(); i++)
+   {
+      displs[i] = total;
+      total += lens[i];
+   }
+   std::vector<char> buf(total);
+   MPI_Gatherv(const_cast<char*>(s.data()), len, MPI_CHAR, buf.data(),
+               lens.data(), displs.data(), MPI_CHAR, 0, comm);
+   std::vector<std::string> strings(lens.size());
+   for (size_t i = 0; i < lens.size(); i++)
+   {
+      strings[i].assign(buf.data() + displs[i], lens[i]);
+   }
+   return strings;
+}
+
+// Minimum, sum and maximum of a quantity over the ranks.
+struct ProfilerStat
+{
+   double min, sum, max;
+
+   void Add(double v, bool first)
+   {
+      if (first) { min = sum = max = v; return; }
+      min = std::min(min, v);
+      sum += v;
+      max = std::max(max, v);
+   }
+};
+
+} // namespace mfem::internal
+
+void Profiler::Print(MPI_Comm comm, std::ostream &out) const
+{
+   // Serialize the regions: one line per region with its path and its data,
+   // in depth-first order.
+   std::ostringstream os;
+   os << std::scientific << std::setprecision(17);
+   std::vector<int> stack(regions[0].children.rbegin(),
+                          regions[0].children.rend());
+   while (!stack.empty())
+   {
+      const int r = stack.back();
+      stack.pop_back();
+      const Region &reg = regions[r];
+      os << Path(r) << '\t' << reg.calls << ' ' << reg.inclusive << ' '
+         << reg.Exclusive() << ' ' << reg.bytes << ' ' << reg.mpi_wait << '\n';
+      stack.insert(stack.end(), reg.children.rbegin(), reg.children.rend());
+   }
+   const std::vector<std::string> all = internal::GatherStrings(comm, os.str());
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+   if (rank != 0) { return; }
+
+   // Merge the regions of all ranks by path, keeping the order in which they
+   // first appear.
+   const int nq = 5;
+   struct Entry
+   {
+      int ranks;
+      internal::ProfilerStat q[5];
+   };
+   std::vector<std::string> paths;
+   std::map<std::string, Entry> entries;
+   for (const std::string &s : all)
+   {
+      std::istringstream is(s);
+      std::string path, data;
+      while (std::getline(is, path, '\t') && std::getline(is, data))
+      {
+         auto it = entries.find(path);
+         const bool first = (it == entries.end());
+         if (first)
+         {
+            paths.push_back(path);
+            it = entries.insert(std::make_pair(path, Entry())).first;
+            it->second.ranks = 0;
+         }
+         Entry &e = it->second;
+         std::istringstream ds(data);
+         for (int i = 0; i < nq; i++)
+         {
+            double v;
+            ds >> v;
+            e.q[i].Add(v, first);
+         }
+         e.ranks++;
+      }
+   }
+
+   const std::ios::fmtflags flags = out.flags();
+   const std::streamsize prec = out.precision();
+   out << "Profile of " << all.size() << " ranks, min/avg/max over the ranks "
+       << "with the region\n";
+   out << std::left << std::setw(48) << "Region" << std::right
+       << std::setw(6) << "ranks"
+       << std::setw(10) << "max calls"
+       << std::setw(30) << "incl (s)"
+       << std::setw(30) << "excl (s)"
+       << std::setw(12) << "avg bytes"
+       << std::setw(30) << "MPI (s)" << '\n';
+   out << std::scientific << std::setprecision(3);
+   for (const std::string &path : paths)
+   {
+      const Entry &e = entries[path];
+      const std::string::size_type slash = path.rfind('/');
+      const int depth = (int)std::count(path.begin(), path.end(), '/');
+      const std::string name = (slash == std::string::npos) ?
+                               path : path.substr(slash + 1);
+      const int width = std::max(48 - 2*depth, (int)name.size());
+      out << std::string(2*depth, ' ') << std::left << std::setw(width)
+          << name << std::right << std::setw(6) << e.ranks
+          << std::setw(10) << (long)e.q[0].max;
+      for (int i = 1; i < nq; i++)
+      {
+         if (i == 3)
+         {
+            out << std::setw(12) << e.q[i].sum/e.ranks;
+            continue;
+         }
+         out << std::setw(10) << e.q[i].min << std::setw(10)
+             << e.q[i].sum/e.ranks << std::setw(10) << e.q[i].max;
+      }
+      out << '\n';
+   }
+   out.flags(flags);
+   out.precision(prec);
+}
+
+void Profiler::PrintTrace(MPI_Comm comm, std::ostream &out) const
+{
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+   std::ostringstream os;
+   PrintTraceEvents(os, rank);
+   const std::vector<std::string> all = internal::GatherStrings(comm, os.str());
+   if (rank != 0) { return; }
+
+   out << "{\"traceEvents\": [\n";
+   bool first = true;
+   for (const std::string &events_r : all)
+   {
+      if (events_r.empty()) { continue; }
+      out << (first ? "" : ",\n") << events_r;
+      first = false;
+   }
+   out << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
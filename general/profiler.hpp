@@ -0,0 +1,229 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PROFILER_HPP
+#define MFEM_PROFILER_HPP
+
+#include "../config/config.hpp"
+#include "globals.hpp"
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Hierarchical profiler of named code regions, see the macros
+    MFEM_PROFILE_REGION, MFEM_PROFILE_BYTES and MFEM_PROFILE_MPI_WAIT. */
+/** The regions form a tree: a region opened while another one is open is
+    recorded as its child, so the same function called from different places
+    appears as different nodes. For each node the profiler accumulates the
+    number of calls, the inclusive time, the exclusive time (the inclusive time
+    minus the time spent in the child regions), the number of bytes moved and
+    the time spent waiting for MPI communication, as reported by the
+    instrumented code.
+
+    Recording is off until Enable() is called. Only the thread that called
+    Enable() records regions; regions opened by other threads, e.g. in the
+    bodies of threaded loops, are ignored. The optional trace keeps one event
+    per region call and can be written in the Chrome trace event format (JSON),
+    readable by chrome://tracing or https://ui.perfetto.dev.
+
+    The library code is instrumented with the MFEM_PROFILE_* macros, which are
+    empty unless MFEM is configured with MFEM_USE_PROFILER=YES. The Profiler
+    class itself is always available, so applications can use it to time
+    their own regions. */
+class Profiler
+{
+public:
+   typedef std::chrono::steady_clock Clock;
+
+   /// Node of the region tree.
+   struct Region
+   {
+      const char *name;  ///< Name, owned by the caller (usually a literal)
+      int parent;        ///< Index of the parent, -1 for the root
+      int depth;         ///< Depth in the tree, 0 for the root
+      std::vector<int> children;
+      long calls;        ///< Number of completed calls
+      double inclusive;  ///< Total time in the region, in seconds
+      double children_time; ///< Total time in the child regions, in seconds
+      double bytes;      ///< Bytes moved, see AddBytes()
+      double mpi_wait;   ///< MPI wait time in seconds, see AddMPIWait()
+
+      /// Time spent in the region itself, in seconds.
+      double Exclusive() const { return inclusive - children_time; }
+   };
+
+   /// Trace event: one call of a region.
+   struct Event
+   {
+      int region;     ///< Index in the region tree
+      double start;   ///< Start time in seconds since Reset()
+      double duration; ///< Duration in seconds
+   };
+
+protected:
+   bool enabled, tracing;
+   std::thread::id owner;
+   std::vector<Region> regions;
+   std::vector<Clock::time_point> start; // start of the open regions
+   std::vector<int> open_events; // trace events of the open regions, or -1
+   std::vector<Event> events;
+   int current;
+   Clock::time_point origin;
+
+   int FindChild(const char *name);
+
+   // Full name of region @a r: the names on the path from the root, separated
+   // by '/'.
+   std::string Path(int r) const;
+
+   void PrintTree(std::ostream &out, int r, double total) const;
+
+   // Write the trace events as a comma-separated list of JSON objects.
+   void PrintTraceEvents(std::ostream &out, int pid) const;
+
+public:
+   Profiler();
+
+   /// Return the global profiler used by the MFEM_PROFILE_* macros.
+   static Profiler &Get();
+
+   /** @brief Start or stop recording. When starting, the calling thread becomes
+       the one whose regions are recorded. */
+   void Enable(bool enable = true);
+   bool IsEnabled() const { return enabled; }
+
+   /// Keep (or stop keeping) one trace event per region call.
+   void EnableTrace(bool trace = true) { tracing = trace; }
+   bool IsTraceEnabled() const { return tracing; }
+
+   /// Discard all recorded data. Must be called with no open regions.
+   void Reset();
+
+   /// Open the region @a name as a child of the current region.
+   /** The string @a name is not copied, it must remain valid until the
+       profiler is reset. */
+   void Begin(const char *name)
+   {
+      if (enabled && std::this_thread::get_id() == owner) { BeginRegion(name); }
+   }
+
+   /// Close the current region, opened with the last Begin().
+   void End()
+   {
+      if (enabled && std::this_thread::get_id() == owner) { EndRegion(); }
+   }
+
+   /// Add @a nbytes to the number of bytes moved by the current region.
+   void AddBytes(double nbytes)
+   {
+      if (enabled && std::this_thread::get_id() == owner)
+      { regions[current].bytes += nbytes; }
+   }
+
+   /// Add @a seconds to the MPI wait time of the current region.
+   void AddMPIWait(double seconds)
+   {
+      if (enabled && std::this_thread::get_id() == owner)
+      { regions[current].mpi_wait += seconds; }
+   }
+
+   void BeginRegion(const char *name);
+   void EndRegion();
+
+   /// Return the region tree; the entry 0 is the root, which is never timed.
+   const std::vector<Region> &GetRegions() const { return regions; }
+
+   /// Return the index of the region with the given @a path, or -1.
+   /** The @a path contains the names of the nested regions separated by '/',
+       e.g. "BilinearForm::Assemble/PABilinearFormExtension::Assemble". */
+   int FindRegion(const std::string &path) const;
+
+   /// Return the recorded trace events.
+   const std::vector<Event> &GetEvents() const { return events; }
+
+   /// Print the region tree with the times, call counts, bytes and MPI waits.
+   void Print(std::ostream &out = mfem::out) const;
+
+   /** @brief Write the trace events in the Chrome trace event format (JSON),
+       as process @a pid. */
+   void PrintTrace(std::ostream &out, int pid = 0) const;
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print the minimum, average and maximum over the ranks of @a comm
+       of the data of each region, identified by its path. Collective; the
+       output is written by rank 0. */
+   void Print(MPI_Comm comm, std::ostream &out = mfem::out) const;
+
+   /** @brief Write the trace events of all ranks of @a comm in the Chrome trace
+       event format (JSON), using the ranks as process ids. Collective; the
+       output is written by rank 0. */
+   void PrintTrace(MPI_Comm comm, std::ostream &out) const;
+#endif
+};
+
+
+/// Scoped profiler region: Begin() in the constructor and End() in the
+/// destructor.
+class ProfilerRegion
+{
+public:
+   explicit ProfilerRegion(const char *name) { Profiler::Get().Begin(name); }
+   ~ProfilerRegion() { Profiler::Get().End(); }
+};
+
+
+/// Scoped MPI wait: adds its lifetime to the MPI wait time of the current
+/// region.
+class ProfilerMPIWait
+{
+protected:
+   Profiler::Clock::time_point start;
+
+public:
+   ProfilerMPIWait() : start(Profiler::Clock::now()) { }
+   ~ProfilerMPIWait()
+   {
+      std::chrono::duration<double> t = Profiler::Clock::now() - start;
+      Profiler::Get().AddMPIWait(t.count());
+   }
+};
+
+} // namespace mfem
+
+#define MFEM_PROFILE_CONCAT_(a,b) a##b
+#define MFEM_PROFILE_CONCAT(a,b) MFEM_PROFILE_CONCAT_(a,b)
+
+#ifdef MFEM_USE_PROFILER
+/// Record the rest of the enclosing scope as the profiler region @a name.
+#define MFEM_PROFILE_REGION(name) \
+   mfem::ProfilerRegion MFEM_PROFILE_CONCAT(mfem_profile_region_,__LINE__)(name)
+/// Add @a nbytes to the bytes moved by the current profiler region.
+#define MFEM_PROFILE_BYTES(nbytes) mfem::Profiler::Get().AddBytes(nbytes)
+/// Record the rest of the enclosing scope as MPI wait time.
+#define MFEM_PROFILE_MPI_WAIT() \
+   mfem::ProfilerMPIWait MFEM_PROFILE_CONCAT(mfem_profile_wait_,__LINE__)
+#else
+#define MFEM_PROFILE_REGION(name)
+#define MFEM_PROFILE_BYTES(nbytes)
+#define MFEM_PROFILE_MPI_WAIT()
+#endif
+
+#endif // MFEM_PROFILER_HPP
@@ -0,0 +1,233 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "threads.hpp"
+
+#ifdef MFEM_USE_THREADS
+
+#include "device.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Set while the calling thread executes the body of a ThreadPool loop.
+static thread_local bool threads_in_loop = false;
+
+// Number of polls of a worker waiting for the next loop before it blocks.
+static const int threads_spin_count = 4096;
+
+// Number of chunks per thread range in the loops with work stealing.
+static const int threads_chunks_per_range = 8;
+
+// Granularity of ThreadPool::FirstTouch().
+static const std::size_t threads_page_size = 4096;
+
+// Minimum size of the host allocations touched by ThreadsFirstTouch().
+static const std::size_t threads_first_touch_bytes = 1 << 20;
+
+static inline void ThreadsRelax(const int spins)
+{
+#if defined(__x86_64__) || defined(__i386__)
+   if (spins < threads_spin_count/4) { __builtin_ia32_pause(); return; }
+#endif
+   MFEM_CONTRACT_VAR(spins);
+   std::this_thread::yield();
+}
+
+} // namespace mfem::internal
+
+ThreadPool::ThreadPool()
+   : num_threads(1), ranges(1), body(nullptr), ctx(nullptr), chunk(1),
+     steal(true), generation(0), pending(0), shutdown(false) { }
+
+ThreadPool::~ThreadPool() { Finalize(); }
+
+ThreadPool &ThreadPool::Get()
+{
+   static ThreadPool pool;
+   return pool;
+}
+
+bool ThreadPool::InLoop() { return internal::threads_in_loop; }
+
+void ThreadPool::Setup(int nthreads)
+{
+   MFEM_VERIFY(!InLoop(), "cannot restart the thread pool from a loop body");
+   if (nthreads <= 0)
+   {
+      const char *env = getenv("MFEM_NUM_THREADS");
+      nthreads = env ? atoi(env) : (int) std::thread::hardware_concurrency();
+      nthreads = std::max(nthreads, 1);
+   }
+   if (nthreads == num_threads) { return; }
+   Finalize();
+
+   num_threads = nthreads;
+   std::vector<Range>(num_threads).swap(ranges);
+   for (int t = 0; t < num_threads; t++)
+   {
+      ranges[t].next = 0;
+      ranges[t].end = 0;
+   }
+   // The workers may start after the first loop has been launched: they are
+   // given the current generation, instead of reading it themselves.
+   const unsigned gen = generation.load(std::memory_order_relaxed);
+   workers.reserve(num_threads - 1);
+   for (int t = 1; t < num_threads; t++)
+   {
+      workers.emplace_back(&ThreadPool::WorkerLoop, this, t, gen);
+   }
+}
+
+void ThreadPool::Finalize()
+{
+   if (workers.size() > 0)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         shutdown = true;
+         generation.fetch_add(1, std::memory_order_release);
+      }
+      wake.notify_all();
+      for (std::thread &worker : workers) { worker.join(); }
+      workers.clear();
+      shutdown = false;
+   }
+   num_threads = 1;
+}
+
+void ThreadPool::WorkerLoop(const int tid, unsigned seen)
+{
+   while (true)
+   {
+      // Poll for the next loop, then block until it is started
+      unsigned gen = generation.load(std::memory_order_acquire);
+      for (int spins = 0; gen == seen && spins < internal::threads_spin_count;
+           spins++)
+      {
+         internal::ThreadsRelax(spins);
+         gen = generation.load(std::memory_order_acquire);
+      }
+      if (gen == seen)
+      {
+         std::unique_lock<std::mutex> lock(mtx);
+         wake.wait(lock, [&]
+         { return generation.load(std::memory_order_relaxed) != seen; });
+         gen = generation.load(std::memory_order_relaxed);
+      }
+      seen = gen;
+      if (shutdown) { return; }
+      internal::threads_in_loop = true;
+      Work(tid);
+      internal::threads_in_loop = false;
+      pending.fetch_sub(1, std::memory_order_release);
+   }
+}
+
+void ThreadPool::Work(const int tid)
+{
+   const int nranges = steal ? num_threads : 1;
+   for (int k = 0; k < nranges; k++)
+   {
+      Range &range = ranges[(tid + k) % num_threads];
+      while (true)
+      {
+         const int begin = range.next.fetch_add(chunk,
+                                                std::memory_order_relaxed);
+         if (begin >= range.end) { break; }
+         body(ctx, begin, std::min(begin + chunk, range.end));
+      }
+   }
+}
+
+void ThreadPool::Run(const int N, RangeBody loop_body, void *loop_ctx,
+                     const bool loop_steal)
+{
+   if (N <= 0) { return; }
+   if (num_threads == 1 || N == 1 || InLoop())
+   {
+      loop_body(loop_ctx, 0, N);
+      return;
+   }
+   std::lock_guard<std::mutex> run_lock(run_mtx);
+
+   const int T = num_threads;
+   body = loop_body;
+   ctx = loop_ctx;
+   steal = loop_steal;
+   chunk = steal ? std::max(1, N/(T*internal::threads_chunks_per_range)) : N;
+   for (int t = 0; t < T; t++)
+   {
+      const int begin = (int)(((std::int64_t) t*N)/T);
+      ranges[t].end = (int)(((std::int64_t)(t + 1)*N)/T);
+      ranges[t].next.store(begin, std::memory_order_relaxed);
+   }
+   pending.store(T - 1, std::memory_order_relaxed);
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      generation.fetch_add(1, std::memory_order_release);
+   }
+   wake.notify_all();
+
+   internal::threads_in_loop = true;
+   Work(0);
+   internal::threads_in_loop = false;
+   for (int spins = 0; pending.load(std::memory_order_acquire) > 0; spins++)
+   {
+      internal::ThreadsRelax(spins);
+   }
+}
+
+void ThreadPool::FirstTouch(void *ptr, const std::size_t bytes)
+{
+   if (num_threads == 1 || InLoop()) { return; }
+   const std::size_t page = internal::threads_page_size;
+   // Touch only the pages starting inside the buffer: the first partial page
+   // may be shared with another allocation.
+   char *base = static_cast<char*>(ptr);
+   const std::size_t offset =
+      (page - reinterpret_cast<std::uintptr_t>(base) % page) % page;
+   if (offset >= bytes) { return; }
+   struct Pages
+   {
+      char *first;
+      static void Touch(void *ctx, int begin, int end)
+      {
+         char *first = static_cast<Pages*>(ctx)->first;
+         for (int p = begin; p < end; p++)
+         {
+            volatile char *c = first + p*internal::threads_page_size;
+            *c = *c;
+         }
+      }
+   } pages = { base + offset };
+   const int npages = (int)((bytes - offset + page - 1)/page);
+   Run(npages, Pages::Touch, &pages, false);
+}
+
+void ThreadsFirstTouch(void *ptr, const std::size_t bytes)
+{
+   if (bytes < internal::threads_first_touch_bytes) { return; }
+   if (!Device::Allows(Backend::THREADS)) { return; }
+   ThreadPool::Get().FirstTouch(ptr, bytes);
+}
+
+} // namespace mfem
+
+#endif // MFEM_USE_THREADS
@@ -0,0 +1,148 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_THREADS_HPP
+#define MFEM_THREADS_HPP
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_THREADS
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Persistent pool of host threads used by Backend::THREADS to execute
+    the MFEM_FORALL loops. */
+/** The worker threads are created once, in Setup(), and live until Finalize()
+    or the end of the program. A loop over [0,N) is split into one contiguous
+    range per thread, proportional to the thread index, as with a static
+    schedule. Each thread processes its own range in chunks and, once it is
+    exhausted, steals the remaining chunks of the other ranges. This balances
+    loops with an uneven cost per index, e.g. element kernels on meshes with
+    mixed orders or local refinement, while keeping the owner-computes data
+    placement of FirstTouch() for the balanced ones.
+
+    The calling thread takes part in the execution as thread 0. After a loop
+    the workers keep spinning for a short while before blocking, so that the
+    consecutive loops of an operator evaluation (restriction, element kernel,
+    transposed restriction) are started without waking up sleeping threads.
+
+    Loops started from inside a loop body are executed sequentially by the
+    calling thread. */
+class ThreadPool
+{
+public:
+   /// Type-erased loop body: process the indices [begin,end).
+   typedef void (*RangeBody)(void *ctx, int begin, int end);
+
+private:
+   // Index range of a thread, padded to avoid false sharing
+   struct Range
+   {
+      std::atomic<int> next;
+      int end;
+      char pad[64 - sizeof(std::atomic<int>) - sizeof(int)];
+   };
+
+   int num_threads;
+   std::vector<std::thread> workers;
+   std::vector<Range> ranges;
+
+   // Description of the current loop
+   RangeBody body;
+   void *ctx;
+   int chunk;
+   bool steal;
+
+   std::mutex mtx;
+   std::condition_variable wake;
+   std::atomic<unsigned> generation;
+   std::atomic<int> pending;
+   bool shutdown;
+
+   /// Serializes the loops started by different user threads.
+   std::mutex run_mtx;
+
+   ThreadPool();
+   ThreadPool(const ThreadPool&) = delete;
+   void operator=(const ThreadPool&) = delete;
+
+   void WorkerLoop(const int tid, unsigned seen);
+   void Work(const int tid);
+
+public:
+   ~ThreadPool();
+
+   /// Return the global pool.
+   static ThreadPool &Get();
+
+   /** @brief Start the pool with @a nthreads threads, including the calling
+       thread. */
+   /** If @a nthreads <= 0, the number of threads is taken from the environment
+       variable MFEM_NUM_THREADS, if set, or from the hardware concurrency. A
+       running pool is restarted if the number of threads changes. */
+   void Setup(int nthreads = 0);
+
+   /// Stop and join the worker threads.
+   void Finalize();
+
+   /// Return the number of threads, including the calling thread.
+   int NumThreads() const { return num_threads; }
+
+   /// Return true if the calling thread is executing a loop of the pool.
+   static bool InLoop();
+
+   /** @brief Execute @a body over the index range [0,N) with all threads. The
+       call returns when all indices have been processed. */
+   /** With @a steal = false, thread t only processes the t-th contiguous
+       range, which gives a reproducible assignment of the indices to the
+       threads. */
+   void Run(const int N, RangeBody body, void *ctx, const bool steal = true);
+
+   /// Execute @a body(i) for i in [0,N), see Run().
+   template <typename BODY>
+   void Forall(const int N, BODY &&body)
+   {
+      typedef typename std::remove_reference<BODY>::type body_t;
+      struct Trampoline
+      {
+         static void Apply(void *ctx, int begin, int end)
+         {
+            body_t &f = *static_cast<body_t*>(ctx);
+            for (int i = begin; i < end; i++) { f(i); }
+         }
+      };
+      Run(N, Trampoline::Apply,
+          const_cast<void*>(static_cast<const void*>(&body)));
+   }
+
+   /** @brief Write to the pages of the host buffer [ptr,ptr+bytes) with the
+       threads of the pool, preserving their content. */
+   /** On first-touch NUMA systems, the physical pages are allocated close to
+       the thread that first writes them. The pages are touched with the same
+       static partition that is used by Run(), so that a MFEM_FORALL loop over
+       the entries of the buffer mostly accesses local memory. */
+   void FirstTouch(void *ptr, const std::size_t bytes);
+};
+
+} // namespace mfem
+
+#endif // MFEM_USE_THREADS
+
+#endif
@@ -38,7 +38,9 @@ protected:
       RectangularConstrainedOperator* &Aout);
 
    /// Returns RAP Operator of this, taking in input/output Prolongation matrices
-   Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+   /** Derived classes can override this method to use a specialized
+       implementation of the triple product, which is owned by the caller. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
 
 public:
    /// Initializes memory for true vectors of linear system
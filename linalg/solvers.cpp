@@ -34,6 +34,7 @@ IterativeSolver::IterativeSolver()
    rel_tol = abs_tol = 0.0;
 #ifdef MFEM_USE_MPI
    dot_prod_type = 0;
+   dot_request = MPI_REQUEST_NULL;
 #endif
 }
 
@@ -48,6 +49,7 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
    rel_tol = abs_tol = 0.0;
    dot_prod_type = 1;
    comm = _comm;
+   dot_request = MPI_REQUEST_NULL;
 }
 #endif
 
@@ -67,6 +69,91 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::Dots(int n, const Vector *const *x,
+                           const Vector *const *y, double *res) const
+{
+   StartDots(n, x, y, res);
+   WaitDots();
+}
+
+void IterativeSolver::StartDots(int n, const Vector *const *x,
+                                const Vector *const *y, double *res) const
+{
+   for (int i = 0; i < n; i++)
+   {
+      res[i] = (*x[i]) * (*y[i]);
+   }
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type == 1)
+   {
+      MFEM_VERIFY(dot_request == MPI_REQUEST_NULL,
+                  "a reduction is already pending");
+#if MPI_VERSION >= 3
+      MPI_Iallreduce(MPI_IN_PLACE, res, n, MPI_DOUBLE, MPI_SUM, comm,
+                     &dot_request);
+#else
+      MPI_Allreduce(MPI_IN_PLACE, res, n, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+   }
+#endif
+}
+
+void IterativeSolver::WaitDots() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_request != MPI_REQUEST_NULL)
+   {
+      MPI_Wait(&dot_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+double IterativeSolver::GramSchmidt(int k, const Array<Vector *> &v,
+                                    Vector &w, double *h, bool cgs2) const
+{
+   if (!cgs2)
+   {
+      for (int i = 0; i <= k; i++)
+      {
+         h[i] = Dot(w, *v[i]);  // h[i] = w * v[i]
+         w.Add(-h[i], *v[i]);   // w -= h[i] * v[i]
+      }
+      return Norm(w);
+   }
+
+   // First pass: h = V^t w, w -= V h
+   Array<const Vector *> x(k+2), y(k+2);
+   for (int i = 0; i <= k; i++)
+   {
+      x[i] = v[i];
+      y[i] = &w;
+   }
+   Dots(k+1, x, y, h);
+   for (int i = 0; i <= k; i++)
+   {
+      w.Add(-h[i], *v[i]);
+   }
+
+   // Second pass, fused with the inner product (w, w) of the first pass: the
+   // norm of the result follows from the Pythagorean theorem.
+   Vector c(k+2);
+   x[k+1] = y[k+1] = &w;
+   Dots(k+2, x, y, c.GetData());
+   double nrm2 = c(k+1);
+   for (int i = 0; i <= k; i++)
+   {
+      w.Add(-c(i), *v[i]);
+      h[i] += c(i);
+      nrm2 -= c(i)*c(i);
+   }
+   if (nrm2 <= 1e-4*c(k+1))
+   {
+      // Cancellation: compute the norm explicitly
+      nrm2 = Dot(w, w);
+   }
+   return sqrt(std::max(nrm2, 0.0));
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -535,6 +622,166 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    final_norm = sqrt(betanom);
 }
 
+void PipelinedCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   u.SetSize(width);
+   w.SetSize(width);
+   m.SetSize(width);
+   n.SetSize(width);
+   z.SetSize(width);
+   q.SetSize(width);
+   s.SetSize(width);
+   p.SetSize(width);
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Preconditioned pipelined CG, following Algorithm 3 in P. Ghysels and
+   // W. Vanroose, "Hiding global synchronization latency in the preconditioned
+   // Conjugate Gradient algorithm", Parallel Computing 40 (2014).
+   double r0 = 0.0, nom0 = 0.0, gamma = 0.0, gamma_old = 0.0, alpha = 0.0;
+   double dots[2];
+   const Vector *dx[2] = { &r, &w }, *dy[2] = { &u, &u };
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   else
+   {
+      u = r;
+   }
+   oper->Mult(u, w);    // w = A u
+
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; i++)
+   {
+      // gamma = (B r, r), delta = (A u, u), overlapped with m = B w, n = A m
+      StartDots(2, dx, dy, dots);
+      if (prec)
+      {
+         prec->Mult(w, m);
+      }
+      else
+      {
+         m = w;
+      }
+      oper->Mult(m, n);
+      WaitDots();
+      gamma = dots[0];
+      const double delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma) && IsFinite(delta),
+                  "gamma = " << gamma << ", delta = " << delta);
+
+      if (print_level == 1 || (print_level == 3 && i == 0))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << (print_level == 3 ? " ...\n" : "\n");
+      }
+      if (gamma < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. "
+                      "(Br, r) = " << gamma << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (gamma <= r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << gamma << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i == max_iter)
+      {
+         break;
+      }
+
+      const double beta = (i > 0) ? gamma/gamma_old : 0.0;
+      const double den = (i > 0) ? delta - beta*gamma/alpha : delta;
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The operator is not positive definite. "
+                      "(Au, u) - beta (Br, r) / alpha = " << den << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      alpha = gamma/den;
+
+      if (i > 0)
+      {
+         add(n, beta, z, z); //  z = n + beta z
+         add(m, beta, q, q); //  q = m + beta q
+         add(w, beta, s, s); //  s = w + beta s
+         add(u, beta, p, p); //  p = u + beta p
+      }
+      else
+      {
+         z = n;
+         q = m;
+         s = w;
+         p = u;
+      }
+      x.Add(alpha, p);      //  x = x + alpha p
+      r.Add(-alpha, s);     //  r = r - alpha s
+      u.Add(-alpha, q);     //  u = u - alpha q
+      w.Add(-alpha, z);     //  w = w - alpha z
+      gamma_old = gamma;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter
+                   << "  (B r, r) = " << gamma << '\n';
+      }
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+   if (final_iter > 0 &&
+       (print_level >= 1 || (print_level >= 0 && !converged)))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(std::max(gamma, 0.0));
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
@@ -700,13 +947,8 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
             oper->Mult(*v[i], w);
          }
 
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
-         }
-
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+         // H(k,i) = w * v[k], w -= H(k,i) * v[k], H(i+1,i) = ||w||
+         H(i+1,i) = GramSchmidt(i, v, w, &H(0,i), ortho == CGS2);
          MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
          if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
          v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
@@ -864,13 +1106,8 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
          }
          oper->Mult(*z[i], r);
 
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
-         }
-
-         H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
+         // H(k,i) = r * v[k], r -= H(k,i) * v[k], H(i+1,i) = ||r||
+         H(i+1,i) = GramSchmidt(i, v, r, &H(0,i), ortho == GMRESSolver::CGS2);
          if (v[i+1] == NULL) { v[i+1] = new Vector(b.Size()); }
          (*v[i+1]) = 0.0;
          v[i+1] -> Add (1.0/H(i+1,i), r); // v[i+1] = r / H(i+1,i)
@@ -2033,6 +2270,7 @@ void BlockILU::SetOperator(const Operator &op)
    MFEM_ASSERT(A->Finalized(), "Matrix must be finalized.");
    CreateBlockPattern(*A);
    Factorize();
+   ComputeLevels();
 }
 
 void BlockILU::CreateBlockPattern(const SparseMatrix &A)
@@ -2239,53 +2477,137 @@ void BlockILU::Factorize()
    }
 }
 
+// Group the rows of a triangular solve in levels, given the level of each row,
+// and return them in the table 'levels'.
+static void MakeLevelTable(const Array<int> &level, Table &levels)
+{
+   const int nlevels = level.Size() ? level.Max() + 1 : 0;
+   levels.MakeI(nlevels);
+   for (int i = 0; i < level.Size(); i++)
+   {
+      levels.AddAColumnInRow(level[i]);
+   }
+   levels.MakeJ();
+   for (int i = 0; i < level.Size(); i++)
+   {
+      levels.AddConnection(level[i], i);
+   }
+   levels.ShiftUpI();
+}
+
+void BlockILU::ComputeLevels()
+{
+   const int nblockrows = Height()/block_size;
+   Array<int> level(nblockrows);
+
+   // The L factor is strictly block lower triangular: the levels of the rows it
+   // depends on are known when processing the rows in increasing order.
+   for (int i = 0; i < nblockrows; ++i)
+   {
+      level[i] = 0;
+      for (int k = IB[i]; k < ID[i]; ++k)
+      {
+         level[i] = std::max(level[i], level[JB[k]] + 1);
+      }
+   }
+   MakeLevelTable(level, fwd_levels);
+
+   for (int i = nblockrows-1; i >= 0; --i)
+   {
+      level[i] = 0;
+      for (int k = ID[i]+1; k < IB[i+1]; ++k)
+      {
+         level[i] = std::max(level[i], level[JB[k]] + 1);
+      }
+   }
+   MakeLevelTable(level, bwd_levels);
+}
+
+// Minimum number of block rows per task in the level-scheduled substitutions
+// of BlockILU.
+static const int BLOCK_ILU_MIN_ROWS_PER_TASK = 64;
+
+// Call body(i) for the rows i of the given level, in parallel with the host
+// threads when the level is large enough.
+template <typename BODY>
+static void ForallInLevel(const Table &levels, const int l, BODY &&body)
+{
+   const int *rows = levels.GetRow(l);
+   const int nrows = levels.RowSize(l);
+   const int nt = std::max(1, std::min(Device::NumHostThreads(),
+                                       nrows/BLOCK_ILU_MIN_ROWS_PER_TASK));
+   HostParallelFor(nt, [&](int t)
+   {
+      const int begin = (int)((long long)t*nrows/nt);
+      const int end = (int)((long long)(t+1)*nrows/nt);
+      for (int r = begin; r < end; r++) { body(rows[r]); }
+   });
+}
+
 void BlockILU::Mult(const Vector &b, Vector &x) const
 {
    MFEM_ASSERT(height > 0, "BlockILU(0) preconditioner is not constructed");
-   int nblockrows = Height()/block_size;
+   const int bs = block_size;
    y.SetSize(Height());
 
-   DenseMatrix B;
-   Vector yi, yj, xi, xj;
-   Vector tmp(block_size);
+   const double *d_b = b.HostRead();
+   double *d_y = y.HostWrite();
+   double *d_x = x.HostWrite();
+   const double *d_AB = AB.Data();
+
    // Forward substitute to solve Ly = b
    // Implicitly, L has identity on the diagonal
-   y = 0.0;
-   for (int i=0; i<nblockrows; ++i)
+   for (int l = 0; l < fwd_levels.Size(); ++l)
    {
-      yi.SetDataAndSize(&y[i*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
-      {
-         yi[ib] = b[ib + P[i]*block_size];
-      }
-      for (int k=IB[i]; k<ID[i]; ++k)
+      ForallInLevel(fwd_levels, l, [&](int i)
       {
-         int j = JB[k];
-         const DenseMatrix &L_ij = AB(k);
-         yj.SetDataAndSize(&y[j*block_size], block_size);
-         // y_i = y_i - L_ij*y_j
-         L_ij.AddMult_a(-1.0, yj, yi);
-      }
+         double *yi = d_y + i*bs;
+         for (int ib=0; ib<bs; ++ib)
+         {
+            yi[ib] = d_b[ib + P[i]*bs];
+         }
+         for (int k=IB[i]; k<ID[i]; ++k)
+         {
+            // y_i = y_i - L_ij*y_j
+            const double *L_ij = d_AB + k*bs*bs;
+            const double *yj = d_y + JB[k]*bs;
+            for (int jb=0; jb<bs; ++jb)
+            {
+               for (int ib=0; ib<bs; ++ib)
+               {
+                  yi[ib] -= L_ij[ib + jb*bs]*yj[jb];
+               }
+            }
+         }
+      });
    }
    // Backward substitution to solve Ux = y
-   for (int i=nblockrows-1; i >= 0; --i)
+   for (int l = 0; l < bwd_levels.Size(); ++l)
    {
-      xi.SetDataAndSize(&x[P[i]*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+      ForallInLevel(bwd_levels, l, [&](int i)
       {
-         xi[ib] = y[ib + i*block_size];
-      }
-      for (int k=ID[i]+1; k<IB[i+1]; ++k)
-      {
-         int j = JB[k];
-         const DenseMatrix &U_ij = AB(k);
-         xj.SetDataAndSize(&x[P[j]*block_size], block_size);
-         // x_i = x_i - U_ij*x_j
-         U_ij.AddMult_a(-1.0, xj, xi);
-      }
-      LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
-      // x_i = D_ii^{-1} x_i
-      A_ii_inv.Solve(block_size, 1, xi);
+         double *xi = d_x + P[i]*bs;
+         for (int ib=0; ib<bs; ++ib)
+         {
+            xi[ib] = d_y[ib + i*bs];
+         }
+         for (int k=ID[i]+1; k<IB[i+1]; ++k)
+         {
+            // x_i = x_i - U_ij*x_j
+            const double *U_ij = d_AB + k*bs*bs;
+            const double *xj = d_x + P[JB[k]]*bs;
+            for (int jb=0; jb<bs; ++jb)
+            {
+               for (int ib=0; ib<bs; ++ib)
+               {
+                  xi[ib] -= U_ij[ib + jb*bs]*xj[jb];
+               }
+            }
+         }
+         LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*bs]);
+         // x_i = D_ii^{-1} x_i
+         A_ii_inv.Solve(bs, 1, xi);
+      });
    }
 }
 
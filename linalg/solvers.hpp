@@ -37,6 +37,8 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   /// Pending non-blocking reduction started by StartDots().
+   mutable MPI_Request dot_request;
 #endif
 
 protected:
@@ -53,6 +55,31 @@ protected:
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /** @brief Compute the @a n inner products (@a x[i], @a y[i]) with a single
+       global reduction. */
+   void Dots(int n, const Vector *const *x, const Vector *const *y,
+             double *res) const;
+
+   /** @brief Start the computation of the @a n inner products (@a x[i],
+       @a y[i]) with a non-blocking global reduction. */
+   /** The results in @a res are available after WaitDots() is called. Only
+       one reduction can be pending at a time. Without MPI, or with a local
+       inner product, the results are computed by this call. */
+   void StartDots(int n, const Vector *const *x, const Vector *const *y,
+                  double *res) const;
+
+   /// Complete the reduction started by StartDots().
+   void WaitDots() const;
+
+   /** @brief Orthogonalize @a w against the orthonormal vectors v[0],...,v[k]
+       with modified Gram-Schmidt or, if @a cgs2 is true, classical
+       Gram-Schmidt with one reorthogonalization (CGS2). */
+   /** The coefficients are returned in h[0],...,h[k] and the return value is
+       the norm of the orthogonalized @a w, which is not normalized. CGS2 uses
+       two global reductions, independently of @a k, instead of k+2. */
+   double GramSchmidt(int k, const Array<Vector *> &v, Vector &w, double *h,
+                      bool cgs2) const;
+
 public:
    IterativeSolver();
 
@@ -169,6 +196,34 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// Pipelined conjugate gradient method
+/** This variant of the (preconditioned) conjugate gradient method, due to
+    Ghysels and Vanroose, computes the two inner products of each iteration
+    with a single non-blocking global reduction which is overlapped with the
+    application of the preconditioner and of the operator. It uses more vectors
+    and more vector updates than CGSolver, and can be less stable, but it
+    hides the latency of the reductions when they dominate the solve time. The
+    stopping criterion is the same as in CGSolver. */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, z, q, s, p;
+
+   void UpdateVectors();
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -183,19 +238,35 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 /// GMRES method
 class GMRESSolver : public IterativeSolver
 {
+public:
+   /// Orthogonalization of the Krylov vectors, see SetOrthogonalization().
+   enum Orthogonalization
+   {
+      MGS, ///< Modified Gram-Schmidt, one global reduction per vector
+      CGS2 ///< Classical Gram-Schmidt with reorthogonalization
+   };
+
 protected:
    int m; // see SetKDim()
+   Orthogonalization ortho; // see SetOrthogonalization()
 
 public:
-   GMRESSolver() { m = 50; }
+   GMRESSolver() { m = 50; ortho = MGS; }
 
 #ifdef MFEM_USE_MPI
-   GMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+   GMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm)
+   { m = 50; ortho = MGS; }
 #endif
 
    /// Set the number of iteration to perform between restarts, default is 50.
    void SetKDim(int dim) { m = dim; }
 
+   /** @brief Set the orthogonalization of the Krylov vectors, default is
+       MGS. */
+   /** With CGS2, the inner products of each iteration are computed with two
+       global reductions, instead of one per Krylov vector with MGS. */
+   void SetOrthogonalization(Orthogonalization o) { ortho = o; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -204,16 +275,21 @@ class FGMRESSolver : public IterativeSolver
 {
 protected:
    int m;
+   GMRESSolver::Orthogonalization ortho;
 
 public:
-   FGMRESSolver() { m = 50; }
+   FGMRESSolver() { m = 50; ortho = GMRESSolver::MGS; }
 
 #ifdef MFEM_USE_MPI
-   FGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+   FGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm)
+   { m = 50; ortho = GMRESSolver::MGS; }
 #endif
 
    void SetKDim(int dim) { m = dim; }
 
+   /// See GMRESSolver::SetOrthogonalization().
+   void SetOrthogonalization(GMRESSolver::Orthogonalization o) { ortho = o; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -547,6 +623,9 @@ private:
    /// Perform the block ILU factorization
    void Factorize();
 
+   /// Compute the levels #fwd_levels and #bwd_levels of the factorization
+   void ComputeLevels();
+
    int block_size;
 
    /// Fill level for block ILU(k) factorizations. Only k=0 is supported.
@@ -572,6 +651,13 @@ private:
    mutable DenseTensor DB;
    /// Pivot arrays for the LU factorizations given by #DB
    mutable Array<int> ipiv;
+
+   /** Level scheduling of the forward and backward substitutions: row l of
+    *  the tables lists the block rows which only depend on the block rows of
+    *  the previous levels. The block rows of a level are processed in parallel
+    *  when a multithreaded host backend is enabled.
+    */
+   Table fwd_levels, bwd_levels;
 };
 
 #ifdef MFEM_USE_SUITESPARSE
@@ -28,6 +28,37 @@ namespace mfem
 
 using namespace std;
 
+// Minimum number of matrix entries per task in the host-threaded sparse
+// matrix algorithms below.
+static const int SPARSE_MIN_ENTRIES_PER_TASK = 16384;
+
+// Return the number of tasks, at most Device::NumHostThreads(), used to
+// process a sparse matrix with the given number of entries on the host.
+static int NumSparseTasks(const int nnz)
+{
+   const int nt = Device::NumHostThreads();
+   if (nt == 1) { return 1; }
+   return std::max(1, std::min(nt, nnz/SPARSE_MIN_ENTRIES_PER_TASK));
+}
+
+// Split the rows of a matrix with row offsets I (of size n+1) into nt
+// contiguous ranges [bounds[t],bounds[t+1]) with about the same number of
+// entries.
+static void BalancedRowRanges(const int *I, const int n, const int nt,
+                              Array<int> &bounds)
+{
+   bounds.SetSize(nt+1);
+   bounds[0] = 0;
+   const long long nnz = I[n];
+   for (int t = 1; t < nt; t++)
+   {
+      const int target = (int)(t*nnz/nt);
+      const int r = std::lower_bound(I, I + n + 1, target) - I;
+      bounds[t] = std::max(bounds[t-1], std::min(r, n));
+   }
+   bounds[nt] = n;
+}
+
 SparseMatrix::SparseMatrix(int nrows, int ncols)
    : AbstractSparseMatrix(nrows, (ncols >= 0) ? ncols : nrows),
      Rows(new RowNode *[nrows]),
@@ -35,6 +66,9 @@ SparseMatrix::SparseMatrix(int nrows, int ncols)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     mult_format(CSR),
+     mult_block_size(0),
+     Af(NULL),
      isSorted(false)
 {
    // We probably do not need to set the ownership flags here.
@@ -58,6 +92,9 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n)
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     mult_format(CSR),
+     mult_block_size(0),
+     Af(NULL),
      isSorted(false)
 {
    I.Wrap(i, height+1, true);
@@ -76,6 +113,9 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n,
      ColPtrJ(NULL),
      ColPtrNode(NULL),
      At(NULL),
+     mult_format(CSR),
+     mult_block_size(0),
+     Af(NULL),
      isSorted(issorted)
 {
    I.Wrap(i, height+1, ownij);
@@ -106,6 +146,9 @@ SparseMatrix::SparseMatrix(int nrows, int ncols, int rowsize)
    , ColPtrJ(NULL)
    , ColPtrNode(NULL)
    , At(NULL)
+   , mult_format(CSR)
+   , mult_block_size(0)
+   , Af(NULL)
    , isSorted(false)
 {
 #ifdef MFEM_USE_MEMALLOC
@@ -183,6 +226,9 @@ SparseMatrix::SparseMatrix(const SparseMatrix &mat, bool copy_graph)
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   mult_format = mat.mult_format;
+   mult_block_size = mat.mult_block_size;
+   Af = NULL;
    isSorted = mat.isSorted;
 }
 
@@ -192,6 +238,9 @@ SparseMatrix::SparseMatrix(const Vector &v)
    , ColPtrJ(NULL)
    , ColPtrNode(NULL)
    , At(NULL)
+   , mult_format(CSR)
+   , mult_block_size(0)
+   , Af(NULL)
    , isSorted(true)
 {
 #ifdef MFEM_USE_MEMALLOC
@@ -246,6 +295,9 @@ void SparseMatrix::SetEmpty()
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   mult_format = CSR;
+   mult_block_size = 0;
+   Af = NULL;
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
@@ -579,6 +631,13 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
       return;
    }
 
+   EnsureMultFormat();
+   if (Af)
+   {
+      Af->AddMult(x, y, a);
+      return;
+   }
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -587,6 +646,27 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
    auto d_A = Read(A, nnz);
    auto d_x = x.Read();
    auto d_y = y.ReadWrite();
+   const int nt = NumSparseTasks(nnz);
+   if (nt > 1 && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      // Host threads: ranges of rows with the same number of entries.
+      Array<int> rows;
+      BalancedRowRanges(d_I, height, nt, rows);
+      HostParallelFor(nt, [&](int t)
+      {
+         for (int i = rows[t]; i < rows[t+1]; i++)
+         {
+            double d = 0.0;
+            const int end = d_I[i+1];
+            for (int j = d_I[i]; j < end; j++)
+            {
+               d += d_A[j] * d_x[d_J[j]];
+            }
+            d_y[i] += a * d;
+         }
+      });
+      return;
+   }
    MFEM_FORALL(i, height,
    {
       double d = 0.0;
@@ -650,6 +730,13 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    if (At)
    {
       At->AddMult(x, y, a);
+      return;
+   }
+
+   EnsureMultFormat();
+   if (Af && Device::IsDisabled())
+   {
+      Af->AddMultTranspose(x, y, a);
    }
    else
    {
@@ -682,6 +769,44 @@ void SparseMatrix::ResetTranspose() const
    At = NULL;
 }
 
+void SparseMatrix::UseMultFormat(MultFormat format, int block_size)
+{
+   MFEM_VERIFY(block_size >= 0 && block_size <= BlockCSRMatrix::MAX_BLOCK_SIZE,
+               "invalid block size " << block_size);
+   ResetMultFormat();
+   mult_format = format;
+   mult_block_size = block_size;
+}
+
+void SparseMatrix::EnsureMultFormat() const
+{
+   if (Af || mult_format == CSR || !Finalized()) { return; }
+   switch (mult_format)
+   {
+      case BCSR:
+         if (mult_block_size == 0)
+         {
+            mult_block_size = BlockCSRMatrix::DetectBlockSize(*this);
+         }
+         if (mult_block_size > 1)
+         {
+            Af = new BlockCSRMatrix(*this, mult_block_size);
+         }
+         break;
+      case SELL:
+         Af = new SellCSMatrix(*this);
+         break;
+      default:
+         break;
+   }
+}
+
+void SparseMatrix::ResetMultFormat() const
+{
+   delete Af;
+   Af = NULL;
+}
+
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
@@ -2077,6 +2202,122 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
    }
 }
 
+void SparseMatrix::GetRowColoring(Table &colors) const
+{
+   MFEM_VERIFY(Finalized() && height == width,
+               "the matrix must be finalized and square");
+
+   SparseMatrix *T = Transpose(*this);
+   const int *Ti = T->GetI(), *Tj = T->GetJ();
+   Array<int> color(height), marker;
+   int ncolors = 0;
+   for (int i = 0; i < height; i++)
+   {
+      // Mark the colors of the neighbors of row i that are already colored
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         if (J[j] < i) { marker[color[J[j]]] = i; }
+      }
+      for (int j = Ti[i]; j < Ti[i+1]; j++)
+      {
+         if (Tj[j] < i) { marker[color[Tj[j]]] = i; }
+      }
+      int c = 0;
+      for ( ; c < ncolors && marker[c] == i; c++) { }
+      if (c == ncolors)
+      {
+         marker.Append(-1);
+         ncolors++;
+      }
+      color[i] = c;
+   }
+   delete T;
+
+   colors.MakeI(ncolors);
+   for (int i = 0; i < height; i++)
+   {
+      colors.AddAColumnInRow(color[i]);
+   }
+   colors.MakeJ();
+   for (int i = 0; i < height; i++)
+   {
+      colors.AddConnection(color[i], i);
+   }
+   colors.ShiftUpI();
+}
+
+// Gauss-Seidel relaxation of the rows of the given colors, in the given order,
+// with the host threads.
+static void ColoredGaussSeidel(const SparseMatrix &M, const Vector &x,
+                               Vector &y, const Table &colors,
+                               const bool forward)
+{
+   MFEM_VERIFY(M.Finalized(), "the matrix must be finalized");
+   const int s = M.Height();
+   const int *Ip = M.HostReadI();
+   const int *Jp = M.HostReadJ();
+   const double *Ap = M.HostReadData();
+   double *yp = y.HostReadWrite();
+   const double *xp = x.HostRead();
+   const int avg_row_size = s ? Ip[s]/s + 1 : 1;
+
+   for (int k = 0; k < colors.Size(); k++)
+   {
+      const int c = forward ? k : colors.Size() - 1 - k;
+      const int *rows = colors.GetRow(c);
+      const int nrows = colors.RowSize(c);
+      const int nt = NumSparseTasks(nrows*avg_row_size);
+      HostParallelFor(nt, [&](int t)
+      {
+         const int begin = (int)((long long)t*nrows/nt);
+         const int end = (int)((long long)(t+1)*nrows/nt);
+         for (int r = begin; r < end; r++)
+         {
+            const int i = rows[forward ? r : nrows - 1 - r];
+            double sum = 0.0;
+            int d = -1;
+            for (int j = Ip[i]; j < Ip[i+1]; j++)
+            {
+               const int col = Jp[j];
+               if (col == i)
+               {
+                  d = j;
+               }
+               else
+               {
+                  sum += Ap[j] * yp[col];
+               }
+            }
+
+            if (d >= 0 && Ap[d] != 0.0)
+            {
+               yp[i] = (xp[i] - sum) / Ap[d];
+            }
+            else if (xp[i] == sum)
+            {
+               yp[i] = sum;
+            }
+            else
+            {
+               mfem_error("SparseMatrix::Gauss_Seidel_forw/back(...) #3");
+            }
+         }
+      });
+   }
+}
+
+void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y,
+                                     const Table &colors) const
+{
+   ColoredGaussSeidel(*this, x, y, colors, true);
+}
+
+void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y,
+                                     const Table &colors) const
+{
+   ColoredGaussSeidel(*this, x, y, colors, false);
+}
+
 double SparseMatrix::GetJacobiScaling() const
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
@@ -2938,6 +3179,7 @@ void SparseMatrix::Destroy()
    delete NodesMem;
 #endif
    delete At;
+   delete Af;
 }
 
 int SparseMatrix::ActualWidth() const
@@ -2977,60 +3219,149 @@ void SparseMatrixFunction (SparseMatrix & S, double (*f)(double))
    }
 }
 
-SparseMatrix *Transpose (const SparseMatrix &A)
+// Transpose of A, also computing (if A_to_At != NULL) the position in the
+// transpose of each entry of A. The result is the same with any number of
+// tasks: the rows of the transpose are sorted.
+static SparseMatrix *TransposeWithMap(const SparseMatrix &A, int *A_to_At)
 {
    MFEM_VERIFY(
       A.Finalized(),
       "Finalize must be called before Transpose. Use TransposeRowMatrix instead");
 
-   int i, j, end;
-   const int *A_i, *A_j;
-   int m, n, nnz, *At_i, *At_j;
-   const double *A_data;
-   double *At_data;
-
-   m      = A.Height(); // number of rows of A
-   n      = A.Width();  // number of columns of A
-   nnz    = A.NumNonZeroElems();
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
+   const int m = A.Height(); // number of rows of A
+   const int n = A.Width();  // number of columns of A
+   const int nnz = A.NumNonZeroElems();
+   const int *A_i = A.GetI();
+   const int *A_j = A.GetJ();
+   const double *A_data = A.GetData();
 
-   At_i = Memory<int>(n+1);
-   At_j = Memory<int>(nnz);
-   At_data = Memory<double>(nnz);
+   int *At_i = Memory<int>(n+1);
+   int *At_j = Memory<int>(nnz);
+   double *At_data = Memory<double>(nnz);
 
-   for (i = 0; i <= n; i++)
+   // Each task needs n counters: limit their memory to that of the matrix.
+   const int nt = std::min(NumSparseTasks(nnz), std::max(1, 2*(nnz/(n+1))));
+   if (nt == 1)
    {
-      At_i[i] = 0;
+      for (int i = 0; i <= n; i++)
+      {
+         At_i[i] = 0;
+      }
+      for (int i = 0; i < nnz; i++)
+      {
+         At_i[A_j[i]+1]++;
+      }
+      for (int i = 1; i < n; i++)
+      {
+         At_i[i+1] += At_i[i];
+      }
+
+      for (int i = 0, j = 0; i < m; i++)
+      {
+         const int end = A_i[i+1];
+         for ( ; j < end; j++)
+         {
+            const int pos = At_i[A_j[j]]++;
+            At_j[pos] = i;
+            At_data[pos] = A_data[j];
+            if (A_to_At) { A_to_At[j] = pos; }
+         }
+      }
+
+      for (int i = n; i > 0; i--)
+      {
+         At_i[i] = At_i[i-1];
+      }
+      At_i[0] = 0;
+
+      return new SparseMatrix(At_i, At_j, At_data, n, m);
    }
-   for (i = 0; i < nnz; i++)
+
+   // Symbolic phase: each task counts the entries of each column of A in its
+   // range of rows. The counts are then replaced by the offsets of the task in
+   // the rows of the transpose, so that the rows of A are scattered in order.
+   Array<int> rows, cols;
+   BalancedRowRanges(A_i, m, nt, rows);
+   cols.SetSize(nt+1);
+   for (int t = 0; t <= nt; t++) { cols[t] = (int)((long long)t*n/nt); }
+   Array<int> counts(nt*n);
+   int *cnt = counts.GetData();
+   HostParallelFor(nt, [&](int t)
    {
-      At_i[A_j[i]+1]++;
-   }
-   for (i = 1; i < n; i++)
+      int *c = cnt + (size_t)t*n;
+      for (int k = 0; k < n; k++) { c[k] = 0; }
+      for (int j = A_i[rows[t]]; j < A_i[rows[t+1]]; j++) { c[A_j[j]]++; }
+   });
+   HostParallelFor(nt, [&](int t)
    {
-      At_i[i+1] += At_i[i];
+      for (int k = cols[t]; k < cols[t+1]; k++)
+      {
+         int offset = 0;
+         for (int s = 0; s < nt; s++)
+         {
+            const int c = cnt[(size_t)s*n+k];
+            cnt[(size_t)s*n+k] = offset;
+            offset += c;
+         }
+         At_i[k+1] = offset;
+      }
+   });
+   At_i[0] = 0;
+   for (int k = 0; k < n; k++)
+   {
+      At_i[k+1] += At_i[k];
    }
 
-   for (i = j = 0; i < m; i++)
+   // Numeric phase
+   HostParallelFor(nt, [&](int t)
    {
-      end = A_i[i+1];
-      for ( ; j < end; j++)
+      int *c = cnt + (size_t)t*n;
+      for (int i = rows[t]; i < rows[t+1]; i++)
       {
-         At_j[At_i[A_j[j]]] = i;
-         At_data[At_i[A_j[j]]] = A_data[j];
-         At_i[A_j[j]]++;
+         for (int j = A_i[i]; j < A_i[i+1]; j++)
+         {
+            const int col = A_j[j];
+            const int pos = At_i[col] + c[col]++;
+            At_j[pos] = i;
+            At_data[pos] = A_data[j];
+            if (A_to_At) { A_to_At[j] = pos; }
+         }
       }
-   }
+   });
 
-   for (i = n; i > 0; i--)
-   {
-      At_i[i] = At_i[i-1];
-   }
-   At_i[0] = 0;
+   return new SparseMatrix(At_i, At_j, At_data, n, m);
+}
 
-   return  new SparseMatrix(At_i, At_j, At_data, n, m);
+SparseMatrix *Transpose (const SparseMatrix &A)
+{
+   return TransposeWithMap(A, NULL);
+}
+
+SparseMatrix *Transpose(const SparseMatrix &A, Array<int> &A_to_At)
+{
+   A_to_At.SetSize(A.Finalized() ? A.NumNonZeroElems() : 0);
+   return TransposeWithMap(A, A_to_At.GetData());
+}
+
+void TransposeValues(const SparseMatrix &A, const Array<int> &A_to_At,
+                     SparseMatrix &At)
+{
+   const int nnz = A.NumNonZeroElems();
+   MFEM_VERIFY(A.Finalized() && At.Finalized() && A_to_At.Size() == nnz &&
+               At.NumNonZeroElems() == nnz && At.Height() == A.Width() &&
+               At.Width() == A.Height(),
+               "the transpose and the map must be computed by Transpose()");
+
+   const double *A_data = A.HostReadData();
+   double *At_data = At.HostReadWriteData();
+   const int *map = A_to_At.GetData();
+   const int nt = NumSparseTasks(nnz);
+   HostParallelFor(nt, [&](int t)
+   {
+      const int begin = (int)((long long)t*nnz/nt);
+      const int end = (int)((long long)(t+1)*nnz/nt);
+      for (int j = begin; j < end; j++) { At_data[map[j]] = A_data[j]; }
+   });
 }
 
 SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
@@ -3113,71 +3444,75 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                     SparseMatrix *OAB)
 {
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
-   const double *A_data, *B_data;
-   double *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
-   SparseMatrix *C;
-
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
+   const int nrowsA = A.Height();
+   const int ncolsA = A.Width();
+   const int nrowsB = B.Height();
+   const int ncolsB = B.Width();
 
    MFEM_VERIFY(ncolsA == nrowsB,
                "number of columns of A (" << ncolsA
                << ") must equal number of rows of B (" << nrowsB << ")");
 
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-   B_i    = B.GetI();
-   B_j    = B.GetJ();
-   B_data = B.GetData();
-
-   B_marker = new int[ncolsB];
-
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
+   const int *A_i = A.GetI();
+   const int *A_j = A.GetJ();
+   const double *A_data = A.GetData();
+   const int *B_i = B.GetI();
+   const int *B_j = B.GetJ();
+   const double *B_data = B.GetData();
 
+   // The rows of A are split into ranges processed by separate tasks, each of
+   // them with its own marker array of size ncolsB. The result does not depend
+   // on the number of tasks.
+   const int nt = std::min(NumSparseTasks(A.NumNonZeroElems()),
+                           std::max(1, 2*(A.NumNonZeroElems()/(ncolsB+1))));
+   Array<int> rows;
+   BalancedRowRanges(A_i, nrowsA, nt, rows);
+   Array<int> markers(nt*ncolsB);
+   int *marker = markers.GetData();
+
+   int *C_i, *C_j;
+   double *C_data;
+   SparseMatrix *C;
    if (OAB == NULL)
    {
+      // Symbolic phase: compute the number of entries of each row of C.
       C_i = Memory<int>(nrowsA+1);
-
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+      HostParallelFor(nt, [&](int t)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         int *B_marker = marker + (size_t)t*ncolsB;
+         for (int ib = 0; ib < ncolsB; ib++)
+         {
+            B_marker[ib] = -1;
+         }
+         for (int ic = rows[t]; ic < rows[t+1]; ic++)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            int num_nonzeros = 0;
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
             {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
+               const int ja = A_j[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
                {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
+                  const int jb = B_j[ib];
+                  if (B_marker[jb] != ic)
+                  {
+                     B_marker[jb] = ic;
+                     num_nonzeros++;
+                  }
                }
             }
+            C_i[ic+1] = num_nonzeros;
          }
-         C_i[ic+1] = num_nonzeros;
+      });
+      C_i[0] = 0;
+      for (int ic = 0; ic < nrowsA; ic++)
+      {
+         C_i[ic+1] += C_i[ic];
       }
 
-      C_j    = Memory<int>(num_nonzeros);
-      C_data = Memory<double>(num_nonzeros);
+      C_j    = Memory<int>(C_i[nrowsA]);
+      C_data = Memory<double>(C_i[nrowsA]);
 
       C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
-
-      for (ib = 0; ib < ncolsB; ib++)
-      {
-         B_marker[ib] = -1;
-      }
    }
    else
    {
@@ -3190,50 +3525,69 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                   << " ncolsB = " << ncolsB
                   << ", C->Width() = " << C->Width());
 
-      // C_i    = C -> GetI(); // not used
+      C_i    = C -> GetI();
       C_j    = C -> GetJ();
       C_data = C -> GetData();
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   // Numeric phase. With a pre-allocated output matrix, the number of entries
+   // of each row is checked against its row offsets.
+   Array<int> mismatch(nt);
+   mismatch = 0;
+   HostParallelFor(nt, [&](int t)
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+      int *B_marker = marker + (size_t)t*ncolsB;
+      for (int ib = 0; ib < ncolsB; ib++)
+      {
+         B_marker[ib] = -1;
+      }
+      int counter = C_i[rows[t]];
+      for (int ic = rows[t]; ic < rows[t+1]; ic++)
       {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         const int row_start = counter;
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
          {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
+            const int ja = A_j[ia];
+            const double a_entry = A_data[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
             {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
+               const int jb = B_j[ib];
+               const double b_entry = B_data[ib];
+               if (B_marker[jb] < row_start)
                {
-                  C_j[counter] = jb;
+                  if (counter == C_i[ic+1])
+                  {
+                     // This can only happen with a pre-allocated matrix.
+                     mismatch[t] = 1;
+                     return;
+                  }
+                  B_marker[jb] = counter;
+                  if (OAB == NULL)
+                  {
+                     C_j[counter] = jb;
+                  }
+                  C_data[counter] = a_entry*b_entry;
+                  counter++;
+               }
+               else
+               {
+                  C_data[B_marker[jb]] += a_entry*b_entry;
                }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
-            {
-               C_data[B_marker[jb]] += a_entry*b_entry;
             }
          }
+         if (counter != C_i[ic+1])
+         {
+            mismatch[t] = 1;
+            return;
+         }
       }
-   }
+   });
 
    MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
-
-   delete [] B_marker;
+      mismatch.Max() == 0,
+      "With pre-allocated output matrix, the sparsity pattern of the output ("
+      << OAB->NumNonZeroElems() << " non-zeros) did not match the entries "
+      "changed from matrix-matrix multiply");
 
    return C;
 }
@@ -3665,6 +4019,9 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ColPtrJ, other.ColPtrJ);
    mfem::Swap(ColPtrNode, other.ColPtrNode);
    mfem::Swap(At, other.At);
+   mfem::Swap(mult_format, other.mult_format);
+   mfem::Swap(mult_block_size, other.mult_block_size);
+   mfem::Swap(Af, other.Af);
 
 #ifdef MFEM_USE_MEMALLOC
    mfem::Swap(NodesMem, other.NodesMem);
@@ -24,6 +24,8 @@
 namespace mfem
 {
 
+class SparseMatrixFormat;
+
 class
 #if defined(__alignas_is_defined)
    alignas(double)
@@ -39,6 +41,15 @@ public:
 /// Data type sparse matrix
 class SparseMatrix : public AbstractSparseMatrix
 {
+public:
+   /// Storage formats that can be used for the action of a finalized matrix.
+   enum MultFormat
+   {
+      CSR,  ///< The CSR arrays #I, #J, #A (default).
+      BCSR, ///< Block CSR with dense square blocks, see BlockCSRMatrix.
+      SELL  ///< Sliced ELLPACK, SELL-C-sigma, see SellCSMatrix.
+   };
+
 protected:
    /// @name Arrays used by the CSR storage format.
    /** */
@@ -69,6 +80,14 @@ protected:
    /// Transpose of A. Owned. Used to perform MultTranspose() on devices.
    mutable SparseMatrix *At;
 
+   /// Storage format used for the action of the matrix, see UseMultFormat().
+   MultFormat mult_format;
+   /** @brief Block size of the BCSR format: 0 for automatic detection, 1 if
+       the detection found no suitable block size. */
+   mutable int mult_block_size;
+   /// Copy of A in the #mult_format storage. Owned. Built by the first action.
+   mutable SparseMatrixFormat *Af;
+
 #ifdef MFEM_USE_MEMALLOC
    typedef MemAlloc <RowNode, 1024> RowNodeAlloc;
    RowNodeAlloc * NodesMem;
@@ -80,6 +99,9 @@ protected:
    void Destroy();   // Delete all owned data
    void SetEmpty();  // Init all entries with empty values
 
+   /// Build #Af, if needed, when the matrix is finalized.
+   void EnsureMultFormat() const;
+
 public:
    /// Create an empty SparseMatrix.
    SparseMatrix() { SetEmpty(); }
@@ -302,6 +324,37 @@ public:
        more details. */
    void ResetTranspose() const;
 
+   /** @brief Use the given storage @a format for the action of the finalized
+       matrix. */
+   /** The CSR arrays are converted to the new format by the first call to
+       Mult() or AddMult() after Finalize(); the CSR arrays are kept and used
+       by all the other methods. The converted matrix is also used by
+       MultTranspose() and AddMultTranspose() when the internal transpose is
+       not built and no device backend is enabled.
+
+       With the BCSR format, @a block_size is the size of the dense blocks,
+       e.g. the vdim of a vector space with Ordering::byVDIM. If it is 0, the
+       block size is selected with BlockCSRMatrix::DetectBlockSize() and the
+       CSR format is used when no block size is suitable.
+
+       Warning: as with the internal transpose, see BuildTranspose(), any
+       changes in the entries of this matrix invalidate the converted matrix:
+       call ResetMultFormat() after such changes. */
+   void UseMultFormat(MultFormat format, int block_size = 0);
+
+   /// Return the storage format used for the action of the matrix.
+   MultFormat GetMultFormat() const { return mult_format; }
+
+   /** @brief Return the converted matrix used for the action, building it if
+       necessary, or NULL if the CSR arrays are used. */
+   const SparseMatrixFormat *GetMultFormatMatrix() const
+   { EnsureMultFormat(); return Af; }
+
+   /** Reset (destroy) the converted matrix used for the action, which will be
+       rebuilt from the CSR arrays by the next action. See UseMultFormat() for
+       more details. */
+   void ResetMultFormat() const;
+
    void PartMult(const Array<int> &rows, const Vector &x, Vector &y) const;
    void PartAddMult(const Array<int> &rows, const Vector &x, Vector &y,
                     const double a=1.0) const;
@@ -398,6 +451,22 @@ public:
    void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
    void Gauss_Seidel_back(const Vector &x, Vector &y) const;
 
+   /** @brief Compute a greedy coloring of the rows of the finalized square
+       matrix, such that the rows i and j have different colors when the entry
+       (i,j) or (j,i) is in the sparsity pattern. Row c of the Table @a colors
+       lists the rows of color c. */
+   void GetRowColoring(Table &colors) const;
+
+   /** @brief Multicolor Gauss-Seidel forward and backward iterations over a
+       vector x, using the coloring of the rows computed by GetRowColoring(). */
+   /** The colors are processed in increasing (forward) or decreasing
+       (backward) order. The rows of one color are independent and they are
+       relaxed in parallel when a multithreaded host backend is enabled. */
+   void Gauss_Seidel_forw(const Vector &x, Vector &y,
+                          const Table &colors) const;
+   void Gauss_Seidel_back(const Vector &x, Vector &y,
+                          const Table &colors) const;
+
    /// Determine appropriate scaling for Jacobi iteration
    double GetJacobiScaling() const;
    /** One scaled Jacobi iteration for the system A x = b.
@@ -583,7 +652,21 @@ void SparseMatrixFunction(SparseMatrix &S, double (*f)(double));
 
 
 /// Transpose of a sparse matrix. A must be finalized.
+/** When a multithreaded host backend is enabled (Backend::OMP or
+    Backend::THREADS), the transpose, as well as the products of sparse
+    matrices below, are computed with the host threads. The result does not
+    depend on the number of threads. */
 SparseMatrix *Transpose(const SparseMatrix &A);
+/** @brief Transpose of a sparse matrix that also returns in @a A_to_At the
+    position in the transpose of each entry of A. A must be finalized. */
+/** The map can be used with TransposeValues() to update the transpose when
+    only the values of A change. */
+SparseMatrix *Transpose(const SparseMatrix &A, Array<int> &A_to_At);
+/** @brief Update the values of the transpose @a At of A, computed with
+    Transpose(A, A_to_At), after a change of the values, but not of the
+    sparsity pattern, of A. */
+void TransposeValues(const SparseMatrix &A, const Array<int> &A_to_At,
+                     SparseMatrix &At);
 /// Transpose of a sparse matrix. A does not need to be a CSR matrix.
 SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
                                              int useActualWidth);
@@ -0,0 +1,351 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the BCSR and SELL-C-sigma sparse matrix formats
+
+#include "sparsemat_formats.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+const int BlockCSRMatrix::MAX_BLOCK_SIZE;
+const int SellCSMatrix::C;
+
+void SparseMatrixFormat::Mult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true);
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SparseMatrixFormat::MultTranspose(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMultTranspose(x, y);
+}
+
+// Count the blocks of size bs of the finalized matrix with CSR arrays I and J.
+// The array 'marker' has size width/bs.
+static int CountBlocks(const int nbrows, const int bs, const int *I,
+                       const int *J, Array<int> &marker)
+{
+   marker = -1;
+   int nblocks = 0;
+   for (int br = 0; br < nbrows; br++)
+   {
+      for (int r = br*bs; r < (br+1)*bs; r++)
+      {
+         for (int j = I[r]; j < I[r+1]; j++)
+         {
+            const int bc = J[j]/bs;
+            if (marker[bc] != br) { marker[bc] = br; nblocks++; }
+         }
+      }
+   }
+   return nblocks;
+}
+
+BlockCSRMatrix::BlockCSRMatrix(const SparseMatrix &mat, const int bs)
+   : SparseMatrixFormat(mat.Height(), mat.Width()),
+     block_size(bs), nbrows(mat.Height()/bs)
+{
+   MFEM_VERIFY(mat.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(bs >= 1 && bs <= MAX_BLOCK_SIZE, "invalid block size " << bs);
+   MFEM_VERIFY(height % bs == 0 && width % bs == 0, "the matrix size "
+               << height << " x " << width << " is not a multiple of the "
+               "block size " << bs);
+
+   const int *I = mat.HostReadI(), *J = mat.HostReadJ();
+   const double *A = mat.HostReadData();
+   Array<int> marker(width/bs);
+
+   IB.New(nbrows+1);
+   IB[0] = 0;
+   marker = -1;
+   for (int br = 0; br < nbrows; br++)
+   {
+      int cnt = 0;
+      for (int r = br*bs; r < (br+1)*bs; r++)
+      {
+         for (int j = I[r]; j < I[r+1]; j++)
+         {
+            const int bc = J[j]/bs;
+            if (marker[bc] != br) { marker[bc] = br; cnt++; }
+         }
+      }
+      IB[br+1] = IB[br] + cnt;
+   }
+
+   const int nblocks = IB[nbrows];
+   JB.New(nblocks);
+   AB.New(nblocks*bs*bs);
+   double *ab = AB;
+   std::fill(ab, ab + nblocks*bs*bs, 0.0);
+   // The marker stores the position of the block in the current block row
+   marker = -1;
+   for (int br = 0; br < nbrows; br++)
+   {
+      int pos = IB[br];
+      for (int r = br*bs; r < (br+1)*bs; r++)
+      {
+         for (int j = I[r]; j < I[r+1]; j++)
+         {
+            const int bc = J[j]/bs;
+            if (marker[bc] < IB[br]) { marker[bc] = pos; JB[pos++] = bc; }
+            ab[(marker[bc]*bs + r%bs)*bs + J[j]%bs] += A[j];
+         }
+      }
+   }
+}
+
+int BlockCSRMatrix::DetectBlockSize(const SparseMatrix &mat,
+                                    const int max_block_size,
+                                    const double max_fill)
+{
+   MFEM_VERIFY(mat.Finalized(), "the matrix must be finalized");
+   const int height = mat.Height(), width = mat.Width();
+   const int *I = mat.HostReadI(), *J = mat.HostReadJ();
+   const int nnz = I[height];
+   const int max_bs = std::min(max_block_size, (int) MAX_BLOCK_SIZE);
+
+   int best_bs = 1;
+   double best_stored = max_fill*nnz;
+   for (int bs = 2; bs <= max_bs; bs++)
+   {
+      if (height % bs || width % bs) { continue; }
+      Array<int> marker(width/bs);
+      const int nblocks = CountBlocks(height/bs, bs, I, J, marker);
+      const double stored = double(nblocks)*bs*bs;
+      if (stored <= best_stored)
+      {
+         best_bs = bs;
+         best_stored = stored;
+      }
+   }
+   return best_bs;
+}
+
+// BCSR action kernel. The block size is a template parameter, or the runtime
+// argument 'bs_' when B = 0.
+template <int B>
+static void BCSRAddMult(const int nbrows, const int bs_,
+                        const Memory<int> &IB, const Memory<int> &JB,
+                        const Memory<double> &AB, const Vector &x, Vector &y,
+                        const double a)
+{
+   const int bs = B ? B : bs_;
+   const int nblocks = IB[nbrows];
+   auto d_IB = Read(IB, nbrows+1);
+   auto d_JB = Read(JB, nblocks);
+   auto d_AB = Read(AB, nblocks*bs*bs);
+   auto d_x = x.Read();
+   auto d_y = y.ReadWrite();
+   MFEM_FORALL(i, nbrows,
+   {
+      constexpr int MB = B ? B : BlockCSRMatrix::MAX_BLOCK_SIZE;
+      const int BS = B ? B : bs;
+      double yb[MB];
+      for (int r = 0; r < BS; r++) { yb[r] = 0.0; }
+      for (int k = d_IB[i]; k < d_IB[i+1]; k++)
+      {
+         const double *blk = d_AB + k*BS*BS;
+         const double *xb = d_x + d_JB[k]*BS;
+         for (int r = 0; r < BS; r++)
+         {
+            double s = 0.0;
+            for (int c = 0; c < BS; c++) { s += blk[r*BS+c]*xb[c]; }
+            yb[r] += s;
+         }
+      }
+      for (int r = 0; r < BS; r++) { d_y[i*BS+r] += a*yb[r]; }
+   });
+}
+
+void BlockCSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size() && height == y.Size(), "invalid sizes");
+   if (nbrows == 0) { return; }
+   switch (block_size)
+   {
+      case 2: return BCSRAddMult<2>(nbrows, 2, IB, JB, AB, x, y, a);
+      case 3: return BCSRAddMult<3>(nbrows, 3, IB, JB, AB, x, y, a);
+      case 4: return BCSRAddMult<4>(nbrows, 4, IB, JB, AB, x, y, a);
+      default:
+         return BCSRAddMult<0>(nbrows, block_size, IB, JB, AB, x, y, a);
+   }
+}
+
+void BlockCSRMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                      const double a) const
+{
+   MFEM_ASSERT(height == x.Size() && width == y.Size(), "invalid sizes");
+   if (nbrows == 0) { return; }
+   const int bs = block_size;
+   const int nblocks = IB[nbrows];
+   const int *ib = mfem::Read(IB, nbrows+1, false);
+   const int *jb = mfem::Read(JB, nblocks, false);
+   const double *ab = mfem::Read(AB, nblocks*bs*bs, false);
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int i = 0; i < nbrows; i++)
+   {
+      for (int k = ib[i]; k < ib[i+1]; k++)
+      {
+         const double *blk = ab + k*bs*bs;
+         double *yb = yp + jb[k]*bs;
+         for (int r = 0; r < bs; r++)
+         {
+            const double xr = a*xp[i*bs+r];
+            for (int c = 0; c < bs; c++) { yb[c] += blk[r*bs+c]*xr; }
+         }
+      }
+   }
+}
+
+BlockCSRMatrix::~BlockCSRMatrix()
+{
+   IB.Delete();
+   JB.Delete();
+   AB.Delete();
+}
+
+
+SellCSMatrix::SellCSMatrix(const SparseMatrix &mat, const int sigma_)
+   : SparseMatrixFormat(mat.Height(), mat.Width()),
+     sigma(std::max(C, ((sigma_ + C - 1)/C)*C)),
+     nslices((mat.Height() + C - 1)/C)
+{
+   MFEM_VERIFY(mat.Finalized(), "the matrix must be finalized");
+   const int *I = mat.HostReadI(), *J = mat.HostReadJ();
+   const double *A = mat.HostReadData();
+
+   // Sort the rows by decreasing length within windows of sigma rows
+   perm.New(nslices*C);
+   int *p = perm;
+   for (int r = 0; r < nslices*C; r++) { p[r] = (r < height) ? r : -1; }
+   for (int w = 0; w < height; w += sigma)
+   {
+      std::stable_sort(p + w, p + std::min(w + sigma, height),
+                       [&](const int r1, const int r2)
+      { return I[r1+1] - I[r1] > I[r2+1] - I[r2]; });
+   }
+
+   offsets.New(nslices+1);
+   offsets[0] = 0;
+   for (int s = 0; s < nslices; s++)
+   {
+      int len = 0;
+      for (int r = s*C; r < (s+1)*C; r++)
+      {
+         if (p[r] >= 0) { len = std::max(len, I[p[r]+1] - I[p[r]]); }
+      }
+      offsets[s+1] = offsets[s] + len;
+   }
+
+   const int nstored = offsets[nslices]*C;
+   cols.New(nstored);
+   vals.New(nstored);
+   for (int s = 0; s < nslices; s++)
+   {
+      const int len = offsets[s+1] - offsets[s];
+      for (int r = 0; r < C; r++)
+      {
+         const int row = p[s*C+r];
+         const int begin = (row >= 0) ? I[row] : 0;
+         const int row_len = (row >= 0) ? I[row+1] - I[row] : 0;
+         for (int k = 0; k < len; k++)
+         {
+            const int idx = (offsets[s] + k)*C + r;
+            if (k < row_len)
+            {
+               cols[idx] = J[begin + k];
+               vals[idx] = A[begin + k];
+            }
+            else
+            {
+               // Padding: repeat the last column of the row for locality
+               cols[idx] = (row_len > 0) ? J[begin + row_len - 1] : 0;
+               vals[idx] = 0.0;
+            }
+         }
+      }
+   }
+}
+
+void SellCSMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size() && height == y.Size(), "invalid sizes");
+   if (nslices == 0) { return; }
+   const int nstored = offsets[nslices]*C;
+   auto d_perm = Read(perm, nslices*C);
+   auto d_offsets = Read(offsets, nslices+1);
+   auto d_cols = Read(cols, nstored);
+   auto d_vals = Read(vals, nstored);
+   auto d_x = x.Read();
+   auto d_y = y.ReadWrite();
+   MFEM_FORALL(s, nslices,
+   {
+      constexpr int SC = SellCSMatrix::C;
+      double acc[SC];
+      for (int r = 0; r < SC; r++) { acc[r] = 0.0; }
+      for (int k = d_offsets[s]; k < d_offsets[s+1]; k++)
+      {
+         const int *c = d_cols + k*SC;
+         const double *v = d_vals + k*SC;
+         for (int r = 0; r < SC; r++) { acc[r] += v[r]*d_x[c[r]]; }
+      }
+      for (int r = 0; r < SC; r++)
+      {
+         const int row = d_perm[s*SC+r];
+         if (row >= 0) { d_y[row] += a*acc[r]; }
+      }
+   });
+}
+
+void SellCSMatrix::AddMultTranspose(const Vector &x, Vector &y,
+                                    const double a) const
+{
+   MFEM_ASSERT(height == x.Size() && width == y.Size(), "invalid sizes");
+   if (nslices == 0) { return; }
+   const int nstored = offsets[nslices]*C;
+   const int *p = mfem::Read(perm, nslices*C, false);
+   const int *o = mfem::Read(offsets, nslices+1, false);
+   const int *c = mfem::Read(cols, nstored, false);
+   const double *v = mfem::Read(vals, nstored, false);
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+   for (int s = 0; s < nslices; s++)
+   {
+      for (int r = 0; r < C; r++)
+      {
+         const int row = p[s*C+r];
+         if (row < 0) { continue; }
+         const double xr = a*xp[row];
+         for (int k = o[s]; k < o[s+1]; k++)
+         {
+            yp[c[k*C+r]] += v[k*C+r]*xr;
+         }
+      }
+   }
+}
+
+SellCSMatrix::~SellCSMatrix()
+{
+   perm.Delete();
+   offsets.Delete();
+   cols.Delete();
+   vals.Delete();
+}
+
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SPARSEMAT_FORMATS_HPP
+#define MFEM_SPARSEMAT_FORMATS_HPP
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Abstract base class for the storage formats of a finalized
+    SparseMatrix that can be used for its action, see
+    SparseMatrix::UseMultFormat(). */
+/** The data is copied from the CSR arrays of the SparseMatrix: later changes
+    of the SparseMatrix are not reflected in the copy. */
+class SparseMatrixFormat : public Operator
+{
+public:
+   SparseMatrixFormat(int h, int w) : Operator(h, w) { }
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   /// y += a * A * x
+   virtual void AddMult(const Vector &x, Vector &y,
+                        const double a = 1.0) const = 0;
+
+   /// y += a * At * x
+   /** The transpose action is computed on the host. */
+   virtual void AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a = 1.0) const = 0;
+
+   /// y = A * x
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y = At * x
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Return the number of stored entries, including the explicit zeros.
+   virtual int NumStoredEntries() const = 0;
+};
+
+
+/** @brief Block compressed sparse row (BCSR) storage: the matrix is a sparse
+    matrix of dense square blocks of size #block_size. */
+/** This format is suitable for vector-valued spaces with Ordering::byVDIM,
+    where the vdim dofs of a node are coupled with those of all the neighbor
+    nodes: only one column index is stored per block instead of one per entry.
+    Entries of the blocks which are not in the sparsity pattern of the CSR
+    matrix are stored as zeros. The height and the width of the matrix must be
+    multiples of the block size. */
+class BlockCSRMatrix : public SparseMatrixFormat
+{
+protected:
+   int block_size, nbrows;
+   /// Block row offsets, size nbrows+1.
+   Memory<int> IB;
+   /// Block column indices, size IB[nbrows].
+   Memory<int> JB;
+   /// Row-major block entries, size IB[nbrows]*block_size*block_size.
+   Memory<double> AB;
+
+public:
+   /// Maximum supported block size.
+   static const int MAX_BLOCK_SIZE = 8;
+
+   /// Convert the finalized matrix @a mat with the given block size.
+   BlockCSRMatrix(const SparseMatrix &mat, const int block_size);
+
+   /** @brief Return the block size, between 2 and @a max_block_size, that
+       minimizes the number of stored entries of the BCSR format of @a mat, or
+       1 if the BCSR format would store more than @a max_fill times the number
+       of entries of the CSR format. */
+   static int DetectBlockSize(const SparseMatrix &mat,
+                              const int max_block_size = 4,
+                              const double max_fill = 1.25);
+
+   int GetBlockSize() const { return block_size; }
+   int NumBlocks() const { return nbrows ? IB[nbrows] : 0; }
+   virtual int NumStoredEntries() const
+   { return NumBlocks()*block_size*block_size; }
+
+   virtual void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+   virtual void AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a = 1.0) const;
+
+   virtual ~BlockCSRMatrix();
+};
+
+
+/** @brief Sliced ELLPACK storage with slice height C and sorting scope sigma,
+    SELL-C-sigma. */
+/** The rows are grouped in slices of C consecutive rows, each of them padded
+    to the length of the longest row in the slice and stored column-major, so
+    that the C rows of a slice are processed together with vector
+    instructions. To reduce the padding, the rows are sorted by decreasing
+    length within windows of sigma rows before they are grouped. */
+class SellCSMatrix : public SparseMatrixFormat
+{
+public:
+   /// Slice height: two vectors of SIMD_LANES doubles.
+   static const int C = 2*SIMD_LANES;
+
+protected:
+   int sigma, nslices;
+   /// Row of the matrix of each of the nslices*C rows of the slices, or -1.
+   Memory<int> perm;
+   /// Slice offsets, size nslices+1, in units of C entries.
+   Memory<int> offsets;
+   /// Column indices of the slice entries, column-major in each slice.
+   Memory<int> cols;
+   /// Entries of the slices, column-major in each slice; padding is zero.
+   Memory<double> vals;
+
+public:
+   /** @brief Convert the finalized matrix @a mat. The sorting scope @a sigma
+       is rounded up to a multiple of C. */
+   SellCSMatrix(const SparseMatrix &mat, const int sigma = 256);
+
+   int GetSigma() const { return sigma; }
+   int NumSlices() const { return nslices; }
+   virtual int NumStoredEntries() const
+   { return nslices ? offsets[nslices]*C : 0; }
+
+   virtual void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+   virtual void AddMultTranspose(const Vector &x, Vector &y,
+                                 const double a = 1.0) const;
+
+   virtual ~SellCSMatrix();
+};
+
+}
+
+#endif
@@ -31,6 +31,18 @@ void SparseSmoother::SetOperator(const Operator &a)
    width = oper->Width();
 }
 
+void GSSmoother::SetMulticolor(bool use_multicolor)
+{
+   multicolor = use_multicolor;
+   if (multicolor && oper) { oper->GetRowColoring(colors); }
+}
+
+void GSSmoother::SetOperator(const Operator &a)
+{
+   SparseSmoother::SetOperator(a);
+   if (multicolor) { oper->GetRowColoring(colors); }
+}
+
 /// Matrix vector multiplication with GS Smoother.
 void GSSmoother::Mult(const Vector &x, Vector &y) const
 {
@@ -42,11 +54,13 @@ void GSSmoother::Mult(const Vector &x, Vector &y) const
    {
       if (type != 2)
       {
-         oper->Gauss_Seidel_forw(x, y);
+         if (multicolor) { oper->Gauss_Seidel_forw(x, y, colors); }
+         else { oper->Gauss_Seidel_forw(x, y); }
       }
       if (type != 1)
       {
-         oper->Gauss_Seidel_back(x, y);
+         if (multicolor) { oper->Gauss_Seidel_back(x, y, colors); }
+         else { oper->Gauss_Seidel_back(x, y); }
       }
    }
 }
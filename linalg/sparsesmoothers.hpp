@@ -38,14 +38,28 @@ class GSSmoother : public SparseSmoother
 protected:
    int type; // 0, 1, 2 - symmetric, forward, backward
    int iterations;
+   bool multicolor;
+   /// Coloring of the rows of the matrix, used when #multicolor is true.
+   Table colors;
 
 public:
    /// Create GSSmoother.
-   GSSmoother(int t = 0, int it = 1) { type = t; iterations = it; }
+   GSSmoother(int t = 0, int it = 1)
+   { type = t; iterations = it; multicolor = false; }
 
    /// Create GSSmoother.
    GSSmoother(const SparseMatrix &a, int t = 0, int it = 1)
-      : SparseSmoother(a) { type = t; iterations = it; }
+      : SparseSmoother(a) { type = t; iterations = it; multicolor = false; }
+
+   /** @brief Use the multicolor Gauss-Seidel iterations of SparseMatrix,
+       whose rows are relaxed one color at a time. */
+   /** The coloring, see SparseMatrix::GetRowColoring(), is computed once for
+       each operator. The rows of each color are relaxed in parallel when a
+       multithreaded host backend is enabled. The result depends on the
+       coloring and is different from the lexicographic Gauss-Seidel. */
+   void SetMulticolor(bool use_multicolor = true);
+
+   virtual void SetOperator(const Operator &a);
 
    /// Matrix vector multiplication with GS Smoother.
    virtual void Mult(const Vector &x, Vector &y) const;
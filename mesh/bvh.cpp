@@ -0,0 +1,325 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+ElementBVH::ElementBVH(int leaf_size_)
+   : sdim(0), leaf_size(leaf_size_), padding(0.02), sequence(-1),
+     nodes_moved(false)
+{
+   MFEM_VERIFY(leaf_size > 0, "invalid leaf size: " << leaf_size);
+}
+
+void ElementBVH::ComputeElementBoxes(Mesh &mesh)
+{
+   const int ne = mesh.GetNE();
+   sdim = mesh.SpaceDimension();
+   elem_box.SetSize(2*sdim*ne);
+
+   const GridFunction *mesh_nodes = mesh.GetNodes();
+   if (mesh_nodes) { mesh_nodes->HostRead(); }
+
+   IsoparametricTransformation T;
+   DenseMatrix pts;
+   for (int i = 0; i < ne; i++)
+   {
+      mesh.GetElementTransformation(i, &T);
+      double *bmin = elem_box + 2*sdim*i, *bmax = bmin + sdim;
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] = std::numeric_limits<double>::infinity();
+         bmax[d] = -bmin[d];
+      }
+      // The nodes (or vertices), and for meshes with nodes, the images of the
+      // points of a refined reference element. For order 1, these are the
+      // vertices, whose convex hull contains the multilinear elements.
+      for (int k = 0; k < 2; k++)
+      {
+         if (k == 1)
+         {
+            if (!mesh_nodes) { break; }
+            const int order = T.GetFE()->GetOrder();
+            RefinedGeometry *RefG = GlobGeometryRefiner.Refine(
+                                       mesh.GetElementBaseGeometry(i),
+                                       order > 1 ? 2*order : 1);
+            T.Transform(RefG->RefPts, pts);
+         }
+         const DenseMatrix &p = k ? pts : T.GetPointMat();
+         for (int j = 0; j < p.Width(); j++)
+         {
+            for (int d = 0; d < sdim; d++)
+            {
+               bmin[d] = std::min(bmin[d], p(d,j));
+               bmax[d] = std::max(bmax[d], p(d,j));
+            }
+         }
+      }
+      double extent = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         extent = std::max(extent, bmax[d] - bmin[d]);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] -= padding*extent;
+         bmax[d] += padding*extent;
+      }
+   }
+}
+
+void ElementBVH::BuildSubtree(int n, int first, int size)
+{
+   nodes[n].first = first;
+   nodes[n].size = size;
+   nodes[n].left = nodes[n].right = -1;
+   if (size <= leaf_size) { return; }
+
+   // Split along the longest extent of the box centers
+   const int sd = sdim;
+   const double *box = elem_box.GetData();
+   int *order = elem_order.GetData() + first;
+   int axis = 0;
+   double max_extent = -1.0;
+   for (int d = 0; d < sd; d++)
+   {
+      double cmin = std::numeric_limits<double>::infinity(), cmax = -cmin;
+      for (int k = 0; k < size; k++)
+      {
+         const double *b = box + 2*sd*order[k];
+         const double c = b[d] + b[sd+d];
+         cmin = std::min(cmin, c);
+         cmax = std::max(cmax, c);
+      }
+      if (cmax - cmin > max_extent) { max_extent = cmax - cmin; axis = d; }
+   }
+   const int mid = size/2;
+   std::nth_element(order, order + mid, order + size, [=](int a, int b)
+   {
+      const double *ba = box + 2*sd*a, *bb = box + 2*sd*b;
+      return ba[axis] + ba[sd+axis] < bb[axis] + bb[sd+axis];
+   });
+
+   const Node child = nodes[n];
+   const int left = nodes.Append(child) - 1;
+   const int right = nodes.Append(child) - 1;
+   nodes[n].left = left;
+   nodes[n].right = right;
+   BuildSubtree(left, first, mid);
+   BuildSubtree(right, first + mid, size - mid);
+}
+
+void ElementBVH::RefitNodes()
+{
+   node_box.SetSize(2*sdim*nodes.Size());
+   // The children are stored after their parents
+   for (int n = nodes.Size()-1; n >= 0; n--)
+   {
+      const Node &node = nodes[n];
+      double *bmin = node_box + 2*sdim*n, *bmax = bmin + sdim;
+      for (int d = 0; d < sdim; d++)
+      {
+         bmin[d] = std::numeric_limits<double>::infinity();
+         bmax[d] = -bmin[d];
+      }
+      const int nb = (node.left < 0) ? node.size : 2;
+      for (int k = 0; k < nb; k++)
+      {
+         const double *b = (node.left < 0) ?
+                           elem_box + 2*sdim*elem_order[node.first + k] :
+                           node_box + 2*sdim*(k ? node.right : node.left);
+         for (int d = 0; d < sdim; d++)
+         {
+            bmin[d] = std::min(bmin[d], b[d]);
+            bmax[d] = std::max(bmax[d], b[sdim+d]);
+         }
+      }
+   }
+}
+
+void ElementBVH::Build(Mesh &mesh)
+{
+   ComputeElementBoxes(mesh);
+   const int ne = mesh.GetNE();
+   elem_order.SetSize(ne);
+   for (int i = 0; i < ne; i++) { elem_order[i] = i; }
+   nodes.SetSize(1);
+   BuildSubtree(0, 0, ne);
+   RefitNodes();
+   sequence = mesh.GetSequence();
+   nodes_moved = false;
+}
+
+bool ElementBVH::UpdateRefined(Mesh &mesh)
+{
+   if (mesh.NURBSext) { return false; }
+   const Array<Embedding> &emb =
+      mesh.ncmesh ? mesh.ncmesh->GetRefinementTransforms().embeddings :
+      mesh.CoarseFineTr.embeddings;
+   const int ne = mesh.GetNE(), old_ne = elem_order.Size();
+   if (emb.Size() != ne) { return false; }
+
+   // Leaf of each coarse element
+   const int num_nodes = nodes.Size();
+   Array<int> elem_leaf(old_ne);
+   for (int n = 0; n < num_nodes; n++)
+   {
+      if (nodes[n].left >= 0) { continue; }
+      for (int k = 0; k < nodes[n].size; k++)
+      {
+         elem_leaf[elem_order[nodes[n].first + k]] = n;
+      }
+   }
+
+   // Group the fine elements by the leaf of their parent
+   Array<int> offsets(num_nodes + 1);
+   offsets = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      const int parent = emb[i].parent;
+      if (parent < 0 || parent >= old_ne) { return false; }
+      offsets[elem_leaf[parent] + 1]++;
+   }
+   offsets.PartialSum();
+   elem_order.SetSize(ne);
+   for (int i = 0; i < ne; i++)
+   {
+      elem_order[offsets[elem_leaf[emb[i].parent]]++] = i;
+   }
+   for (int n = num_nodes; n > 0; n--) { offsets[n] = offsets[n-1]; }
+   offsets[0] = 0;
+
+   // Replace each leaf with too many elements by a subtree
+   ComputeElementBoxes(mesh);
+   for (int n = 0; n < num_nodes; n++)
+   {
+      if (nodes[n].left >= 0) { continue; }
+      BuildSubtree(n, offsets[n], offsets[n+1] - offsets[n]);
+   }
+   RefitNodes();
+   sequence = mesh.GetSequence();
+   nodes_moved = false;
+   return true;
+}
+
+void ElementBVH::Update(Mesh &mesh)
+{
+   if (IsUpToDate(mesh)) { return; }
+   if (sequence == mesh.GetSequence() && elem_order.Size() == mesh.GetNE())
+   {
+      // Only the nodes were moved
+      ComputeElementBoxes(mesh);
+      RefitNodes();
+      nodes_moved = false;
+      return;
+   }
+   if (sequence >= 0 && mesh.GetSequence() == sequence + 1 &&
+       mesh.GetLastOperation() == Mesh::REFINE && UpdateRefined(mesh))
+   {
+      return;
+   }
+   Build(mesh);
+}
+
+bool ElementBVH::IsUpToDate(const Mesh &mesh) const
+{
+   return sequence == mesh.GetSequence() && !nodes_moved &&
+          elem_order.Size() == mesh.GetNE();
+}
+
+void ElementBVH::FindCandidates(const double *x, Array<int> &elems) const
+{
+   elems.SetSize(0);
+   if (elem_order.Size() == 0) { return; }
+
+   const int sd = sdim;
+   auto inside = [=](const double *b)
+   {
+      for (int d = 0; d < sd; d++)
+      {
+         if (x[d] < b[d] || x[d] > b[sd+d]) { return false; }
+      }
+      return true;
+   };
+
+   Array<int> stack;
+   stack.Append(0);
+   while (stack.Size())
+   {
+      const int n = stack.Last();
+      stack.DeleteLast();
+      if (!inside(node_box + 2*sd*n)) { continue; }
+      const Node &node = nodes[n];
+      if (node.left >= 0)
+      {
+         stack.Append(node.right);
+         stack.Append(node.left);
+         continue;
+      }
+      for (int k = 0; k < node.size; k++)
+      {
+         const int e = elem_order[node.first + k];
+         if (inside(elem_box + 2*sd*e)) { elems.Append(e); }
+      }
+   }
+
+   // Order the candidates by the distance from x to the centers of their
+   // boxes (insertion sort, the lists are short)
+   auto dist2 = [=](int e)
+   {
+      const double *b = elem_box + 2*sd*e;
+      double r2 = 0.0;
+      for (int d = 0; d < sd; d++)
+      {
+         const double dx = x[d] - 0.5*(b[d] + b[sd+d]);
+         r2 += dx*dx;
+      }
+      return r2;
+   };
+   for (int k = 1; k < elems.Size(); k++)
+   {
+      const int e = elems[k];
+      const double r2 = dist2(e);
+      int j = k;
+      for ( ; j > 0 && dist2(elems[j-1]) > r2; j--) { elems[j] = elems[j-1]; }
+      elems[j] = e;
+   }
+}
+
+int ElementBVH::GetDepth() const
+{
+   if (nodes.Size() == 0) { return 0; }
+   // The children are stored after their parents
+   Array<int> depth(nodes.Size());
+   depth[0] = 1;
+   int max_depth = 1;
+   for (int n = 0; n < nodes.Size(); n++)
+   {
+      max_depth = std::max(max_depth, depth[n]);
+      if (nodes[n].left < 0) { continue; }
+      depth[nodes[n].left] = depth[nodes[n].right] = depth[n] + 1;
+   }
+   return max_depth;
+}
+
+long ElementBVH::MemoryUsage() const
+{
+   return elem_box.MemoryUsage() + nodes.MemoryUsage() +
+          node_box.MemoryUsage() + elem_order.MemoryUsage();
+}
+
+} // namespace mfem
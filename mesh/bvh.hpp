@@ -0,0 +1,125 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BVH
+#define MFEM_BVH
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+
+namespace mfem
+{
+
+class Mesh;
+
+/** @brief Bounding volume hierarchy of the axis-aligned bounding boxes of the
+    elements of a Mesh, used for point location. */
+/** The bounding box of an element contains its nodes (the vertices, for meshes
+    without nodes). For meshes with nodes, it also contains the images of the
+    points of a refined reference element: the vertices for order 1, and a
+    grid of 2*order intervals per direction for curved elements. The boxes are
+    enlarged by a relative padding, see SetPadding(), which covers the parts of
+    curved elements between these points and the tolerance of the point
+    location.
+
+    The hierarchy is a binary tree built top-down by splitting the elements at
+    the median of their box centers along the longest extent of the centers.
+    The leaves hold up to a fixed number of elements.
+
+    After a refinement of the mesh, Update() replaces the elements in each leaf
+    by their children and only rebuilds the subtrees of the leaves that became
+    too large, instead of building a new tree. After the nodes are moved,
+    Update() only recomputes the boxes (refit). The Mesh keeps an instance
+    up to date, see Mesh::GetElementBVH(). */
+class ElementBVH
+{
+public:
+   /// Node of the tree.
+   struct Node
+   {
+      int left, right; ///< Children, -1 for a leaf
+      int first, size; ///< Range of the leaf elements in the element order
+   };
+
+protected:
+   int sdim;       // space dimension of the mesh
+   int leaf_size;  // maximum number of elements in a leaf
+   double padding; // padding of the element boxes, relative to their size
+   long sequence;  // mesh sequence when the tree was last built or updated
+   bool nodes_moved;
+
+   Array<double> elem_box; // 2*sdim entries per element: min, then max
+   Array<Node> nodes;      // nodes[0] is the root
+   Array<double> node_box; // 2*sdim entries per tree node
+   Array<int> elem_order;  // element indices, grouped by leaf
+
+   // Compute the boxes of all elements of @a mesh.
+   void ComputeElementBoxes(Mesh &mesh);
+
+   // Build the subtree of node @a n from the elements in elem_order[first,
+   // first+size), reordering them. Appends the nodes of the subtree.
+   void BuildSubtree(int n, int first, int size);
+
+   // Recompute the boxes of the tree nodes from the element boxes.
+   void RefitNodes();
+
+   // Update the tree after a refinement of the mesh; returns false if the
+   // refinement data does not match the current tree.
+   bool UpdateRefined(Mesh &mesh);
+
+public:
+   /// Create an empty tree with the given maximum number of elements per leaf.
+   ElementBVH(int leaf_size_ = 4);
+
+   /** @brief Set the padding of the element boxes, relative to their size.
+       The default is 0.02. Takes effect on the next Update() or Build(). */
+   void SetPadding(double rel_padding) { padding = rel_padding; }
+
+   /// Build the tree for the elements of @a mesh.
+   void Build(Mesh &mesh);
+
+   /// Bring the tree up to date with @a mesh.
+   /** If the mesh was refined once since the last update, the tree is updated
+       incrementally; if only the nodes were moved (see NodesMoved()), the boxes
+       are recomputed; otherwise, the tree is rebuilt. */
+   void Update(Mesh &mesh);
+
+   /** @brief Mark the boxes as out of date, e.g. after the mesh nodes were
+       moved. Called by the Mesh methods which modify the nodes. */
+   void NodesMoved() { nodes_moved = true; }
+
+   /// Return true if the tree matches the current state of @a mesh.
+   bool IsUpToDate(const Mesh &mesh) const;
+
+   /** @brief Return the elements whose boxes contain the point @a x, ordered
+       by the distance from @a x to the centers of their boxes. */
+   /** These are the elements tried by Mesh::FindPoints() for the point @a x.
+       This method is thread-safe. */
+   void FindCandidates(const double *x, Array<int> &elems) const;
+
+   /// Return the number of elements.
+   int GetNE() const { return elem_order.Size(); }
+
+   /// Return the bounding box of element @a i: min, then max coordinates.
+   const double *GetElementBox(int i) const { return elem_box + 2*sdim*i; }
+
+   /// Return the tree nodes; the entry 0 is the root.
+   const Array<Node> &GetNodes() const { return nodes; }
+
+   /// Return the depth of the tree (1 for a tree with a single leaf).
+   int GetDepth() const;
+
+   long MemoryUsage() const;
+};
+
+} // namespace mfem
+
+#endif
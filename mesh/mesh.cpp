@@ -18,6 +18,8 @@
 #include "../general/text.hpp"
 #include "../general/device.hpp"
 #include "../general/tic_toc.hpp"
+#include "../general/profiler.hpp"
+#include "../general/forall.hpp"
 #include "../general/gecko.hpp"
 #include "../fem/quadinterpolator.hpp"
 
@@ -29,6 +31,8 @@
 #include <cstring>
 #include <ctime>
 #include <functional>
+#include <typeinfo>
+#include <vector>
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -1007,6 +1011,9 @@ void Mesh::Init()
    NURBSext = NULL;
    ncmesh = NULL;
    last_operation = Mesh::NONE;
+   compact_storage = false;
+   compact_sequence = -1;
+   bvh = NULL;
 }
 
 void Mesh::InitTables()
@@ -1045,6 +1052,9 @@ void Mesh::DestroyPointers()
 
    delete NURBSext;
 
+   delete bvh;
+   bvh = NULL;
+
    for (int i = 0; i < NumOfElements; i++)
    {
       FreeElement(elements[i]);
@@ -1088,6 +1098,9 @@ void Mesh::Destroy()
    TetMemory.Clear();
 #endif
 
+   compact_elems.Clear();
+   compact_bdr.Clear();
+
    attributes.DeleteAll();
    bdr_attributes.DeleteAll();
 }
@@ -1131,6 +1144,84 @@ void Mesh::SetAttributes()
    {
       MFEM_WARNING("Non-positive attributes in the domain!");
    }
+
+   UpdateCompactStorage();
+}
+
+void Mesh::CompactElements::Build(const Array<Element*> &elem_array,
+                                  int num_elems)
+{
+   offsets.SetSize(num_elems + 1);
+   geometries.SetSize(num_elems);
+   attributes.SetSize(num_elems);
+   offsets[0] = 0;
+   for (int i = 0; i < num_elems; i++)
+   {
+      const Element *el = elem_array[i];
+      offsets[i+1] = offsets[i] + el->GetNVertices();
+      geometries[i] = el->GetGeometryType();
+      attributes[i] = el->GetAttribute();
+   }
+   vertices.SetSize(offsets[num_elems]);
+   for (int i = 0; i < num_elems; i++)
+   {
+      const int *v = elem_array[i]->GetVertices();
+      for (int j = offsets[i]; j < offsets[i+1]; j++)
+      {
+         vertices[j] = *v++;
+      }
+   }
+}
+
+void Mesh::CompactElements::Clear()
+{
+   offsets.DeleteAll();
+   vertices.DeleteAll();
+   attributes.DeleteAll();
+   geometries.DeleteAll();
+}
+
+long Mesh::CompactElements::MemoryUsage() const
+{
+   return offsets.MemoryUsage() + vertices.MemoryUsage() +
+          attributes.MemoryUsage() + geometries.MemoryUsage();
+}
+
+void Mesh::UpdateCompactStorage()
+{
+   if (!compact_storage) { return; }
+   compact_elems.Build(elements, NumOfElements);
+   compact_bdr.Build(boundary, NumOfBdrElements);
+   compact_sequence = sequence;
+}
+
+void Mesh::SetCompactStorage(bool enable)
+{
+   compact_storage = enable;
+   compact_sequence = -1;
+   if (enable)
+   {
+      UpdateCompactStorage();
+   }
+   else
+   {
+      compact_elems.Clear();
+      compact_bdr.Clear();
+   }
+}
+
+const Mesh::CompactElements &Mesh::GetCompactElements() const
+{
+   MFEM_VERIFY(CompactStorageValid(),
+               "compact storage is not enabled or not up to date");
+   return compact_elems;
+}
+
+const Mesh::CompactElements &Mesh::GetCompactBdrElements() const
+{
+   MFEM_VERIFY(CompactStorageValid(),
+               "compact storage is not enabled or not up to date");
+   return compact_bdr;
 }
 
 void Mesh::InitMesh(int _Dim, int _spaceDim, int NVert, int NElem, int NBdrElem)
@@ -1750,6 +1841,7 @@ void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 
    // Destroy tables that need to be rebuild
    DeleteTables();
+   UpdateCompactStorage();
 
    if (Dim > 1)
    {
@@ -1781,6 +1873,7 @@ void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
          Nodes->SetSubVector(new_dofs, *(old_elem_node_vals[old_elid]));
          delete old_elem_node_vals[old_elid];
       }
+      UpdateCompactStorage();
    }
 }
 
@@ -1933,6 +2026,7 @@ void Mesh::PrepareNodeReorder(DSTable **old_v_to_v, Table **old_elem_vert)
 
 void Mesh::DoNodeReorder(DSTable *old_v_to_v, Table *old_elem_vert)
 {
+   UpdateCompactStorage(); // the element vertices may have been reordered
    FiniteElementSpace *fes = Nodes->FESpace();
    const FiniteElementCollection *fec = fes->FEColl();
    Array<int> old_dofs, new_dofs;
@@ -2156,6 +2250,7 @@ void Mesh::DoNodeReorder(DSTable *old_v_to_v, Table *old_elem_vert)
    }
    // To force FE space update, we need to increase 'sequence':
    sequence++;
+   UpdateCompactStorage();
    last_operation = Mesh::NONE;
    fes->Update(false); // want_transform = false
    Nodes->Update(); // just needed to update Nodes->sequence
@@ -2276,6 +2371,7 @@ void Mesh::FinalizeMesh(int refine, bool fix_orientation)
 
 void Mesh::FinalizeTopology(bool generate_bdr)
 {
+   MFEM_PROFILE_REGION("Mesh::FinalizeTopology");
    // Requirements: the following should be defined:
    //   1) Dim
    //   2) NumOfElements, elements
@@ -2286,6 +2382,7 @@ void Mesh::FinalizeTopology(bool generate_bdr)
    //   3) el_to_edge may be allocated (it will be re-computed)
 
    FinalizeCheck();
+   UpdateCompactStorage();
    bool generate_edges = true;
 
    if (spaceDim == 0) { spaceDim = Dim; }
@@ -2350,6 +2447,7 @@ void Mesh::FinalizeTopology(bool generate_bdr)
 
 void Mesh::Finalize(bool refine, bool fix_orientation)
 {
+   MFEM_PROFILE_REGION("Mesh::Finalize");
    if (NURBSext || ncmesh)
    {
       MFEM_ASSERT(CheckElementOrientation(false) == 0, "");
@@ -2397,7 +2495,9 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
       }
       else
       {
-         FinalizeTopology(); // Re-computes some data unnecessarily.
+         // Re-computes some data unnecessarily. The boundary was generated (if
+         // needed) by the first call; a distributed piece may have none.
+         FinalizeTopology(false);
       }
 
       // TODO: maybe introduce Mesh::NODE_REORDER operation and FESpace::
@@ -2406,6 +2506,7 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
 
    // check and fix boundary element orientation
    CheckBdrElementOrientation();
+   UpdateCompactStorage();
 
 #ifdef MFEM_DEBUG
    // For non-orientable surfaces/manifolds, the check below will fail, so we
@@ -2901,6 +3002,9 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    // Create the new Mesh instance without a record of its refinement history
    sequence = 0;
    last_operation = Mesh::NONE;
+   compact_storage = mesh.compact_storage;
+   compact_sequence = -1;
+   bvh = NULL;
 
    // Duplicate the elements
    elements.SetSize(NumOfElements);
@@ -3003,6 +3107,8 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
       Nodes = mesh.Nodes;
       own_nodes = 0;
    }
+
+   UpdateCompactStorage();
 }
 
 Mesh::Mesh(const char *filename, int generate_edges, int refine,
@@ -3030,6 +3136,13 @@ Mesh::Mesh(std::istream &input, int generate_edges, int refine,
    Load(input, generate_edges, refine, fix_orientation);
 }
 
+Mesh::Mesh(BinaryReader &reader, int refine, bool fix_orientation)
+{
+   SetEmpty();
+   ReadMFEMBinary(reader, false);
+   Finalize(refine, fix_orientation);
+}
+
 void Mesh::ChangeVertexDataOwnership(double *vertex_data, int len_vertex_data,
                                      bool zerocopy)
 {
@@ -3274,6 +3387,13 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    {
       ReadNURBSMesh(input, curved, read_gf);
    }
+   else if (mesh_type == BinaryReader::magic) // MFEM's binary format
+   {
+      BinaryReader reader;
+      reader.Read(input);
+      ReadMFEMBinary(reader, true);
+      return; // done with the topology and the nodes
+   }
    else if (mesh_type == "MFEM INLINE mesh v1.0")
    {
       ReadInlineMesh(input, generate_edges);
@@ -4672,6 +4792,27 @@ Table *Mesh::GetVertexToElementTable()
 
    vert_elem->MakeI(NumOfVertices);
 
+   if (CompactStorageValid())
+   {
+      const int *ev = compact_elems.vertices.GetData();
+      const int nev = compact_elems.vertices.Size();
+      for (j = 0; j < nev; j++)
+      {
+         vert_elem->AddAColumnInRow(ev[j]);
+      }
+      vert_elem->MakeJ();
+      const int *offsets = compact_elems.offsets.GetData();
+      for (i = 0; i < NumOfElements; i++)
+      {
+         for (j = offsets[i]; j < offsets[i+1]; j++)
+         {
+            vert_elem->AddConnection(ev[j], i);
+         }
+      }
+      vert_elem->ShiftUpI();
+      return vert_elem;
+   }
+
    for (i = 0; i < NumOfElements; i++)
    {
       nv = elements[i]->GetNVertices();
@@ -4905,6 +5046,45 @@ void Mesh::GetElementArrayEdgeTable(const Array<Element*> &elem_array,
    el_to_edge.ShiftUpI();
 }
 
+// Return the number of edges of the reference element of the given geometry,
+// as returned by Element::GetNEdges(), and its edge to vertex pairs.
+static inline int GetGeometryEdges(Geometry::Type geom, const int *&ev)
+{
+   switch (geom)
+   {
+      case Geometry::TRIANGLE:    ev = Mesh::tri_t::Edges[0];  return 3;
+      case Geometry::SQUARE:      ev = Mesh::quad_t::Edges[0]; return 4;
+      case Geometry::TETRAHEDRON: ev = Mesh::tet_t::Edges[0];  return 6;
+      case Geometry::CUBE:        ev = Mesh::hex_t::Edges[0];  return 12;
+      case Geometry::PRISM:       ev = Mesh::pri_t::Edges[0];  return 9;
+      default:                    ev = NULL;                   return 0;
+   }
+}
+
+void Mesh::GetElementArrayEdgeTable(const CompactElements &elem_array,
+                                    const DSTable &v_to_v, Table &el_to_edge)
+{
+   const int ne = elem_array.Size();
+   const int *e;
+   el_to_edge.MakeI(ne);
+   for (int i = 0; i < ne; i++)
+   {
+      el_to_edge.AddColumnsInRow(
+         i, GetGeometryEdges(elem_array.geometries[i], e));
+   }
+   el_to_edge.MakeJ();
+   for (int i = 0; i < ne; i++)
+   {
+      const int *v = elem_array.GetVertices(i);
+      const int nedges = GetGeometryEdges(elem_array.geometries[i], e);
+      for (int j = 0; j < nedges; j++)
+      {
+         el_to_edge.AddConnection(i, v_to_v(v[e[2*j]], v[e[2*j+1]]));
+      }
+   }
+   el_to_edge.ShiftUpI();
+}
+
 void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
 {
    if (edge_vertex)
@@ -4915,6 +5095,19 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
          v_to_v.Push(v[0], v[1]);
       }
    }
+   else if (CompactStorageValid())
+   {
+      const int *e;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = compact_elems.GetVertices(i);
+         const int ne = GetGeometryEdges(compact_elems.geometries[i], e);
+         for (int j = 0; j < ne; j++)
+         {
+            v_to_v.Push(v[e[2*j]], v[e[2*j+1]]);
+         }
+      }
+   }
    else
    {
       for (int i = 0; i < NumOfElements; i++)
@@ -4940,7 +5133,15 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
    NumberOfEdges = v_to_v.NumberOfEntries();
 
    // Fill the element to edge table
-   GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   const bool compact = CompactStorageValid();
+   if (compact)
+   {
+      GetElementArrayEdgeTable(compact_elems, v_to_v, e_to_f);
+   }
+   else
+   {
+      GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   }
 
    if (Dim == 2)
    {
@@ -4948,7 +5149,8 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
       be_to_f.SetSize(NumOfBdrElements);
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         const int *v = boundary[i]->GetVertices();
+         const int *v = compact ? compact_bdr.GetVertices(i) :
+                        boundary[i]->GetVertices();
          be_to_f[i] = v_to_v(v[0], v[1]);
       }
    }
@@ -4958,7 +5160,14 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
       {
          bel_to_edge = new Table;
       }
-      GetElementArrayEdgeTable(boundary, v_to_v, *bel_to_edge);
+      if (compact)
+      {
+         GetElementArrayEdgeTable(compact_bdr, v_to_v, *bel_to_edge);
+      }
+      else
+      {
+         GetElementArrayEdgeTable(boundary, v_to_v, *bel_to_edge);
+      }
    }
    else
    {
@@ -5318,12 +5527,16 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    }
    el_to_face = new Table(NumOfElements, 6);  // must be 6 for hexahedra
    faces_tbl = new STable3D(NumOfVertices);
+   const bool compact = CompactStorageValid();
    for (i = 0; i < NumOfElements; i++)
    {
-      v = elements[i]->GetVertices();
-      switch (GetElementType(i))
+      const Geometry::Type geom = compact ? compact_elems.geometries[i] :
+                                  GetElementBaseGeometry(i);
+      v = compact ? compact_elems.vertices + compact_elems.offsets[i] :
+          elements[i]->GetVertices();
+      switch (geom)
       {
-         case Element::TETRAHEDRON:
+         case Geometry::TETRAHEDRON:
          {
             for (int j = 0; j < 4; j++)
             {
@@ -5333,7 +5546,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
             }
             break;
          }
-         case Element::WEDGE:
+         case Geometry::PRISM:
          {
             for (int j = 0; j < 2; j++)
             {
@@ -5349,7 +5562,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
             }
             break;
          }
-         case Element::HEXAHEDRON:
+         case Geometry::CUBE:
          {
             // find the face by the vertices with the smallest 3 numbers
             // z = 0, y = 0, x = 1, y = 1, x = 0, z = 1
@@ -5370,15 +5583,18 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    be_to_face.SetSize(NumOfBdrElements);
    for (i = 0; i < NumOfBdrElements; i++)
    {
-      v = boundary[i]->GetVertices();
-      switch (GetBdrElementType(i))
+      const Geometry::Type geom = compact ? compact_bdr.geometries[i] :
+                                  GetBdrElementBaseGeometry(i);
+      v = compact ? compact_bdr.vertices + compact_bdr.offsets[i] :
+          boundary[i]->GetVertices();
+      switch (geom)
       {
-         case Element::TRIANGLE:
+         case Geometry::TRIANGLE:
          {
             be_to_face[i] = (*faces_tbl)(v[0], v[1], v[2]);
             break;
          }
-         case Element::QUADRILATERAL:
+         case Geometry::SQUARE:
          {
             be_to_face[i] = (*faces_tbl)(v[0], v[1], v[2], v[3]);
             break;
@@ -5464,6 +5680,7 @@ void Mesh::ReorientTetMesh()
          Rotate3(v[0], v[1], v[2]);
       }
    }
+   UpdateCompactStorage();
 
    if (!Nodes)
    {
@@ -6300,6 +6517,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -6320,6 +6538,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -6359,6 +6578,7 @@ void Mesh::SetNode(int i, const double *coord)
       }
 
    }
+   NodesUpdated();
 }
 
 void Mesh::MoveNodes(const Vector &displacements)
@@ -6366,6 +6586,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    if (Nodes)
    {
       (*Nodes) += displacements;
+      NodesUpdated();
    }
    else
    {
@@ -6390,6 +6611,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    if (Nodes)
    {
       (*Nodes) = node_coord;
+      NodesUpdated();
    }
    else
    {
@@ -6409,6 +6631,7 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
       delete NURBSext;
       NURBSext = nodes.FESpace()->StealNURBSext();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
@@ -6419,6 +6642,7 @@ void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
    // NURBSext = (Nodes) ? Nodes->FESpace()->StealNURBSext() : NULL;
+   NodesUpdated();
 }
 
 void Mesh::AverageVertices(const int *indexes, int n, int result)
@@ -6593,6 +6817,7 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    if (update_nodes) { UpdateNodes(); }
 
@@ -7198,6 +7423,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    if (update_nodes) { UpdateNodes(); }
 }
@@ -7436,6 +7662,7 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 
@@ -7486,6 +7713,7 @@ void Mesh::NonconformingRefinement(const Array<Refinement> &refinements,
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    if (Nodes) // update/interpolate curved mesh
    {
@@ -7555,6 +7783,7 @@ bool Mesh::NonconformingDerefinement(Array<double> &elem_error,
 
    last_operation = Mesh::DEREFINE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 
@@ -7673,6 +7902,18 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    TetMemory.Swap(other.TetMemory);
 #endif
 
+   // The sequences are not swapped: the flat copies are updated by the caller
+   for (int k = 0; k < 2; k++)
+   {
+      CompactElements &a = k ? compact_bdr : compact_elems;
+      CompactElements &b = k ? other.compact_bdr : other.compact_elems;
+      mfem::Swap(a.offsets, b.offsets);
+      mfem::Swap(a.vertices, b.vertices);
+      mfem::Swap(a.attributes, b.attributes);
+      mfem::Swap(a.geometries, b.geometries);
+   }
+   compact_sequence = other.compact_sequence = -1;
+
    if (non_geometry)
    {
       mfem::Swap(NURBSext, other.NURBSext);
@@ -7680,7 +7921,12 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
 
       mfem::Swap(Nodes, other.Nodes);
       mfem::Swap(own_nodes, other.own_nodes);
+
+      mfem::Swap(bvh, other.bvh);
    }
+   // The element boxes are recomputed on the next use of the trees
+   NodesUpdated();
+   other.NodesUpdated();
 }
 
 void Mesh::GetElementData(const Array<Element*> &elem_array, int geom,
@@ -8574,6 +8820,64 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+void Mesh::PrintBinary(std::ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext, "NURBS meshes are not supported");
+   BinaryWriter writer;
+
+   const int sizes[6] = { Dim, spaceDim, NumOfVertices, NumOfElements,
+                          NumOfBdrElements, Nodes ? 1 : 0
+                        };
+   writer.AddSection("mesh", sizes, 6);
+
+   Array<int> geom[2], attr[2], vert[2];
+   for (int k = 0; k < 2; k++)
+   {
+      const Array<Element *> &elems = k ? boundary : elements;
+      const int ne = k ? NumOfBdrElements : NumOfElements;
+      geom[k].SetSize(ne);
+      attr[k].SetSize(ne);
+      for (int i = 0; i < ne; i++)
+      {
+         geom[k][i] = elems[i]->GetGeometryType();
+         attr[k][i] = elems[i]->GetAttribute();
+         vert[k].Append(elems[i]->GetVertices(), elems[i]->GetNVertices());
+      }
+      const string prefix = k ? "boundary_" : "element_";
+      writer.AddSection(prefix + "geometries", geom[k].GetData(), ne);
+      writer.AddSection(prefix + "attributes", attr[k].GetData(), ne);
+      writer.AddSection(prefix + "vertices", vert[k].GetData(),
+                        vert[k].Size());
+   }
+
+   if (ncmesh)
+   {
+      std::ostringstream ncmesh_out;
+      ncmesh->PrintVertexParents(ncmesh_out);
+      ncmesh->PrintCoarseElements(ncmesh_out);
+      writer.AddSection("ncmesh", ncmesh_out.str());
+   }
+
+   Vector coord(NumOfVertices*spaceDim);
+   for (int j = 0; j < NumOfVertices; j++)
+   {
+      for (int i = 0; i < spaceDim; i++)
+      {
+         coord(j*spaceDim + i) = vertices[j](i);
+      }
+   }
+   writer.AddSection("vertices", coord.GetData(), coord.Size());
+
+   if (Nodes)
+   {
+      std::ostringstream fes_out;
+      Nodes->FESpace()->Save(fes_out);
+      writer.AddSection("nodes_fespace", fes_out.str());
+      writer.AddSection("nodes", Nodes->HostRead(), Nodes->Size());
+   }
+   writer.Write(out);
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
    int i;
@@ -10064,6 +10368,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -10088,6 +10393,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -10170,6 +10476,7 @@ void Mesh::RemoveUnusedVertices()
       }
    }
    DeleteTables();
+   UpdateCompactStorage();
    if (Dim > 1)
    {
       // generate el_to_edge, be_to_edge (2D), bel_to_edge (3D)
@@ -10283,6 +10590,8 @@ void Mesh::RemoveInternalBoundaries()
    attribs.Unique();
    bdr_attributes.DeleteAll();
    attribs.Copy(bdr_attributes);
+
+   UpdateCompactStorage();
 }
 
 void Mesh::FreeElement(Element *E)
@@ -10310,6 +10619,13 @@ std::ostream &operator<<(std::ostream &out, const Mesh &mesh)
    return out;
 }
 
+ElementBVH &Mesh::GetElementBVH()
+{
+   if (!bvh) { bvh = new ElementBVH; }
+   bvh->Update(*this);
+   return *bvh;
+}
+
 int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
                      Array<IntegrationPoint>& ips, bool warn,
                      InverseElementTransformation *inv_trans)
@@ -10322,100 +10638,76 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
+   const ElementBVH &tree = GetElementBVH();
+   if (Nodes) { Nodes->HostRead(); }
    double *data = point_mat.GetData();
-   InverseElementTransformation *inv_tr = inv_trans;
-   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
-
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
-
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
-   {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
-      {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
-      }
-   }
+   InverseElementTransformation default_inv_tr;
+   InverseElementTransformation &inv_tr = inv_trans ? *inv_trans :
+                                          default_inv_tr;
 
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
+   // The threads use copies of inv_tr, so derived classes are processed by a
+   // single thread.
+   int nt = 1;
+#ifdef MFEM_THREAD_SAFE
+   if (typeid(inv_tr) == typeid(InverseElementTransformation))
    {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
+      nt = std::min(Device::NumHostThreads(), npts);
    }
-   if (pts_found != npts)
-   {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
+#endif
+   if (nt > 1)
+   {
+      // Invert the transformation of the first element of each geometry type
+      // serially, so that the shared data created on first use (e.g. the
+      // refined geometries of the initial guess) is available before the
+      // threads start.
+      Array<bool> geom_seen(Geometry::NumGeom);
+      geom_seen = false;
+      IsoparametricTransformation T;
+      Vector pt(spaceDim);
+      IntegrationPoint ip;
+      for (int i = 0; i < GetNE(); i++)
       {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
-         {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
+         const Geometry::Type geom = GetElementBaseGeometry(i);
+         if (geom_seen[geom]) { continue; }
+         geom_seen[geom] = true;
+         GetElementTransformation(i, &T);
+         T.Transform(Geometries.GetCenter(geom), pt);
+         inv_tr.SetTransformation(T);
+         inv_tr.Transform(pt, ip);
+      }
+   }
+   std::vector<InverseElementTransformation> thread_inv_tr(nt - 1, inv_tr);
+
+   // Try the elements whose bounding boxes contain the point, starting from
+   // the one whose box center is closest.
+   Array<int> found(nt);
+   found = 0;
+   HostParallelFor(nt, [&](int t)
+   {
+      InverseElementTransformation &it = t ? thread_inv_tr[t-1] : inv_tr;
+      IsoparametricTransformation T;
+      Array<int> candidates;
+      const int begin = (int)((long long)t*npts/nt);
+      const int end = (int)((long long)(t+1)*npts/nt);
+      for (int k = begin; k < end; k++)
+      {
+         Vector pt(data + k*spaceDim, spaceDim);
+         tree.FindCandidates(pt.GetData(), candidates);
+         for (int c = 0; c < candidates.Size(); c++)
+         {
+            GetElementTransformation(candidates[c], &T);
+            it.SetTransformation(T);
+            const int res = it.Transform(pt, ips[k]);
+            if (res == InverseElementTransformation::Inside)
             {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
-            }
-         }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
-         {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
-            {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
+               elem_ids[k] = candidates[c];
+               found[t]++;
+               break;
             }
          }
-      next_point: ;
       }
-      delete vtoel;
-   }
-   if (inv_trans == NULL) { delete inv_tr; }
+   });
+   const int pts_found = found.Sum();
 
    if (warn && pts_found != npts)
    {
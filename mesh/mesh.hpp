@@ -20,9 +20,11 @@
 #include "vertex.hpp"
 #include "vtk.hpp"
 #include "ncmesh.hpp"
+#include "bvh.hpp"
 #include "../fem/eltrans.hpp"
 #include "../fem/coefficient.hpp"
 #include "../general/zstr.hpp"
+#include "../general/binaryio.hpp"
 #ifdef MFEM_USE_ADIOS2
 #include "../general/adios2stream.hpp"
 #endif
@@ -57,6 +59,7 @@ class Mesh
 #endif
    friend class NCMesh;
    friend class NURBSExtension;
+   friend class ElementBVH;
 
 #ifdef MFEM_USE_ADIOS2
    friend class adios2stream;
@@ -190,6 +193,32 @@ public:
 
    enum Operation { NONE, REFINE, DEREFINE, REBALANCE };
 
+   /** @brief Flat (structure-of-arrays) copy of the connectivity of a set of
+       elements, see SetCompactStorage(). */
+   /** The vertices of element i are vertices[offsets[i]], ...,
+       vertices[offsets[i+1]-1], in the order of Element::GetVertices(). */
+   struct CompactElements
+   {
+      Array<int> offsets;  ///< Size: number of elements + 1.
+      Array<int> vertices; ///< Concatenated element vertices.
+      Array<int> attributes;
+      Array<Geometry::Type> geometries;
+
+      /// Return the number of elements.
+      int Size() const { return geometries.Size(); }
+
+      int GetNVertices(int i) const { return offsets[i+1] - offsets[i]; }
+
+      const int *GetVertices(int i) const { return vertices + offsets[i]; }
+
+      /// Copy the connectivity of the first @a num_elems of @a elem_array.
+      void Build(const Array<Element*> &elem_array, int num_elems);
+
+      void Clear();
+
+      long MemoryUsage() const;
+   };
+
    /// A list of all unique element attributes used by the Mesh.
    Array<int> attributes;
    /// A list of all unique boundary attributes used by the Mesh.
@@ -209,6 +238,16 @@ public:
 protected:
    Operation last_operation;
 
+   // Optional flat copies of the element and boundary element connectivity,
+   // valid while compact_sequence == sequence, see SetCompactStorage().
+   bool compact_storage;
+   long compact_sequence;
+   CompactElements compact_elems, compact_bdr;
+
+   // Spatial index of the elements used by FindPoints(), created on demand,
+   // see GetElementBVH().
+   ElementBVH *bvh;
+
    void Init();
    void InitTables();
    void SetEmpty();  // Init all data members with empty values
@@ -227,6 +266,9 @@ protected:
    // Readers for different mesh formats, used in the Load() method.
    // The implementations of these methods are in mesh_readers.cpp.
    void ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved);
+   // Read MFEM's binary format, including the nodes; with @a copy_nodes ==
+   // false, the nodes use the data of @a reader in place.
+   void ReadMFEMBinary(BinaryReader &reader, bool copy_nodes);
    void ReadLineMesh(std::istream &input);
    void ReadNetgen2DMesh(std::istream &input, int &curved);
    void ReadNetgen3DMesh(std::istream &input);
@@ -377,6 +419,20 @@ protected:
    static void GetElementArrayEdgeTable(const Array<Element*> &elem_array,
                                         const DSTable &v_to_v,
                                         Table &el_to_edge);
+   static void GetElementArrayEdgeTable(const CompactElements &elem_array,
+                                        const DSTable &v_to_v,
+                                        Table &el_to_edge);
+
+   /// Rebuild the flat connectivity copies, if compact storage is enabled.
+   void UpdateCompactStorage();
+
+   /// Return true if the flat connectivity copies are enabled and current.
+   bool CompactStorageValid() const
+   {
+      return compact_storage && compact_sequence == sequence &&
+             compact_elems.Size() == NumOfElements &&
+             compact_bdr.Size() == NumOfBdrElements;
+   }
 
    /** Return vertex to vertex table. The connections stored in the table
        are from smaller to bigger vertex index, i.e. if i<j and (i, j) is
@@ -657,6 +713,13 @@ public:
    explicit Mesh(std::istream &input, int generate_edges = 0, int refine = 1,
                  bool fix_orientation = true);
 
+   /** @brief Creates mesh from a container in MFEM's binary format, e.g. a
+       memory-mapped file, see PrintBinary() and BinaryReader::Map(). */
+   /** The nodes of a curved mesh use the data of @a reader in place, so
+       @a reader must not be destroyed before the mesh. */
+   explicit Mesh(BinaryReader &reader, int refine = 1,
+                 bool fix_orientation = true);
+
    /// Create a disjoint mesh from the given mesh array
    Mesh(Mesh *mesh_array[], int num_pieces);
 
@@ -853,6 +916,29 @@ public:
    void GetBdrElementVertices(int i, Array<int> &v) const
    { boundary[i]->GetVertices(v); }
 
+   /** @brief Enable or disable the flat (structure-of-arrays) storage of the
+       element and boundary element connectivity. */
+   /** When enabled, the mesh keeps contiguous offsets/vertices arrays and
+       per-element geometry and attribute arrays, in addition to the Element
+       objects, which remain the primary storage accessed by the rest of the
+       Mesh API. The flat arrays are used by the construction of the
+       connectivity tables, e.g. GetVertexToElementTable() and the element to
+       edge and element to face tables, avoiding virtual calls and pointer
+       chasing through the Element objects. They are rebuilt automatically
+       after finalization, refinement, derefinement, reordering and by
+       SetAttributes(); after modifying the Element objects directly, call
+       SetAttributes() or this method to update them. */
+   void SetCompactStorage(bool enable = true);
+
+   /// Return true if the flat connectivity storage is enabled.
+   bool UsesCompactStorage() const { return compact_storage; }
+
+   /// Return the flat element connectivity, see SetCompactStorage().
+   const CompactElements &GetCompactElements() const;
+
+   /// Return the flat boundary element connectivity, see SetCompactStorage().
+   const CompactElements &GetCompactBdrElements() const;
+
    /// Return the indices and the orientations of all edges of element i.
    void GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const;
 
@@ -1016,7 +1102,11 @@ public:
    int GetAttribute(int i) const { return elements[i]->GetAttribute(); }
 
    /// Set the attribute of element i.
-   void SetAttribute(int i, int attr) { elements[i]->SetAttribute(attr); }
+   void SetAttribute(int i, int attr)
+   {
+      elements[i]->SetAttribute(attr);
+      if (CompactStorageValid()) { compact_elems.attributes[i] = attr; }
+   }
 
    /// Return the attribute of boundary element i.
    int GetBdrAttribute(int i) const { return boundary[i]->GetAttribute(); }
@@ -1186,6 +1276,12 @@ public:
        Space uses this to construct a global interpolation matrix. */
    const CoarseFineTransformations &GetRefinementTransforms();
 
+   /** @brief Notify the mesh that its nodes (or vertices) were modified
+       directly, e.g. through the Vector returned by GetNodes(). */
+   /** The Mesh methods which modify the nodes call this method. It marks the
+       bounding boxes of the ElementBVH as out of date. */
+   void NodesUpdated() { if (bvh) { bvh->NodesMoved(); } }
+
    /// Return type of last modification of the mesh.
    Operation GetLastOperation() const { return last_operation; }
 
@@ -1202,6 +1298,14 @@ public:
    /// \see mfem::ofgzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using MFEM's binary format,
+       see BinaryWriter. */
+   /** The format has the same contents as the MFEM mesh v1.0 and v1.1 formats
+       (NURBS meshes are not supported), with the coordinates stored exactly.
+       It is detected by the Mesh constructors from files and streams. In
+       parallel, only the local part of the mesh is written. */
+   void PrintBinary(std::ostream &out) const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &out) const;
@@ -1326,12 +1430,25 @@ public:
 
        @returns The total number of points that were found.
 
+       The elements tried for each point are the ones whose bounding boxes
+       contain the point, see GetElementBVH(). If MFEM is configured with
+       MFEM_THREAD_SAFE, the points are processed by Device::NumHostThreads()
+       threads, each using its own copy of @a inv_trans; objects of classes
+       derived from InverseElementTransformation are used by a single thread.
+
        @note This method is not 100 percent reliable, i.e. it is not guaranteed
        to find a point, even if it lies inside a mesh element. */
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
                           InverseElementTransformation *inv_trans = NULL);
 
+   /** @brief Return the bounding volume hierarchy of the elements, brought up
+       to date with the current state of the mesh. */
+   /** The hierarchy is built on the first call and updated (incrementally,
+       after a refinement) on later calls. If the nodes are modified outside
+       the Mesh methods, call NodesUpdated() first. */
+   ElementBVH &GetElementBVH();
+
    /// Destroys Mesh.
    virtual ~Mesh() { DestroyPointers(); }
 
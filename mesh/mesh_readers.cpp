@@ -14,7 +14,9 @@
 #include "../general/text.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <cstdio>
+#include <algorithm>
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
@@ -113,6 +115,89 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+void Mesh::ReadMFEMBinary(BinaryReader &reader, bool copy_nodes)
+{
+   // Read MFEM binary v1.0 format, see PrintBinary()
+   int n;
+   const int *sizes = reader.GetInts("mesh", n);
+   MFEM_VERIFY(n == 6, "invalid MFEM binary mesh");
+   Dim = sizes[0];
+   spaceDim = sizes[1];
+   NumOfElements = sizes[3];
+   NumOfBdrElements = sizes[4];
+   const bool curved = (sizes[5] != 0);
+
+   for (int k = 0; k < 2; k++)
+   {
+      const string prefix = k ? "boundary_" : "element_";
+      const int ne = k ? NumOfBdrElements : NumOfElements;
+      int ng, na, nvert;
+      const int *geom = reader.GetInts(prefix + "geometries", ng);
+      const int *attr = reader.GetInts(prefix + "attributes", na);
+      const int *vert = reader.GetInts(prefix + "vertices", nvert);
+      MFEM_VERIFY(ng == ne && na == ne, "invalid MFEM binary mesh");
+      Array<Element *> &elems = k ? boundary : elements;
+      elems.SetSize(ne);
+      for (int i = 0, pos = 0; i < ne; i++)
+      {
+         Element *el = NewElement(geom[i]);
+         const int nv = el->GetNVertices();
+         MFEM_VERIFY(pos + nv <= nvert, "invalid MFEM binary mesh");
+         el->SetVertices(vert + pos);
+         el->SetAttribute(attr[i]);
+         elems[i] = el;
+         pos += nv;
+      }
+   }
+
+   if (reader.HasSection("ncmesh"))
+   {
+      // The same text as the sections 'vertex_parents' and 'coarse_elements'
+      // of the MFEM mesh v1.1 format
+      std::istringstream ncmesh_input(reader.GetString("ncmesh"));
+      ncmesh = new NCMesh(this, &ncmesh_input);
+      ncmesh->LoadCoarseElements(ncmesh_input);
+   }
+
+   int nc;
+   const double *coord = reader.GetDoubles("vertices", nc);
+   NumOfVertices = sizes[2];
+   MFEM_VERIFY(nc == NumOfVertices*spaceDim, "invalid MFEM binary mesh");
+   vertices.SetSize(NumOfVertices);
+   for (int j = 0; j < NumOfVertices; j++)
+   {
+      for (int i = 0; i < spaceDim; i++)
+      {
+         vertices[j](i) = coord[j*spaceDim + i];
+      }
+   }
+   if (ncmesh && !curved) { ncmesh->SetVertexPositions(vertices); }
+
+   FinalizeTopology();
+
+   if (curved)
+   {
+      std::istringstream fes_input(reader.GetString("nodes_fespace"));
+      FiniteElementSpace *nfes = new FiniteElementSpace;
+      FiniteElementCollection *nfec = nfes->Load(this, fes_input);
+      int nd;
+      double *nodes = reader.GetDoubles("nodes", nd);
+      MFEM_VERIFY(nd == nfes->GetVSize(), "invalid MFEM binary mesh");
+      if (copy_nodes)
+      {
+         Nodes = new GridFunction(nfes);
+         std::copy(nodes, nodes + nd, Nodes->HostWrite());
+      }
+      else
+      {
+         Nodes = new GridFunction(nfes, nodes);
+      }
+      Nodes->MakeOwner(nfec);
+      own_nodes = 1;
+      if (ncmesh) { ncmesh->spaceDim = spaceDim; }
+   }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
@@ -22,6 +22,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 using namespace std;
 
@@ -1057,6 +1060,1138 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+// Global key of an entity (vertex, edge or face) of a distributed mesh piece:
+// its sorted global vertex numbers, padded with -1. The fields 'elem' and
+// 'loc' identify the entity locally, e.g. the element and its local face.
+struct PieceEntity
+{
+   long key[4];
+   int elem, loc;
+
+   bool operator<(const PieceEntity &e) const
+   { return std::lexicographical_compare(key, key + 4, e.key, e.key + 4); }
+
+   bool SameKey(const PieceEntity &e) const
+   { return std::equal(key, key + 4, e.key); }
+};
+
+// Enumerates the faces (codimension 1 entities) of the elements of a mesh
+// piece: faces in 3D, edges in 2D and vertices in 1D.
+class PieceFaces
+{
+   const int dim;
+   Element *ref[Geometry::NumGeom];
+
+public:
+   PieceFaces(int dim_) : dim(dim_)
+   {
+      for (int g = 0; g < Geometry::NumGeom; g++) { ref[g] = NULL; }
+      ref[Geometry::SEGMENT] = new Segment;
+      ref[Geometry::TRIANGLE] = new Triangle;
+      ref[Geometry::SQUARE] = new Quadrilateral;
+      ref[Geometry::TETRAHEDRON] = new Tetrahedron;
+      ref[Geometry::CUBE] = new Hexahedron;
+      ref[Geometry::PRISM] = new Wedge;
+   }
+
+   int NumFaces(int geom) const
+   {
+      MFEM_VERIFY(ref[geom] && Geometry::Dimension[geom] == dim,
+                  "invalid element geometry: " << geom);
+      return (dim == 1) ? 2 :
+             (dim == 2) ? ref[geom]->GetNEdges() : ref[geom]->GetNFaces();
+   }
+
+   /// The vertices of face @a f, as indices in the vertex list of the element
+   int FaceVertices(int geom, int f, const int *&fv) const
+   {
+      static const int seg_faces[2] = { 0, 1 };
+      if (dim == 1) { fv = seg_faces + f; return 1; }
+      if (dim == 2) { fv = ref[geom]->GetEdgeVertices(f); return 2; }
+      fv = ref[geom]->GetFaceVertices(f);
+      return ref[geom]->GetNFaceVertices(f);
+   }
+
+   /// Set the key of face @a f of an element with global vertices @a gv
+   void GetKey(int geom, const long *gv, int f, PieceEntity &ent) const
+   {
+      const int *fv;
+      const int nfv = FaceVertices(geom, f, fv);
+      for (int i = 0; i < 4; i++) { ent.key[i] = (i < nfv) ? gv[fv[i]] : -1; }
+      std::sort(ent.key, ent.key + nfv);
+   }
+
+   ~PieceFaces()
+   {
+      for (int g = 0; g < Geometry::NumGeom; g++) { delete ref[g]; }
+   }
+};
+
+// Return the global vertex numbers of element (or boundary element) 'el'
+static void GetGlobalVertices(const Element *el, const Array<long> &vert_global,
+                              Array<long> &gv)
+{
+   Array<int> v;
+   el->GetVertices(v);
+   gv.SetSize(v.Size());
+   for (int i = 0; i < v.Size(); i++) { gv[i] = vert_global[v[i]]; }
+}
+
+// Return the key of the boundary element 'be' with global vertices 'gv'
+static void GetBdrKey(const Array<long> &gv, PieceEntity &ent)
+{
+   for (int i = 0; i < 4; i++) { ent.key[i] = (i < gv.Size()) ? gv[i] : -1; }
+   std::sort(ent.key, ent.key + gv.Size());
+}
+
+// Interleave the bits of the integer coordinates 'c' into a Morton key
+static std::uint64_t MortonKey(const unsigned *c, int dim, int bits)
+{
+   std::uint64_t key = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int d = 0; d < dim; d++)
+      {
+         key = (key << 1) | ((c[d] >> b) & 1u);
+      }
+   }
+   return key;
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+                 const Array<long> &vert_global, bool repartition, bool refine)
+   : gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   ncmesh = pncmesh = NULL;
+
+   MFEM_VERIFY(local_mesh.Conforming() && !local_mesh.NURBSext &&
+               !local_mesh.GetNodes(),
+               "only straight-sided conforming meshes are supported");
+   MFEM_VERIFY(vert_global.Size() == local_mesh.GetNV(),
+               "the size of vert_global must match the number of vertices");
+
+   // pieces may be empty on some ranks
+   int dims[2] = { local_mesh.Dimension(), local_mesh.SpaceDimension() };
+   MPI_Allreduce(MPI_IN_PLACE, dims, 2, MPI_INT, MPI_MAX, MyComm);
+   Dim = dims[0];
+   spaceDim = dims[1];
+
+   long num_global_verts = 0;
+   for (int i = 0; i < vert_global.Size(); i++)
+   {
+      num_global_verts = std::max(num_global_verts, vert_global[i] + 1);
+   }
+   MPI_Allreduce(MPI_IN_PLACE, &num_global_verts, 1, MPI_LONG, MPI_MAX,
+                 MyComm);
+
+   if (repartition)
+   {
+      Array<long> new_vert_global;
+      Mesh *piece = RedistributePiece(local_mesh, vert_global,
+                                      new_vert_global);
+      BuildFromPiece(*piece, new_vert_global, num_global_verts, refine);
+      delete piece;
+   }
+   else
+   {
+      BuildFromPiece(local_mesh, vert_global, num_global_verts, refine);
+   }
+}
+
+Mesh *ParMesh::RedistributePiece(const Mesh &piece,
+                                 const Array<long> &vert_global,
+                                 Array<long> &new_vert_global) const
+{
+   const int ne = piece.GetNE(), nbe = piece.GetNBE(), nv = piece.GetNV();
+   const int sdim = spaceDim;
+
+   // 1. Bounding box of the global mesh
+   Vector bb_min(sdim), bb_max(sdim);
+   bb_min = infinity();
+   bb_max = -infinity();
+   for (int i = 0; i < nv; i++)
+   {
+      const double *x = piece.GetVertex(i);
+      for (int d = 0; d < sdim; d++)
+      {
+         bb_min(d) = std::min(bb_min(d), x[d]);
+         bb_max(d) = std::max(bb_max(d), x[d]);
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, bb_min.GetData(), sdim, MPI_DOUBLE, MPI_MIN,
+                 MyComm);
+   MPI_Allreduce(MPI_IN_PLACE, bb_max.GetData(), sdim, MPI_DOUBLE, MPI_MAX,
+                 MyComm);
+
+   // 2. Morton keys of the element centers
+   const int bits = std::min(31, 63/sdim);
+   const double scale = double((std::uint64_t(1) << bits) - 1);
+   std::vector<std::uint64_t> sfc_key(ne);
+   Array<int> v;
+   for (int e = 0; e < ne; e++)
+   {
+      piece.GetElementVertices(e, v);
+      unsigned c[3];
+      for (int d = 0; d < sdim; d++)
+      {
+         double xc = 0.0;
+         for (int j = 0; j < v.Size(); j++) { xc += piece.GetVertex(v[j])[d]; }
+         xc /= v.Size();
+         const double h = bb_max(d) - bb_min(d);
+         const double t = (h > 0.0) ? (xc - bb_min(d))/h : 0.0;
+         c[d] = unsigned(std::min(std::max(t, 0.0), 1.0)*scale);
+      }
+      sfc_key[e] = MortonKey(c, sdim, bits);
+   }
+
+   // 3. Find the splitters of the global key sequence by bisection: the first
+   //    'PartitionFirstIndex' elements in key order go to the lower ranks
+   long total_ne = ne;
+   MPI_Allreduce(MPI_IN_PLACE, &total_ne, 1, MPI_LONG, MPI_SUM, MyComm);
+
+   std::vector<std::uint64_t> sorted_key(sfc_key);
+   std::sort(sorted_key.begin(), sorted_key.end());
+
+   const int nsplit = NRanks - 1;
+   std::vector<std::uint64_t> lo(nsplit, 0), hi(nsplit, std::uint64_t(1) << 63);
+   Array<long> count(nsplit);
+   while (true)
+   {
+      bool done = true;
+      for (int k = 0; k < nsplit; k++) { if (lo[k] < hi[k]) { done = false; } }
+      if (done) { break; }
+
+      // number of keys smaller than the midpoints
+      for (int k = 0; k < nsplit; k++)
+      {
+         const std::uint64_t mid = lo[k] + (hi[k] - lo[k])/2;
+         count[k] = std::lower_bound(sorted_key.begin(), sorted_key.end(),
+                                     mid) - sorted_key.begin();
+      }
+      MPI_Allreduce(MPI_IN_PLACE, count.GetData(), nsplit, MPI_LONG, MPI_SUM,
+                    MyComm);
+      for (int k = 0; k < nsplit; k++)
+      {
+         const std::uint64_t mid = lo[k] + (hi[k] - lo[k])/2;
+         const long target = ((k+1)*total_ne + NRanks-1)/NRanks;
+         if (count[k] >= target) { hi[k] = mid; }
+         else { lo[k] = mid + 1; }
+      }
+   }
+   std::vector<std::uint64_t>().swap(sorted_key);
+
+   Array<int> el_rank(ne);
+   for (int e = 0; e < ne; e++)
+   {
+      el_rank[e] = int(std::upper_bound(lo.begin(), lo.end(), sfc_key[e])
+                       - lo.begin());
+   }
+
+   // 4. The boundary elements go with the element they are a face of
+   PieceFaces piece_faces(Dim);
+   std::vector<PieceEntity> faces;
+   Array<long> gv;
+   for (int e = 0; e < ne; e++)
+   {
+      const int geom = piece.GetElementBaseGeometry(e);
+      GetGlobalVertices(piece.GetElement(e), vert_global, gv);
+      for (int f = 0; f < piece_faces.NumFaces(geom); f++)
+      {
+         PieceEntity ent;
+         piece_faces.GetKey(geom, gv.GetData(), f, ent);
+         ent.elem = e;
+         ent.loc = f;
+         faces.push_back(ent);
+      }
+   }
+   std::sort(faces.begin(), faces.end());
+
+   Array<int> be_rank(nbe);
+   for (int i = 0; i < nbe; i++)
+   {
+      PieceEntity ent;
+      GetGlobalVertices(piece.GetBdrElement(i), vert_global, gv);
+      GetBdrKey(gv, ent);
+      std::vector<PieceEntity>::iterator it =
+         std::lower_bound(faces.begin(), faces.end(), ent);
+      MFEM_VERIFY(it != faces.end() && it->SameKey(ent),
+                  "boundary element " << i << " is not a face of an element "
+                  "of the local piece");
+      be_rank[i] = el_rank[it->elem];
+   }
+   std::vector<PieceEntity>().swap(faces);
+
+   // 5. Pack the elements, boundary elements and vertices for each rank as:
+   //    ne, nbe, nv, (attr, geom, global vertices) x (ne + nbe), global
+   //    vertex numbers x nv, plus the vertex coordinates
+   std::vector<std::vector<long> > send_int(NRanks);
+   std::vector<std::vector<double> > send_dbl(NRanks);
+   Table rank_elem, rank_bdr;
+   Transpose(el_rank, rank_elem, NRanks);
+   Transpose(be_rank, rank_bdr, NRanks);
+
+   Array<int> vert_mark(nv);
+   vert_mark = -1;
+   for (int r = 0; r < NRanks; r++)
+   {
+      const int rne = rank_elem.RowSize(r), rnbe = rank_bdr.RowSize(r);
+      if (rne == 0) { continue; }
+      std::vector<long> &buf = send_int[r];
+      buf.push_back(rne);
+      buf.push_back(rnbe);
+      buf.push_back(0);
+
+      Array<int> rverts;
+      for (int k = 0; k < rne; k++)
+      {
+         const int e = rank_elem.GetRow(r)[k];
+         const Element *el = piece.GetElement(e);
+         el->GetVertices(v);
+         buf.push_back(el->GetAttribute());
+         buf.push_back(el->GetGeometryType());
+         for (int j = 0; j < v.Size(); j++)
+         {
+            buf.push_back(vert_global[v[j]]);
+            if (vert_mark[v[j]] != r)
+            {
+               vert_mark[v[j]] = r;
+               rverts.Append(v[j]);
+            }
+         }
+      }
+      for (int k = 0; k < rnbe; k++)
+      {
+         const Element *be = piece.GetBdrElement(rank_bdr.GetRow(r)[k]);
+         be->GetVertices(v);
+         buf.push_back(be->GetAttribute());
+         buf.push_back(be->GetGeometryType());
+         for (int j = 0; j < v.Size(); j++)
+         {
+            buf.push_back(vert_global[v[j]]);
+         }
+      }
+      buf[2] = rverts.Size();
+      for (int j = 0; j < rverts.Size(); j++)
+      {
+         buf.push_back(vert_global[rverts[j]]);
+         const double *x = piece.GetVertex(rverts[j]);
+         send_dbl[r].insert(send_dbl[r].end(), x, x + sdim);
+      }
+   }
+
+   // 6. Exchange the data
+   Array<int> send_cnt(2*NRanks), recv_cnt(2*NRanks);
+   for (int r = 0; r < NRanks; r++)
+   {
+      send_cnt[2*r] = int(send_int[r].size());
+      send_cnt[2*r+1] = int(send_dbl[r].size());
+   }
+   MPI_Alltoall(send_cnt.GetData(), 2, MPI_INT, recv_cnt.GetData(), 2,
+                MPI_INT, MyComm);
+
+   Array<int> sint_cnt(NRanks), sint_off(NRanks+1), sdbl_cnt(NRanks),
+         sdbl_off(NRanks+1), rint_cnt(NRanks), rint_off(NRanks+1),
+         rdbl_cnt(NRanks), rdbl_off(NRanks+1);
+   sint_off[0] = sdbl_off[0] = rint_off[0] = rdbl_off[0] = 0;
+   for (int r = 0; r < NRanks; r++)
+   {
+      sint_cnt[r] = send_cnt[2*r];
+      sdbl_cnt[r] = send_cnt[2*r+1];
+      rint_cnt[r] = recv_cnt[2*r];
+      rdbl_cnt[r] = recv_cnt[2*r+1];
+      sint_off[r+1] = sint_off[r] + sint_cnt[r];
+      sdbl_off[r+1] = sdbl_off[r] + sdbl_cnt[r];
+      rint_off[r+1] = rint_off[r] + rint_cnt[r];
+      rdbl_off[r+1] = rdbl_off[r] + rdbl_cnt[r];
+   }
+
+   Array<long> sint_buf(sint_off[NRanks]), rint_buf(rint_off[NRanks]);
+   Vector sdbl_buf(sdbl_off[NRanks]), rdbl_buf(rdbl_off[NRanks]);
+   for (int r = 0; r < NRanks; r++)
+   {
+      std::copy(send_int[r].begin(), send_int[r].end(),
+                sint_buf.GetData() + sint_off[r]);
+      std::copy(send_dbl[r].begin(), send_dbl[r].end(),
+                sdbl_buf.GetData() + sdbl_off[r]);
+      std::vector<long>().swap(send_int[r]);
+      std::vector<double>().swap(send_dbl[r]);
+   }
+   MPI_Alltoallv(sint_buf.GetData(), sint_cnt.GetData(), sint_off.GetData(),
+                 MPI_LONG, rint_buf.GetData(), rint_cnt.GetData(),
+                 rint_off.GetData(), MPI_LONG, MyComm);
+   MPI_Alltoallv(sdbl_buf.GetData(), sdbl_cnt.GetData(), sdbl_off.GetData(),
+                 MPI_DOUBLE, rdbl_buf.GetData(), rdbl_cnt.GetData(),
+                 rdbl_off.GetData(), MPI_DOUBLE, MyComm);
+   sint_buf.DeleteAll();
+   sdbl_buf.Destroy();
+
+   // 7. Unpack: first the vertices, sorted by their global numbers
+   int new_ne = 0;
+   Array<Pair<long, int> > new_verts; // global number, coordinate offset
+   Array<int> el_pos, be_pos; // positions of the elements in rint_buf
+   for (int r = 0; r < NRanks; r++)
+   {
+      if (rint_cnt[r] == 0) { continue; }
+      const long *buf = rint_buf.GetData() + rint_off[r];
+      const int rne = int(buf[0]), rnbe = int(buf[1]), rnv = int(buf[2]);
+      int pos = 3;
+      for (int k = 0; k < rne + rnbe; k++)
+      {
+         (k < rne ? el_pos : be_pos).Append(rint_off[r] + pos);
+         pos += 2 + Geometry::NumVerts[buf[pos+1]];
+      }
+      for (int j = 0; j < rnv; j++)
+      {
+         new_verts.Append(Pair<long, int>(buf[pos+j],
+                                          rdbl_off[r] + j*sdim));
+      }
+      new_ne += rne;
+   }
+   SortPairs<long, int>(new_verts, new_verts.Size());
+
+   new_vert_global.SetSize(0);
+   Array<int> new_vert_coord;
+   for (int i = 0; i < new_verts.Size(); i++)
+   {
+      if (i == 0 || new_verts[i].one != new_verts[i-1].one)
+      {
+         new_vert_global.Append(new_verts[i].one);
+         new_vert_coord.Append(new_verts[i].two);
+      }
+   }
+   new_verts.DeleteAll();
+
+   // boundary elements received from several ranks (on faces of elements
+   // from different pieces) are kept once
+   std::vector<PieceEntity> bdr_keys(be_pos.Size());
+   for (int i = 0; i < be_pos.Size(); i++)
+   {
+      const long *be = rint_buf.GetData() + be_pos[i];
+      const int nbv = Geometry::NumVerts[be[1]];
+      gv.SetSize(nbv);
+      for (int j = 0; j < nbv; j++) { gv[j] = be[2+j]; }
+      GetBdrKey(gv, bdr_keys[i]);
+      bdr_keys[i].elem = i;
+   }
+   std::sort(bdr_keys.begin(), bdr_keys.end());
+   Array<int> new_bdr;
+   for (size_t i = 0; i < bdr_keys.size(); i++)
+   {
+      if (i == 0 || !bdr_keys[i].SameKey(bdr_keys[i-1]))
+      {
+         new_bdr.Append(be_pos[bdr_keys[i].elem]);
+      }
+   }
+   std::vector<PieceEntity>().swap(bdr_keys);
+   new_bdr.Sort(); // keep the order of arrival
+
+   const int new_nv = new_vert_global.Size();
+   Mesh *new_piece = new Mesh(Dim, new_nv, new_ne, new_bdr.Size(), sdim);
+   for (int i = 0; i < new_nv; i++)
+   {
+      new_piece->AddVertex(rdbl_buf.GetData() + new_vert_coord[i]);
+   }
+   for (int k = 0; k < el_pos.Size() + new_bdr.Size(); k++)
+   {
+      const bool is_el = k < el_pos.Size();
+      const long *data = rint_buf.GetData() +
+                         (is_el ? el_pos[k] : new_bdr[k - el_pos.Size()]);
+      Element *el = new_piece->NewElement(int(data[1]));
+      el->SetAttribute(int(data[0]));
+      int *ev = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         const long *it = std::lower_bound(new_vert_global.begin(),
+                                           new_vert_global.end(), data[2+j]);
+         ev[j] = int(it - new_vert_global.begin());
+      }
+      if (is_el) { new_piece->AddElement(el); }
+      else { new_piece->AddBdrElement(el); }
+   }
+
+   return new_piece;
+}
+
+void ParMesh::FindSharingRanks(int key_size, const Array<long> &keys,
+                               long num_global_verts, Table &ranks) const
+{
+   const int nkeys = keys.Size()/key_size;
+
+   // Send each key to its home rank in the directory, which is determined by
+   // the first (i.e. smallest) global vertex number of the key
+   Array<int> home(nkeys), send_cnt(NRanks), send_off(NRanks+1);
+   send_cnt = 0;
+   for (int i = 0; i < nkeys; i++)
+   {
+      home[i] = int(keys[i*key_size] * NRanks / num_global_verts);
+      send_cnt[home[i]] += key_size;
+   }
+   send_off[0] = 0;
+   for (int r = 0; r < NRanks; r++)
+   {
+      send_off[r+1] = send_off[r] + send_cnt[r];
+   }
+
+   Array<long> send_buf(send_off[NRanks]);
+   Array<int> slot_key(nkeys); // the key sent in each slot of send_buf
+   {
+      Array<int> pos(NRanks);
+      for (int r = 0; r < NRanks; r++) { pos[r] = send_off[r]; }
+      for (int i = 0; i < nkeys; i++)
+      {
+         const int p = pos[home[i]];
+         pos[home[i]] += key_size;
+         for (int k = 0; k < key_size; k++)
+         {
+            send_buf[p+k] = keys[i*key_size+k];
+         }
+         slot_key[p/key_size] = i;
+      }
+   }
+
+   Array<int> recv_cnt(NRanks), recv_off(NRanks+1);
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT, recv_cnt.GetData(), 1, MPI_INT,
+                MyComm);
+   recv_off[0] = 0;
+   for (int r = 0; r < NRanks; r++)
+   {
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+
+   Array<long> recv_buf(recv_off[NRanks]);
+   MPI_Alltoallv(send_buf.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 MPI_LONG, recv_buf.GetData(), recv_cnt.GetData(),
+                 recv_off.GetData(), MPI_LONG, MyComm);
+
+   // At the home rank: sort the received keys, the keys received from several
+   // ranks correspond to shared entities
+   const int nrecv = recv_off[NRanks]/key_size;
+   Array<int> src(nrecv), perm(nrecv);
+   for (int r = 0; r < NRanks; r++)
+   {
+      for (int s = recv_off[r]/key_size; s < recv_off[r+1]/key_size; s++)
+      {
+         src[s] = r;
+      }
+   }
+   for (int s = 0; s < nrecv; s++) { perm[s] = s; }
+
+   const long *rkey = recv_buf.GetData();
+   std::sort(perm.begin(), perm.end(), [&](int a, int b)
+   {
+      const long *ka = rkey + a*key_size, *kb = rkey + b*key_size;
+      if (std::equal(ka, ka + key_size, kb)) { return src[a] < src[b]; }
+      return std::lexicographical_compare(ka, ka + key_size, kb, kb + key_size);
+   });
+
+   // the run of equal keys in 'perm' of each received key
+   Array<int> run_begin(nrecv), run_size(nrecv);
+   for (int i = 0; i < nrecv; )
+   {
+      const long *ki = rkey + perm[i]*key_size;
+      int j = i + 1;
+      while (j < nrecv &&
+             std::equal(ki, ki + key_size, rkey + perm[j]*key_size))
+      {
+         j++;
+      }
+      for (int k = i; k < j; k++)
+      {
+         run_begin[perm[k]] = i;
+         run_size[perm[k]] = j - i;
+      }
+      i = j;
+   }
+
+   // Reply to each rank, for each of its keys in the order received, with the
+   // number of ranks having the key followed by the ranks
+   Array<int> reply_cnt(NRanks), reply_off(NRanks+1);
+   reply_off[0] = 0;
+   for (int r = 0; r < NRanks; r++)
+   {
+      reply_cnt[r] = 0;
+      for (int s = recv_off[r]/key_size; s < recv_off[r+1]/key_size; s++)
+      {
+         reply_cnt[r] += 1 + run_size[s];
+      }
+      reply_off[r+1] = reply_off[r] + reply_cnt[r];
+   }
+   Array<int> reply_buf(reply_off[NRanks]);
+   for (int s = 0, p = 0; s < nrecv; s++)
+   {
+      reply_buf[p++] = run_size[s];
+      for (int k = 0; k < run_size[s]; k++)
+      {
+         reply_buf[p++] = src[perm[run_begin[s] + k]];
+      }
+   }
+   recv_buf.DeleteAll();
+
+   Array<int> answer_cnt(NRanks), answer_off(NRanks+1);
+   MPI_Alltoall(reply_cnt.GetData(), 1, MPI_INT, answer_cnt.GetData(), 1,
+                MPI_INT, MyComm);
+   answer_off[0] = 0;
+   for (int r = 0; r < NRanks; r++)
+   {
+      answer_off[r+1] = answer_off[r] + answer_cnt[r];
+   }
+   Array<int> answer_buf(answer_off[NRanks]);
+   MPI_Alltoallv(reply_buf.GetData(), reply_cnt.GetData(), reply_off.GetData(),
+                 MPI_INT, answer_buf.GetData(), answer_cnt.GetData(),
+                 answer_off.GetData(), MPI_INT, MyComm);
+
+   // The answers come in the order of the slots of send_buf
+   ranks.MakeI(nkeys);
+   for (int s = 0, p = 0; s < nkeys; s++)
+   {
+      ranks.AddColumnsInRow(slot_key[s], answer_buf[p]);
+      p += 1 + answer_buf[p];
+   }
+   ranks.MakeJ();
+   for (int s = 0, p = 0; s < nkeys; s++)
+   {
+      ranks.AddConnections(slot_key[s], &answer_buf[p+1], answer_buf[p]);
+      p += 1 + answer_buf[p];
+   }
+   ranks.ShiftUpI();
+}
+
+void ParMesh::BuildFromPiece(const Mesh &piece, const Array<long> &vert_global,
+                             long num_global_verts, bool refine)
+{
+   const int nv = piece.GetNV(), ne = piece.GetNE(), nbe = piece.GetNBE();
+
+   // Number the local vertices in the order of their global numbers, so the
+   // shared vertices of each group are ordered in the same way on all ranks
+   Array<Pair<long, int> > gv_sort(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      gv_sort[i].one = vert_global[i];
+      gv_sort[i].two = i;
+   }
+   SortPairs<long, int>(gv_sort, nv);
+   Array<int> vert_local(nv);
+   Array<long> gvert(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      vert_local[gv_sort[i].two] = i;
+      gvert[i] = gv_sort[i].one;
+   }
+   gv_sort.DeleteAll();
+
+   // Return the local vertex with global number 'g'
+   auto local_vertex = [&gvert](long g)
+   {
+      return int(std::lower_bound(gvert.begin(), gvert.end(), g) -
+                 gvert.begin());
+   };
+
+   // The faces of the piece elements, appearing once, are on the boundary of
+   // the piece. Only the entities on this boundary can be shared.
+   PieceFaces piece_faces(Dim);
+   std::vector<PieceEntity> bnd_faces;
+   {
+      std::vector<PieceEntity> faces;
+      Array<long> gv;
+      for (int e = 0; e < ne; e++)
+      {
+         const int geom = piece.GetElementBaseGeometry(e);
+         GetGlobalVertices(piece.GetElement(e), vert_global, gv);
+         for (int f = 0; f < piece_faces.NumFaces(geom); f++)
+         {
+            PieceEntity ent;
+            piece_faces.GetKey(geom, gv.GetData(), f, ent);
+            ent.elem = e;
+            ent.loc = f;
+            faces.push_back(ent);
+         }
+      }
+      std::sort(faces.begin(), faces.end());
+      for (size_t i = 0; i < faces.size(); )
+      {
+         size_t j = i + 1;
+         while (j < faces.size() && faces[j].SameKey(faces[i])) { j++; }
+         if (j == i + 1) { bnd_faces.push_back(faces[i]); }
+         i = j;
+      }
+   }
+
+   // Shared vertices
+   Array<int> svert_cand;
+   Array<long> svert_keys;
+   {
+      Array<bool> mark(nv);
+      mark = false;
+      for (size_t i = 0; i < bnd_faces.size(); i++)
+      {
+         for (int j = 0; j < 4 && bnd_faces[i].key[j] >= 0; j++)
+         {
+            mark[local_vertex(bnd_faces[i].key[j])] = true;
+         }
+      }
+      for (int i = 0; i < nv; i++)
+      {
+         if (mark[i])
+         {
+            svert_cand.Append(i);
+            svert_keys.Append(gvert[i]);
+         }
+      }
+   }
+   Table svert_ranks;
+   FindSharingRanks(1, svert_keys, num_global_verts, svert_ranks);
+
+   Array<bool> vert_shared(nv);
+   vert_shared = false;
+   for (int k = 0; k < svert_cand.Size(); k++)
+   {
+      if (svert_ranks.RowSize(k) > 1) { vert_shared[svert_cand[k]] = true; }
+   }
+
+   // Shared edges: the candidates are the edges with two shared vertices
+   Array<int> sedge_cand; // pairs of local vertices, in increasing order
+   Array<long> sedge_keys;
+   if (Dim >= 2)
+   {
+      std::vector<std::pair<int, int> > edges;
+      if (Dim == 2)
+      {
+         for (size_t i = 0; i < bnd_faces.size(); i++)
+         {
+            edges.push_back(std::make_pair(local_vertex(bnd_faces[i].key[0]),
+                                           local_vertex(bnd_faces[i].key[1])));
+         }
+      }
+      else
+      {
+         Array<int> v;
+         for (int e = 0; e < ne; e++)
+         {
+            const Element *el = piece.GetElement(e);
+            el->GetVertices(v);
+            for (int k = 0; k < el->GetNEdges(); k++)
+            {
+               const int *ev = el->GetEdgeVertices(k);
+               int v0 = vert_local[v[ev[0]]], v1 = vert_local[v[ev[1]]];
+               if (v0 > v1) { std::swap(v0, v1); }
+               if (vert_shared[v0] && vert_shared[v1])
+               {
+                  edges.push_back(std::make_pair(v0, v1));
+               }
+            }
+         }
+      }
+      std::sort(edges.begin(), edges.end());
+      for (size_t i = 0; i < edges.size(); i++)
+      {
+         const int v0 = edges[i].first, v1 = edges[i].second;
+         if (i > 0 && edges[i] == edges[i-1]) { continue; }
+         if (!vert_shared[v0] || !vert_shared[v1]) { continue; }
+         sedge_cand.Append(v0);
+         sedge_cand.Append(v1);
+         sedge_keys.Append(gvert[v0]);
+         sedge_keys.Append(gvert[v1]);
+      }
+   }
+   Table sedge_ranks;
+   if (Dim >= 2)
+   {
+      FindSharingRanks(2, sedge_keys, num_global_verts, sedge_ranks);
+   }
+
+   // Shared faces (3D): the candidates are the faces on the piece boundary
+   // with all vertices shared
+   std::vector<PieceEntity> sface_cand;
+   Array<long> sface_keys;
+   if (Dim == 3)
+   {
+      for (size_t i = 0; i < bnd_faces.size(); i++)
+      {
+         bool all_shared = true;
+         for (int j = 0; j < 4 && bnd_faces[i].key[j] >= 0; j++)
+         {
+            all_shared &= vert_shared[local_vertex(bnd_faces[i].key[j])];
+         }
+         if (!all_shared) { continue; }
+         sface_cand.push_back(bnd_faces[i]);
+         sface_keys.Append(bnd_faces[i].key, 4);
+      }
+   }
+   Table sface_ranks;
+   if (Dim == 3)
+   {
+      FindSharingRanks(4, sface_keys, num_global_verts, sface_ranks);
+   }
+   std::vector<PieceEntity>().swap(bnd_faces);
+
+   // The communication groups; the first group is the local one
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+
+   auto get_groups = [&](const Table &ranks, Array<int> &ent_group)
+   {
+      ent_group.SetSize(ranks.Size());
+      for (int k = 0; k < ranks.Size(); k++)
+      {
+         ent_group[k] = 0;
+         if (ranks.RowSize(k) > 1)
+         {
+            group.Recreate(ranks.RowSize(k), ranks.GetRow(k));
+            ent_group[k] = groups.Insert(group);
+         }
+      }
+   };
+   Array<int> svert_group, sedge_group, sface_group;
+   get_groups(svert_ranks, svert_group);
+   if (Dim >= 2) { get_groups(sedge_ranks, sedge_group); }
+   if (Dim == 3) { get_groups(sface_ranks, sface_group); }
+
+   // A boundary element on a shared face, i.e. on an interior boundary, is
+   // kept only by the lowest of the two ranks
+   std::vector<PieceEntity> foreign_faces;
+   {
+      const Table &fr = (Dim == 3) ? sface_ranks :
+                        (Dim == 2) ? sedge_ranks : svert_ranks;
+      const Array<long> &fkeys = (Dim == 3) ? sface_keys :
+                                 (Dim == 2) ? sedge_keys : svert_keys;
+      const int ks = (Dim == 3) ? 4 : Dim;
+      for (int k = 0; k < fr.Size(); k++)
+      {
+         if (fr.RowSize(k) > 1 && fr.GetRow(k)[0] != MyRank)
+         {
+            PieceEntity ent;
+            for (int j = 0; j < 4; j++)
+            {
+               ent.key[j] = (j < ks) ? fkeys[k*ks+j] : -1;
+            }
+            foreign_faces.push_back(ent);
+         }
+      }
+      std::sort(foreign_faces.begin(), foreign_faces.end());
+   }
+
+   // Build the local mesh
+   NumOfVertices = nv;
+   vertices.SetSize(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      vertices[vert_local[i]].SetCoords(spaceDim, piece.GetVertex(i));
+   }
+
+   NumOfElements = ne;
+   elements.SetSize(ne);
+   for (int e = 0; e < ne; e++)
+   {
+      elements[e] = piece.GetElement(e)->Duplicate(this);
+      int *v = elements[e]->GetVertices();
+      for (int j = 0; j < elements[e]->GetNVertices(); j++)
+      {
+         v[j] = vert_local[v[j]];
+      }
+   }
+
+   boundary.SetSize(0);
+   {
+      Array<long> gv;
+      for (int i = 0; i < nbe; i++)
+      {
+         PieceEntity ent;
+         GetGlobalVertices(piece.GetBdrElement(i), vert_global, gv);
+         GetBdrKey(gv, ent);
+         if (std::binary_search(foreign_faces.begin(), foreign_faces.end(),
+                                ent)) { continue; }
+         Element *be = piece.GetBdrElement(i)->Duplicate(this);
+         int *v = be->GetVertices();
+         for (int j = 0; j < be->GetNVertices(); j++)
+         {
+            v[j] = vert_local[v[j]];
+         }
+         boundary.Append(be);
+      }
+   }
+   NumOfBdrElements = boundary.Size();
+
+   FinalizeTopology(false);
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   // Fill the shared entities, ordered by group and, within each group, by
+   // their global keys. The candidates are already sorted by their keys.
+   auto make_group_table = [ngroups](const Array<int> &ent_group, Table &tbl)
+   {
+      int nshared = 0;
+      for (int k = 0; k < ent_group.Size(); k++)
+      {
+         if (ent_group[k] > 0) { nshared++; }
+      }
+      tbl.SetDims(ngroups, nshared);
+      int *I = tbl.GetI(), *J = tbl.GetJ();
+      for (int g = 0; g <= ngroups; g++) { I[g] = 0; }
+      for (int k = 0; k < ent_group.Size(); k++)
+      {
+         if (ent_group[k] > 0) { I[ent_group[k]]++; }
+      }
+      for (int g = 1; g <= ngroups; g++) { I[g] += I[g-1]; }
+      for (int j = 0; j < nshared; j++) { J[j] = j; }
+   };
+   // the position of each shared entity in the group order, or -1
+   auto group_order = [ngroups](const Array<int> &ent_group, Array<int> &pos)
+   {
+      Array<int> off(ngroups+1);
+      off = 0;
+      for (int k = 0; k < ent_group.Size(); k++)
+      {
+         if (ent_group[k] > 0) { off[ent_group[k]]++; }
+      }
+      for (int g = 1; g <= ngroups; g++) { off[g] += off[g-1]; }
+      pos.SetSize(ent_group.Size());
+      for (int k = 0; k < ent_group.Size(); k++)
+      {
+         pos[k] = (ent_group[k] > 0) ? off[ent_group[k]-1]++ : -1;
+      }
+   };
+
+   Array<int> pos;
+   make_group_table(svert_group, group_svert);
+   group_order(svert_group, pos);
+   svert_lvert.SetSize(group_svert.Size_of_connections());
+   for (int k = 0; k < pos.Size(); k++)
+   {
+      if (pos[k] >= 0) { svert_lvert[pos[k]] = svert_cand[k]; }
+   }
+
+   if (Dim >= 2)
+   {
+      make_group_table(sedge_group, group_sedge);
+      group_order(sedge_group, pos);
+      shared_edges.SetSize(group_sedge.Size_of_connections());
+      for (int k = 0; k < pos.Size(); k++)
+      {
+         if (pos[k] >= 0)
+         {
+            shared_edges[pos[k]] =
+               new Segment(sedge_cand[2*k], sedge_cand[2*k+1], 1);
+         }
+      }
+   }
+   else
+   {
+      group_sedge.SetSize(ngroups, 0);
+   }
+
+   if (Dim == 3)
+   {
+      // triangles and quadrilaterals are numbered separately
+      Array<int> stria_group(sface_group.Size());
+      Array<int> squad_group(sface_group.Size());
+      for (int k = 0; k < sface_group.Size(); k++)
+      {
+         const bool tri = (sface_cand[k].key[3] < 0);
+         stria_group[k] = tri ? sface_group[k] : 0;
+         squad_group[k] = tri ? 0 : sface_group[k];
+      }
+      make_group_table(stria_group, group_stria);
+      make_group_table(squad_group, group_squad);
+      shared_trias.SetSize(group_stria.Size_of_connections());
+      shared_quads.SetSize(group_squad.Size_of_connections());
+
+      Array<int> tpos, qpos, v;
+      group_order(stria_group, tpos);
+      group_order(squad_group, qpos);
+      for (int k = 0; k < sface_group.Size(); k++)
+      {
+         if (tpos[k] >= 0)
+         {
+            // any vertex order can be used for a triangle
+            int *tv = shared_trias[tpos[k]].v;
+            for (int j = 0; j < 3; j++)
+            {
+               tv[j] = local_vertex(sface_cand[k].key[j]);
+            }
+         }
+         else if (qpos[k] >= 0)
+         {
+            // rotate the quadrilateral to start at its smallest vertex,
+            // followed by the smaller of its two neighbors
+            const Element *el = piece.GetElement(sface_cand[k].elem);
+            el->GetVertices(v);
+            const int *fv;
+            piece_faces.FaceVertices(el->GetGeometryType(), sface_cand[k].loc,
+                                     fv);
+            int qv[4], i0 = 0;
+            for (int j = 0; j < 4; j++)
+            {
+               qv[j] = vert_local[v[fv[j]]];
+               if (qv[j] < qv[i0]) { i0 = j; }
+            }
+            const int dir = (qv[(i0+1)%4] < qv[(i0+3)%4]) ? 1 : 3;
+            int *sq = shared_quads[qpos[k]].v;
+            for (int j = 0; j < 4; j++) { sq[j] = qv[(i0 + j*dir)%4]; }
+         }
+      }
+   }
+   else
+   {
+      group_stria.SetSize(ngroups, 0);
+      group_squad.SetSize(ngroups, 0);
+   }
+
+   const bool fix_orientation = false;
+   Finalize(refine, fix_orientation);
+}
+
+Mesh *ParMesh::LoadSerialChunk(MPI_Comm comm, std::istream &input,
+                               Array<long> &vert_global)
+{
+   int nranks, rank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &rank);
+
+   string ident;
+   input >> ws;
+   getline(input, ident);
+   filter_dos(ident);
+   MFEM_VERIFY(ident == "MFEM mesh v1.0",
+               "only the MFEM mesh v1.0 format is supported, found: " << ident);
+
+   int dim;
+   skip_comment_lines(input, '#');
+   input >> ident >> dim; // 'dimension'
+   MFEM_VERIFY(ident == "dimension", "invalid mesh file");
+
+   // elements: keep the chunk of this rank
+   long ne;
+   skip_comment_lines(input, '#');
+   input >> ident >> ne; // 'elements'
+   MFEM_VERIFY(ident == "elements", "invalid mesh file");
+   const long first = (rank*ne + nranks-1)/nranks;
+   const long last = ((rank+1)*ne + nranks-1)/nranks;
+
+   Array<int> el_attr, el_geom;
+   Array<long> el_vert;
+   for (long i = 0; i < ne; i++)
+   {
+      int attr, geom;
+      long gv;
+      input >> attr >> geom;
+      MFEM_VERIFY(geom >= 0 && geom < Geometry::NumGeom,
+                  "invalid element geometry: " << geom);
+      const bool keep = (first <= i && i < last);
+      if (keep)
+      {
+         el_attr.Append(attr);
+         el_geom.Append(geom);
+      }
+      for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+      {
+         input >> gv;
+         if (keep) { el_vert.Append(gv); }
+      }
+   }
+   el_vert.Copy(vert_global);
+   vert_global.Sort();
+   vert_global.Unique();
+
+   // the faces of the chunk elements
+   PieceFaces piece_faces(dim);
+   std::vector<PieceEntity> faces;
+   for (int e = 0, off = 0; e < el_geom.Size(); e++)
+   {
+      for (int f = 0; f < piece_faces.NumFaces(el_geom[e]); f++)
+      {
+         PieceEntity ent;
+         piece_faces.GetKey(el_geom[e], el_vert.GetData() + off, f, ent);
+         faces.push_back(ent);
+      }
+      off += Geometry::NumVerts[el_geom[e]];
+   }
+   std::sort(faces.begin(), faces.end());
+
+   // boundary elements: keep the faces of the chunk elements
+   long nbe;
+   skip_comment_lines(input, '#');
+   input >> ident >> nbe; // 'boundary'
+   MFEM_VERIFY(ident == "boundary", "invalid mesh file");
+   Array<int> be_attr, be_geom;
+   Array<long> be_vert, gv;
+   for (long i = 0; i < nbe; i++)
+   {
+      int attr, geom;
+      input >> attr >> geom;
+      MFEM_VERIFY(geom >= 0 && geom < Geometry::NumGeom,
+                  "invalid boundary element geometry: " << geom);
+      gv.SetSize(Geometry::NumVerts[geom]);
+      for (int j = 0; j < gv.Size(); j++) { input >> gv[j]; }
+      PieceEntity ent;
+      GetBdrKey(gv, ent);
+      if (std::binary_search(faces.begin(), faces.end(), ent))
+      {
+         be_attr.Append(attr);
+         be_geom.Append(geom);
+         be_vert.Append(gv);
+      }
+   }
+   std::vector<PieceEntity>().swap(faces);
+
+   // vertices: keep the ones used by the chunk
+   long nv;
+   skip_comment_lines(input, '#');
+   input >> ident >> nv; // 'vertices'
+   MFEM_VERIFY(ident == "vertices", "invalid mesh file");
+   input >> ident;
+   MFEM_VERIFY(ident != "nodes", "curved meshes are not supported");
+   const int sdim = atoi(ident.c_str());
+
+   Mesh *chunk = new Mesh(dim, vert_global.Size(), el_geom.Size(),
+                          be_geom.Size(), sdim);
+   double x[3];
+   int k = 0;
+   for (long i = 0; i < nv; i++)
+   {
+      for (int d = 0; d < sdim; d++) { input >> x[d]; }
+      if (k < vert_global.Size() && vert_global[k] == i)
+      {
+         chunk->AddVertex(x);
+         k++;
+      }
+   }
+   MFEM_VERIFY(vert_global.Size() == 0 || vert_global.Last() < nv,
+               "invalid vertex index in the mesh file");
+
+   // add the elements and boundary elements with local vertex indices
+   for (int k = 0, off = 0; k < el_geom.Size() + be_geom.Size(); k++)
+   {
+      const bool is_el = (k < el_geom.Size());
+      const int kk = is_el ? k : k - el_geom.Size();
+      if (!is_el && kk == 0) { off = 0; }
+      const Array<long> &gvert = is_el ? el_vert : be_vert;
+      Element *el = chunk->NewElement(is_el ? el_geom[kk] : be_geom[kk]);
+      el->SetAttribute(is_el ? el_attr[kk] : be_attr[kk]);
+      int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         v[j] = vert_global.FindSorted(gvert[off++]);
+      }
+      if (is_el) { chunk->AddElement(el); }
+      else { chunk->AddBdrElement(el); }
+   }
+
+   const bool generate_bdr = false;
+   chunk->FinalizeTopology(generate_bdr);
+   chunk->Finalize(false, false);
+   return chunk;
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -1302,7 +2437,7 @@ void ParMesh::Finalize(bool refine, bool fix_orientation)
 void ParMesh::DistributeAttributes(Array<int> &attr)
 {
    // Determine the largest attribute number across all processors
-   int max_attr = attr.Max();
+   int max_attr = attr.Size() ? attr.Max() : 0;
    int glb_max_attr = -1;
    MPI_Allreduce(&max_attr, &glb_max_attr, 1, MPI_INT, MPI_MAX, MyComm);
 
@@ -3197,6 +4332,7 @@ void ParMesh::LocalRefinement(const Array<int> &marked_el, int type)
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 
@@ -3254,6 +4390,7 @@ void ParMesh::NonconformingRefinement(const Array<Refinement> &refinements,
 
    last_operation = Mesh::REFINE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 }
@@ -3309,6 +4446,7 @@ bool ParMesh::NonconformingDerefinement(Array<double> &elem_error,
 
    last_operation = Mesh::DEREFINE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 
@@ -3326,7 +4464,13 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Vector &elem_weights)
+{
+   RebalanceImpl(NULL, &elem_weights);
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Vector *elem_weights)
 {
    if (Conforming())
    {
@@ -3353,7 +4497,14 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   if (elem_weights)
+   {
+      pncmesh->Rebalance(*elem_weights);
+   }
+   else
+   {
+      pncmesh->Rebalance(partition);
+   }
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -3370,6 +4521,7 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    last_operation = Mesh::REBALANCE;
    sequence++;
+   UpdateCompactStorage();
 
    UpdateNodes();
 }
@@ -142,7 +142,8 @@ protected:
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Vector *elem_weights = NULL);
 
    void DeleteFaceNbrData();
 
@@ -196,6 +197,24 @@ protected:
    /// Ensure that bdr_attributes and attributes agree across processors
    void DistributeAttributes(Array<int> &attr);
 
+   /** Redistribute the elements of the distributed mesh pieces using a
+       parallel space-filling curve partitioning; returns the new local piece
+       and its global vertex numbers. Used by the distributed constructor. */
+   Mesh *RedistributePiece(const Mesh &piece, const Array<long> &vert_global,
+                           Array<long> &new_vert_global) const;
+
+   /** Build the local part of the mesh and the shared entities from the mesh
+       piece owned by this rank. Used by the distributed constructor. */
+   void BuildFromPiece(const Mesh &piece, const Array<long> &vert_global,
+                       long num_global_verts, bool refine);
+
+   /** For the local entities given by their global keys (sorted global
+       vertex numbers, 'key_size' per entity), find all ranks that have the
+       same entity, using a distributed directory of the keys. Row 'i' of the
+       table @a ranks holds the sorted ranks of entity 'i', including MyRank. */
+   void FindSharingRanks(int key_size, const Array<long> &keys,
+                         long num_global_verts, Table &ranks) const;
+
 public:
    /** Copy constructor. Performs a deep copy of (almost) all data, so that the
        source mesh can be modified (e.g. deleted, refined) without affecting the
@@ -210,6 +229,41 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Create a parallel mesh from the distributed pieces of a
+       conforming global mesh, without assembling the global mesh on any rank.
+
+       Each rank passes its piece @a local_mesh of the global mesh, together
+       with the global numbers @a vert_global of the vertices of the piece,
+       which identify the vertices shared by different pieces. The boundary
+       elements of a piece must be faces of its elements.
+
+       If @a repartition is true, the elements are first redistributed using
+       a parallel space-filling curve (Morton order) partitioning of the
+       element centers, so the pieces can be arbitrary, e.g. the contiguous
+       chunks of the global element list read by LoadSerialChunk(). Otherwise,
+       the piece on each rank becomes its part of the parallel mesh.
+
+       The shared vertices, edges and faces, and the communication groups are
+       determined with a distributed directory of the global vertex numbers,
+       so the memory per rank is proportional to the size of its part. Curved
+       and NURBS meshes are not supported. The @a refine parameter is passed
+       to the method Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+           const Array<long> &vert_global, bool repartition = true,
+           bool refine = true);
+
+   /** @brief Read the chunk of a serial, straight-sided MFEM mesh (format
+       v1.0) assigned to the calling rank of @a comm.
+
+       All ranks read the whole stream @a input, but each keeps only a
+       contiguous chunk of about 1/NRanks of the elements, the vertices they
+       use and the boundary elements on their faces. The global numbers of the
+       chunk vertices are returned in @a vert_global. The returned mesh is
+       meant to be passed to the distributed constructor above, which
+       repartitions it. */
+   static Mesh *LoadSerialChunk(MPI_Comm comm, std::istream &input,
+                                Array<long> &vert_global);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -305,6 +359,14 @@ public:
        for 0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh by splitting the global space-filling
+       sequence of elements into parts of equal total weight. The nonnegative
+       cost of each local element is given by 'elem_weights[i]', for
+       0 <= i < GetNE(). The weights can be estimated, e.g., from the number of
+       element DOFs in p-adaptive discretizations, or measured, e.g., from
+       per-element timings of the assembly or operator application. */
+   void Rebalance(const Vector &elem_weights);
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
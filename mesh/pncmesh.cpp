@@ -18,6 +18,7 @@
 #include "../general/binaryio.hpp"
 
 #include <map>
+#include <algorithm>
 #include <climits> // INT_MIN, INT_MAX
 
 namespace mfem
@@ -1784,6 +1785,85 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 //// Rebalance /////////////////////////////////////////////////////////////////
 
 void ParNCMesh::Rebalance(const Array<int> *custom_partition)
+{
+   RebalanceImpl(custom_partition, NULL);
+}
+
+void ParNCMesh::Rebalance(const Vector &elem_weights)
+{
+   RebalanceImpl(NULL, &elem_weights);
+}
+
+int ParNCMesh::WeightedPartition(const Vector &elem_weights,
+                                 Array<int> &new_ranks) const
+{
+   MFEM_VERIFY(elem_weights.Size() == NElements,
+               "Size of the weight vector must match the number "
+               "of local mesh elements (ParMesh::GetNE()).");
+
+   double local_weight = 0.0;
+   for (int i = 0; i < NElements; i++)
+   {
+      MFEM_VERIFY(elem_weights(i) >= 0.0, "negative element weight");
+      local_weight += elem_weights(i);
+   }
+
+   double total_weight = 0.0, first_weight = 0.0;
+   MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MPI_Scan(&local_weight, &first_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first_weight -= local_weight;
+   MFEM_VERIFY(total_weight > 0.0, "the total element weight must be positive");
+
+   long local_elems = NElements, total_elems = 0;
+   MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+
+   long first_elem_global = 0;
+   MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
+   first_elem_global -= local_elems;
+
+   // Each element goes to the rank whose weight interval contains the midpoint
+   // of the element's weight. Since the ranks are nondecreasing along the SFC,
+   // the global number of elements per rank determines the split points.
+   Array<long> split(NRanks + 1);
+   split = 0;
+   double weight = first_weight;
+   for (int i = 0; i < NElements; i++)
+   {
+      const double mid = weight + 0.5*elem_weights(i);
+      weight += elem_weights(i);
+      const int rank = std::min(int(mid * NRanks / total_weight), NRanks-1);
+      split[rank + 1]++;
+   }
+   MPI_Allreduce(MPI_IN_PLACE, split.GetData(), NRanks + 1, MPI_LONG, MPI_SUM,
+                 MyComm);
+   for (int k = 1; k <= NRanks; k++) { split[k] += split[k-1]; }
+
+   // make sure no rank is left without elements (if possible), e.g. when a
+   // single element is heavier than the average weight per rank
+   if (total_elems >= NRanks)
+   {
+      for (int k = 1; k < NRanks; k++)
+      {
+         split[k] = std::min(std::max(split[k], split[k-1] + 1),
+                             total_elems - (NRanks - k));
+      }
+   }
+
+   for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
+   {
+      if (elements[leaf_elements[i]].rank == MyRank)
+      {
+         const long index = first_elem_global + (j++);
+         new_ranks[i] = int(std::upper_bound(split.begin(), split.end(), index)
+                            - split.begin()) - 1;
+      }
+   }
+
+   return int(split[MyRank+1] - split[MyRank]);
+}
+
+void ParNCMesh::RebalanceImpl(const Array<int> *custom_partition,
+                              const Vector *elem_weights)
 {
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
@@ -1791,7 +1871,16 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    Array<int> old_elements;
    leaf_elements.GetSubArray(0, NElements, old_elements);
 
-   if (!custom_partition) // SFC based partitioning
+   if (elem_weights) // weighted SFC based partitioning
+   {
+      Array<int> new_ranks(leaf_elements.Size());
+      new_ranks = -1;
+
+      int target_elements = WeightedPartition(*elem_weights, new_ranks);
+
+      RedistributeElements(new_ranks, target_elements, true);
+   }
+   else if (!custom_partition) // SFC based partitioning
    {
       Array<int> new_ranks(leaf_elements.Size());
       new_ranks = -1;
@@ -94,6 +94,14 @@ public:
        passed. */
    void Rebalance(const Array<int> *custom_partition = NULL);
 
+   /** Weighted version of the SFC based Rebalance: the space-filling sequence
+       of leaf elements is split into contiguous parts of (approximately) equal
+       total weight instead of equal number of elements. The array
+       'elem_weights' contains the nonnegative cost of each local element,
+       0 <= i < GetNElements(), e.g. based on the polynomial order of the
+       element or on measured assembly or operator application timings. */
+   void Rebalance(const Vector &elem_weights);
+
 
    // interface for ParFiniteElementSpace
 
@@ -526,6 +534,16 @@ protected: // implementation
    void RedistributeElements(Array<int> &new_ranks, int target_elements,
                              bool record_comm);
 
+   /// Implementation of both variants of Rebalance().
+   void RebalanceImpl(const Array<int> *custom_partition,
+                      const Vector *elem_weights);
+
+   /** Assign new ranks to the owned leaves in 'new_ranks', splitting the
+       global space-filling sequence into parts of equal total weight. Returns
+       the number of elements this rank will own after the exchange. */
+   int WeightedPartition(const Vector &elem_weights,
+                         Array<int> &new_ranks) const;
+
    /** Recorded communication pattern from last Rebalance. Used by
        Send/RecvRebalanceDofs to ship element DOFs. */
    RebalanceDofMessage::Map send_rebalance_dofs;
@@ -804,6 +804,7 @@ void ParPumiMesh::UpdateMesh(const ParMesh* AdaptedpMesh)
 
    // Sequence is increased by one to trigger update in FEspace etc.
    sequence++;
+   UpdateCompactStorage();
    last_operation = Mesh::NONE;
 
    // Duplicate the elements
@@ -55,6 +55,8 @@
 //     mesh-optimizer -o 3 -rs 0 -mid 1 -tid 1 -ni 100 -ls 2 -li 100 -bnd -qt 1 -qo 8
 //   ICF limited shape:
 //     mesh-optimizer -o 3 -rs 0 -mid 1 -tid 1 -ni 100 -ls 2 -li 100 -bnd -qt 1 -qo 8 -lc 10
+//   ICF shape with partial assembly:
+//     mesh-optimizer -o 3 -rs 0 -mid 1 -tid 1 -ni 100 -ls 2 -li 100 -bnd -qt 1 -qo 8 -pa
 //   ICF combo shape + size (rings, slow convergence):
 //     mesh-optimizer -o 3 -rs 0 -mid 1 -tid 1 -ni 1000 -ls 2 -li 100 -bnd -qt 1 -qo 8 -cmb
 //   3D pinched sphere shape (the mesh is in the mfem/data GitHub repository):
@@ -271,6 +273,7 @@ int main(int argc, char *argv[])
    bool visualization    = true;
    int verbosity_level   = 0;
    int fdscheme          = 0;
+   bool pa               = false;
 
    // 1. Parse command-line options.
    OptionsParser args(argc, argv);
@@ -337,6 +340,9 @@ int main(int argc, char *argv[])
                   "Make all terms in the optimization functional unitless.");
    args.AddOption(&fdscheme, "-fd", "--fd_approximation",
                   "Enable finite difference based derivative computations.");
+   args.AddOption(&pa, "-pa", "--partial-assembly", "-no-pa",
+                  "--no-partial-assembly",
+                  "Enable partial assembly of the TMOP integrators.");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -555,6 +561,7 @@ int main(int argc, char *argv[])
    //     command-line options for the weights and the type of the second
    //     metric; one should update those in the code.
    NonlinearForm a(fespace);
+   if (pa) { a.SetAssemblyLevel(AssemblyLevel::PARTIAL); }
    ConstantCoefficient *coeff1 = NULL;
    TMOP_QualityMetric *metric2 = NULL;
    TargetConstructor *target_c2 = NULL;
@@ -585,6 +592,7 @@ int main(int argc, char *argv[])
       a.AddDomainIntegrator(he_nlf_integ2);
    }
    else { a.AddDomainIntegrator(he_nlf_integ); }
+   if (pa) { a.Setup(); }
 
    const double init_energy = a.GetGridFunctionEnergy(x);
 
@@ -656,6 +664,7 @@ int main(int argc, char *argv[])
    const double linsol_rtol = 1e-12;
    if (lin_solver == 0)
    {
+      MFEM_VERIFY(!pa, "The l1-Jacobi solver needs the assembled gradient.");
       S = new DSmoother(1, 1.0, max_lin_iter);
    }
    else if (lin_solver == 1)
@@ -0,0 +1,401 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+//
+//                    MFEM Kernel, Assembly and Solver Benchmarks
+//
+// Compile with: make benchmarks
+//
+// Sample runs:  benchmarks
+//               benchmarks -dim "3" -o "1 2 3 4 5 6" -ne "32768" -f json
+//               benchmarks -d simd -b PA/ -f json -of simd.json
+//               benchmarks -d threads:8 -b Solver -of threads.csv
+//
+// Description:  Sweep over the dimension, the polynomial order and the number
+//               of elements of Cartesian quadrilateral and hexahedral meshes,
+//               and time the following operations on H1 spaces:
+//
+//                 - the partial assembly action (Apply) and diagonal of the
+//                   mass, diffusion, convection, vector mass and vector
+//                   diffusion integrators, acting on E-vectors,
+//                 - the element restriction and its transpose,
+//                 - the QuadratureInterpolator values and derivatives,
+//                 - the SparseMatrix action of the diffusion matrix,
+//                 - the full assembly of the diffusion matrix,
+//                 - the sparse RAP product with the refinement matrix,
+//                 - the CG and GMRES iterations with a partially assembled
+//                   mass + diffusion operator and a Jacobi preconditioner.
+//
+//               The results, with DOFs/s, GB/s and GFLOP/s rates computed
+//               from the median time per call, are written in CSV or JSON
+//               format. The byte and flop counts are models of the minimal
+//               traffic and operations of each algorithm (e.g. the sum
+//               factorization of the tensor-product kernels); the rates are
+//               left empty (null) where no model is available. All the
+//               benchmarks use the integration rule with order+2 points in
+//               each direction.
+//
+//               The backend is selected with the MFEM device configuration
+//               string, -d, which is recorded in the output. Backends are
+//               compared by running the benchmarks once per backend, since
+//               the device can only be configured once per process.
+
+#include "bench.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+using namespace mfem;
+using namespace bench;
+
+// Flops of the interpolation of one scalar from the D^dim dofs to the Q^dim
+// quadrature points of an element with sum factorization
+static double SumFactFlops(int dim, int D, int Q)
+{
+   double flops = 0.0;
+   for (int k = 1; k <= dim; k++)
+   {
+      flops += 2.0 * pow(Q, k) * pow(D, dim - k + 1);
+   }
+   return flops;
+}
+
+// Benchmark the action and, if @a diag is true, the diagonal of the partially
+// assembled integrator @a integ on the E-vectors of @a fes.
+static void BenchPA(Runner &run, const string &name,
+                    BilinearFormIntegrator *integ,
+                    const FiniteElementSpace &fes,
+                    const Work &apply, const Work &diagonal, bool diag = true)
+{
+   const string apply_name = name + "/Apply", diag_name = name + "/Diagonal";
+   if (!run.Enabled(apply_name.c_str()) &&
+       !(diag && run.Enabled(diag_name.c_str())))
+   {
+      delete integ;
+      return;
+   }
+   integ->AssemblePA(fes);
+   const Operator *R =
+      fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   Vector x(R->Height()), y(R->Height());
+   x.UseDevice(true);
+   y.UseDevice(true);
+   x.Randomize(1);
+   y = 0.0;
+   run.Run(apply_name.c_str(), apply, [&]() { integ->AddMultPA(x, y); });
+   if (diag)
+   {
+      run.Run(diag_name.c_str(), diagonal,
+              [&]() { integ->AssembleDiagonalPA(y); });
+   }
+   delete integ;
+}
+
+// Run all benchmarks on a Cartesian mesh with about @a ne_target elements
+static void BenchProblem(Runner &run, int dim, int order, int ne_target,
+                         int iters)
+{
+   const int n = max(1, (int) floor(pow(ne_target, 1.0/dim) + 0.5));
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(n, n, Element::QUADRILATERAL, true) :
+                new Mesh(n, n, n, Element::HEXAHEDRON, true);
+   const int NE = mesh->GetNE();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec), vfes(mesh, &fec, dim);
+   const double ndofs = fes.GetTrueVSize();
+   run.SetProblem(dim, order, NE, fes.GetTrueVSize());
+
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*order + 3);
+   const int D = order + 1, Q = order + 2;
+   const double ND = pow(D, dim), NQ = pow(Q, dim);
+   const double sym = dim*(dim + 1)/2, sf = SumFactFlops(dim, D, Q);
+
+   ConstantCoefficient one(1.0);
+   Vector vel(dim);
+   vel = 1.0;
+   VectorConstantCoefficient vel_coeff(vel);
+
+   // Partial assembly kernels
+   {
+      BilinearFormIntegrator *mass = new MassIntegrator(one);
+      BilinearFormIntegrator *diff = new DiffusionIntegrator(one);
+      BilinearFormIntegrator *conv = new ConvectionIntegrator(vel_coeff);
+      BilinearFormIntegrator *vmass = new VectorMassIntegrator(one);
+      BilinearFormIntegrator *vdiff = new VectorDiffusionIntegrator(one);
+      for (BilinearFormIntegrator *integ : { mass, diff, conv, vmass, vdiff })
+      {
+         integ->SetIntRule(&ir);
+      }
+      BenchPA(run, "PA/Mass", mass, fes,
+              Work(ndofs, 8*NE*(3*ND + NQ), NE*(2*sf + NQ)),
+              Work(ndofs, 8*NE*(2*ND + NQ), NE*sf));
+      BenchPA(run, "PA/Diffusion", diff, fes,
+              Work(ndofs, 8*NE*(3*ND + sym*NQ), NE*(2*dim*sf + 2*dim*dim*NQ)),
+              Work(ndofs, 8*NE*(2*ND + sym*NQ), NE*dim*dim*sf));
+      BenchPA(run, "PA/Convection", conv, fes,
+              Work(ndofs, 8*NE*(3*ND + dim*NQ), NE*((dim + 1)*sf + 2*dim*NQ)),
+              Work(), false);
+      BenchPA(run, "PA/VectorMass", vmass, vfes,
+              Work(dim*ndofs, 8*NE*(3*dim*ND + NQ), NE*dim*(2*sf + NQ)),
+              Work(dim*ndofs, 8*NE*(2*dim*ND + NQ), NE*dim*sf));
+      BenchPA(run, "PA/VectorDiffusion", vdiff, vfes,
+              Work(dim*ndofs, 8*NE*(3*dim*ND + sym*NQ),
+                   NE*dim*(2*dim*sf + 2*dim*dim*NQ)),
+              Work(dim*ndofs, 8*NE*(2*dim*ND + sym*NQ), NE*dim*dim*dim*sf));
+   }
+
+   // Element restriction
+   {
+      const Operator *R =
+         fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+      const double L = R->Width(), E = R->Height();
+      Vector x(R->Width()), y(R->Height());
+      x.UseDevice(true);
+      y.UseDevice(true);
+      x.Randomize(1);
+      run.Run("ElementRestriction/Mult", Work(ndofs, 8*L + 12*E),
+              [&]() { R->Mult(x, y); });
+      run.Run("ElementRestriction/MultTranspose",
+              Work(ndofs, 12*E + 12*L + 4, E),
+              [&]() { R->MultTranspose(y, x); });
+   }
+
+   // Quadrature interpolation of the vector space (e.g. for the Jacobians)
+   {
+      const Operator *R =
+         vfes.GetElementRestriction(ElementDofOrdering::NATIVE);
+      const QuadratureInterpolator *qi = vfes.GetQuadratureInterpolator(ir);
+      const int NIR = ir.GetNPoints();
+      Vector e(R->Height()), q_val(NIR*dim*NE), q_der(NIR*dim*dim*NE);
+      for (Vector *v : { &e, &q_val, &q_der }) { v->UseDevice(true); }
+      e.Randomize(1);
+      run.Run("QuadratureInterpolator/Values",
+              Work(dim*ndofs, 8.0*NE*dim*(ND + NIR), 2.0*NE*dim*ND*NIR),
+              [&]() { qi->Values(e, q_val); });
+      run.Run("QuadratureInterpolator/Derivatives",
+              Work(dim*ndofs, 8.0*NE*dim*(ND + dim*NIR),
+                   2.0*NE*dim*dim*ND*NIR),
+              [&]() { qi->Derivatives(e, q_der); });
+   }
+
+   // Sparse matrix action and full assembly
+   if (run.Enabled("SparseMatrix/Mult") || run.Enabled("FullAssembly"))
+   {
+      BilinearForm a(&fes);
+      DiffusionIntegrator *integ = new DiffusionIntegrator(one);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+      a.Assemble();
+      a.Finalize();
+      const SparseMatrix &A = a.SpMat();
+      const double nnz = A.NumNonZeroElems(), h = A.Height();
+      Vector x(A.Width()), y(A.Height());
+      x.UseDevice(true);
+      y.UseDevice(true);
+      x.Randomize(1);
+      run.Run("SparseMatrix/Mult", Work(ndofs, 12*nnz + 20*h + 4, 2*nnz),
+              [&]() { A.Mult(x, y); });
+
+      const double NIR = ir.GetNPoints();
+      run.Run("FullAssembly/Diffusion",
+              Work(ndofs, 20*NE*ND*ND, NE*NIR*(2*dim*ND*ND + 2*dim*dim*ND)),
+              [&]()
+      {
+         BilinearForm b(&fes);
+         DiffusionIntegrator *b_integ = new DiffusionIntegrator(one);
+         b_integ->SetIntRule(&ir);
+         b.AddDomainIntegrator(b_integ);
+         b.Assemble();
+         b.Finalize();
+      });
+   }
+
+   // Sparse RAP with the refinement matrix from a coarser mesh
+   if (run.Enabled("RAP/Diffusion"))
+   {
+      const int nc = max(1, n/2);
+      Mesh *cmesh = (dim == 2) ?
+                    new Mesh(nc, nc, Element::QUADRILATERAL, true) :
+                    new Mesh(nc, nc, nc, Element::HEXAHEDRON, true);
+      FiniteElementSpace rfes(cmesh, &fec);
+      rfes.SetUpdateOperatorType(Operator::MFEM_SPARSEMAT);
+      cmesh->UniformRefinement();
+      rfes.Update();
+      const SparseMatrix *P =
+         dynamic_cast<const SparseMatrix*>(rfes.GetUpdateOperator());
+      MFEM_VERIFY(P, "the refinement matrix is not available");
+
+      BilinearForm a(&rfes);
+      DiffusionIntegrator *integ = new DiffusionIntegrator(one);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+      a.Assemble();
+      a.Finalize();
+      const SparseMatrix &A = a.SpMat();
+      SparseMatrix *C = RAP(*P, A, *P);
+      const double nnz = A.NumNonZeroElems() + 2*P->NumNonZeroElems() +
+                         C->NumNonZeroElems();
+      const double nc_dofs = C->Height();
+      delete C;
+      run.Run("RAP/Diffusion", Work(nc_dofs, 12*nnz),
+              [&]() { delete RAP(*P, A, *P); });
+      delete cmesh;
+   }
+
+   // Krylov solvers with a partially assembled operator
+   if (run.Enabled("Solver"))
+   {
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      MassIntegrator *m_integ = new MassIntegrator(one);
+      DiffusionIntegrator *d_integ = new DiffusionIntegrator(one);
+      m_integ->SetIntRule(&ir);
+      d_integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(m_integ);
+      a.AddDomainIntegrator(d_integ);
+      a.Assemble();
+      Array<int> ess_tdof_list;
+      OperatorJacobiSmoother jacobi(a, ess_tdof_list);
+
+      const Operator *R =
+         fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+      const double L = R->Width(), E = R->Height();
+      // Operator: restriction, mass and diffusion kernels, and transpose
+      Work op(0.0, 8*L + 12*E + 8*NE*(3*ND + (sym + 1)*NQ) + 12*E + 12*L,
+              NE*(2*sf + NQ + 2*dim*sf + 2*dim*dim*NQ) + E);
+      // Jacobi preconditioner
+      op += Work(0.0, 24*ndofs, ndofs);
+
+      Vector b(fes.GetTrueVSize()), x(fes.GetTrueVSize());
+      b.UseDevice(true);
+      x.UseDevice(true);
+      b.Randomize(1);
+
+      // One iteration: 2 dot products and 3 axpy-type updates
+      CGSolver cg;
+      cg.SetRelTol(0.0);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(iters);
+      cg.SetOperator(a);
+      cg.SetPreconditioner(jacobi);
+      Work cg_it = op;
+      cg_it += Work(ndofs, 8*13*ndofs, 10*ndofs);
+      run.RunCount("Solver/CG", cg_it, [&]()
+      {
+         x = 0.0;
+         cg.Mult(b, x);
+         return cg.GetNumIterations();
+      });
+
+      // One iteration: on average (iters+1)/2 + 1 dot products and updates
+      // in the modified Gram-Schmidt orthogonalization
+      GMRESSolver gmres;
+      gmres.SetRelTol(0.0);
+      gmres.SetAbsTol(0.0);
+      gmres.SetMaxIter(iters);
+      gmres.SetKDim(iters);
+      gmres.SetOperator(a);
+      gmres.SetPreconditioner(jacobi);
+      const double ngs = 0.5*(iters + 1) + 1;
+      Work gmres_it = op;
+      gmres_it += Work(ndofs, 8*5*ngs*ndofs, 4*ngs*ndofs);
+      run.RunCount("Solver/GMRES", gmres_it, [&]()
+      {
+         x = 0.0;
+         gmres.Mult(b, x);
+         return gmres.GetNumIterations();
+      });
+   }
+
+   delete mesh;
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   const char *device_config = "cpu";
+   Array<int> dims(2);
+   dims[0] = 2;
+   dims[1] = 3;
+   Array<int> orders(4);
+   for (int i = 0; i < 4; i++) { orders[i] = i + 1; }
+   Array<int> nes(2);
+   nes[0] = 512;
+   nes[1] = 4096;
+   const char *filter = "";
+   double min_time = 0.1;
+   int min_reps = 3;
+   int iters = 20;
+   const char *format = "csv";
+   const char *output = "";
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.AddOption(&dims, "-dim", "--dimensions",
+                  "Mesh dimensions to benchmark: 2 and/or 3.");
+   args.AddOption(&orders, "-o", "--orders",
+                  "Polynomial orders to benchmark.");
+   args.AddOption(&nes, "-ne", "--elements",
+                  "Approximate numbers of elements to benchmark.");
+   args.AddOption(&filter, "-b", "--benchmarks",
+                  "Run only the benchmarks whose names contain this string.");
+   args.AddOption(&min_time, "-mt", "--min-time",
+                  "Minimum total time of the repetitions of a benchmark.");
+   args.AddOption(&min_reps, "-mr", "--min-reps",
+                  "Minimum number of repetitions of a benchmark.");
+   args.AddOption(&iters, "-it", "--iterations",
+                  "Number of solver iterations (and GMRES restart).");
+   args.AddOption(&format, "-f", "--format",
+                  "Output format: 'csv' or 'json'.");
+   args.AddOption(&output, "-of", "--output",
+                  "Output file; by default the results are written to the "
+                  "standard output.");
+   args.Parse();
+   if (!args.Good())
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   const string fmt(format);
+   if (fmt != "csv" && fmt != "json")
+   {
+      cerr << "Unknown output format: " << format << endl;
+      return 1;
+   }
+
+   // 2. Configure the device and run the benchmarks.
+   Device device(device_config);
+   Runner run(device_config, filter, min_time, min_reps);
+   for (int dim : dims)
+   {
+      MFEM_VERIFY(dim == 2 || dim == 3, "invalid dimension: " << dim);
+      for (int order : orders)
+      {
+         for (int ne : nes)
+         {
+            BenchProblem(run, dim, order, ne, iters);
+         }
+      }
+   }
+
+   // 3. Write the results.
+   ofstream ofs;
+   if (output[0] != '\0') { ofs.open(output); }
+   ostream &out = ofs.is_open() ? ofs : cout;
+   out.precision(8);
+   if (fmt == "csv") { run.PrintCSV(out); }
+   else { run.PrintJSON(out); }
+
+   return 0;
+}
@@ -0,0 +1,205 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BENCH_HPP
+#define MFEM_BENCH_HPP
+
+#include "mfem.hpp"
+#include "general/forall.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+using namespace mfem;
+
+/// Amount of work done by one call of a benchmarked function.
+/** The byte and flop counts are models of the minimal memory traffic and of
+    the floating point operations of the algorithm, not hardware counters. A
+    negative value means that no model is available. */
+struct Work
+{
+   double dofs;  ///< Number of degrees of freedom processed
+   double bytes; ///< Bytes read and written
+   double flops; ///< Floating point operations
+
+   Work(double dofs_ = 0.0, double bytes_ = -1.0, double flops_ = -1.0)
+      : dofs(dofs_), bytes(bytes_), flops(flops_) { }
+
+   Work &operator+=(const Work &w)
+   {
+      dofs += w.dofs;
+      bytes = (bytes < 0.0 || w.bytes < 0.0) ? -1.0 : bytes + w.bytes;
+      flops = (flops < 0.0 || w.flops < 0.0) ? -1.0 : flops + w.flops;
+      return *this;
+   }
+
+   Work operator*(double s) const
+   {
+      return Work(s*dofs, bytes < 0.0 ? bytes : s*bytes,
+                  flops < 0.0 ? flops : s*flops);
+   }
+};
+
+/// Result of one benchmark, see Runner::Run().
+struct Record
+{
+   std::string name;
+   int dim, order, ne;
+   long ndofs;
+   int reps;
+   double t_min, t_median; ///< Seconds per call
+   Work work;              ///< Work per call
+
+   double DofsPerSecond() const { return work.dofs / t_median; }
+   double GBytesPerSecond() const { return 1e-9*work.bytes / t_median; }
+   double GFlopsPerSecond() const { return 1e-9*work.flops / t_median; }
+};
+
+/** @brief Run and time benchmarks, and write the results in a machine-readable
+    format (CSV or JSON). */
+/** Each benchmark is called once for warm-up, then repeatedly until both the
+    minimum number of repetitions and the minimum total time are reached. The
+    device is synchronized after every call. The rates are computed from the
+    median time per call. */
+class Runner
+{
+protected:
+   std::string device, filter;
+   double min_time;
+   int min_reps, max_reps;
+   std::vector<Record> records;
+
+   // Current problem parameters, see SetProblem()
+   int dim, order, ne;
+   long ndofs;
+
+public:
+   /** @brief Construct a runner for the given @a device configuration string;
+       only the benchmarks whose names contain @a filter are run. */
+   Runner(const char *device_, const char *filter_, double min_time_,
+          int min_reps_ = 3, int max_reps_ = 10000)
+      : device(device_), filter(filter_), min_time(min_time_),
+        min_reps(min_reps_), max_reps(max_reps_),
+        dim(0), order(0), ne(0), ndofs(0) { }
+
+   /// Set the problem parameters recorded with the next results.
+   void SetProblem(int dim_, int order_, int ne_, long ndofs_)
+   { dim = dim_; order = order_; ne = ne_; ndofs = ndofs_; }
+
+   /// Return true if the benchmark @a name is selected by the filter.
+   bool Enabled(const char *name) const
+   { return filter.empty() || std::strstr(name, filter.c_str()); }
+
+   /// Time the function @a f, whose calls each perform the work @a w.
+   template <typename F>
+   void Run(const char *name, const Work &w, F &&f)
+   {
+      if (!Enabled(name)) { return; }
+      f();
+      MFEM_DEVICE_SYNC;
+      Array<double> times;
+      double total = 0.0;
+      StopWatch sw;
+      while ((times.Size() < min_reps || total < min_time) &&
+             times.Size() < max_reps)
+      {
+         sw.Clear();
+         sw.Start();
+         f();
+         MFEM_DEVICE_SYNC;
+         sw.Stop();
+         times.Append(sw.RealTime());
+         total += times.Last();
+      }
+      times.Sort();
+      Record r;
+      r.name = name;
+      r.dim = dim;
+      r.order = order;
+      r.ne = ne;
+      r.ndofs = ndofs;
+      r.reps = times.Size();
+      r.t_min = times[0];
+      r.t_median = times[times.Size()/2];
+      r.work = w;
+      records.push_back(r);
+   }
+
+   /// Time one call of @a f per repetition, normalized by @a count.
+   /** Use for functions performing @a count units of work @a w each, e.g.
+       iterations of a solver, where @a count is known only after the call. */
+   template <typename F>
+   void RunCount(const char *name, const Work &w, F &&f)
+   {
+      if (!Enabled(name)) { return; }
+      int count = 0;
+      Run(name, w, [&]() { count = f(); });
+      Record &r = records.back();
+      r.t_min /= count;
+      r.t_median /= count;
+   }
+
+   /// Write the results as comma-separated values with a header line.
+   void PrintCSV(std::ostream &out) const
+   {
+      out << "name,device,dim,order,ne,ndofs,reps,t_min,t_median,"
+          << "dofs_per_s,gbytes_per_s,gflops_per_s\n";
+      for (const Record &r : records)
+      {
+         out << r.name << ',' << device << ',' << r.dim << ',' << r.order
+             << ',' << r.ne << ',' << r.ndofs << ',' << r.reps << ','
+             << r.t_min << ',' << r.t_median << ',' << r.DofsPerSecond()
+             << ',';
+         if (r.work.bytes >= 0.0) { out << r.GBytesPerSecond(); }
+         out << ',';
+         if (r.work.flops >= 0.0) { out << r.GFlopsPerSecond(); }
+         out << '\n';
+      }
+   }
+
+   /// Write the results and the run configuration as a JSON object.
+   void PrintJSON(std::ostream &out) const
+   {
+      out << "{\n  \"context\": {\n"
+          << "    \"mfem_version\": \"" << GetVersionStr() << "\",\n"
+          << "    \"mfem_git\": \"" << GetGitStr() << "\",\n"
+          << "    \"device\": \"" << device << "\",\n"
+          << "    \"min_time\": " << min_time << "\n  },\n"
+          << "  \"benchmarks\": [";
+      for (size_t i = 0; i < records.size(); i++)
+      {
+         const Record &r = records[i];
+         out << (i ? ",\n" : "\n")
+             << "    {\"name\": \"" << r.name << "\", \"dim\": " << r.dim
+             << ", \"order\": " << r.order << ", \"ne\": " << r.ne
+             << ", \"ndofs\": " << r.ndofs << ", \"reps\": " << r.reps
+             << ",\n     \"t_min\": " << r.t_min
+             << ", \"t_median\": " << r.t_median
+             << ", \"dofs_per_s\": " << r.DofsPerSecond()
+             << ", \"gbytes_per_s\": ";
+         if (r.work.bytes >= 0.0) { out << r.GBytesPerSecond(); }
+         else { out << "null"; }
+         out << ", \"gflops_per_s\": ";
+         if (r.work.flops >= 0.0) { out << r.GFlopsPerSecond(); }
+         else { out << "null"; }
+         out << '}';
+      }
+      out << "\n  ]\n}\n";
+   }
+};
+
+} // namespace bench
+
+#endif // MFEM_BENCH_HPP
@@ -0,0 +1,205 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace assembly_levels
+{
+
+double coeffFunction(const Vector& x)
+{
+   return 2.0 + x(0)*x(0) + x(1);
+}
+
+void perturbation(const Vector &x, Vector &p)
+{
+   p = x;
+   p(0) += 0.1*x(0)*x(1);
+   p(1) += 0.05*sin(M_PI*x(0));
+}
+
+enum class Integ { Mass, Diffusion, MassDiffusion };
+
+Mesh *MakeMesh(int dim, bool simplices)
+{
+   const int ne = 2;
+   if (dim == 2)
+   {
+      Element::Type type = simplices ? Element::TRIANGLE :
+                           Element::QUADRILATERAL;
+      return new Mesh(ne, ne, type, 1, 1.0, 1.0);
+   }
+   Element::Type type = simplices ? Element::TETRAHEDRON :
+                        Element::HEXAHEDRON;
+   return new Mesh(ne, ne, ne, type, 1, 1.0, 1.0, 1.0);
+}
+
+void AddIntegrators(BilinearForm &a, Integ integ, Coefficient &coeff)
+{
+   if (integ != Integ::Mass)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   }
+   if (integ != Integ::Diffusion)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+   }
+}
+
+// Compare the action, transposed action and diagonal (when available) of the
+// form assembled with the given assembly level against the fully assembled
+// matrix.
+void CompareWithFullAssembly(AssemblyLevel level, int dim, int order,
+                             bool simplices, Integ integ)
+{
+   Mesh *mesh = MakeMesh(dim, simplices);
+   mesh->Transform(perturbation);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient coeff(coeffFunction);
+
+   BilinearForm a_fa(&fes);
+   AddIntegrators(a_fa, integ, coeff);
+   a_fa.Assemble();
+   a_fa.Finalize();
+
+   BilinearForm a_level(&fes);
+   a_level.SetAssemblyLevel(level);
+   AddIntegrators(a_level, integ, coeff);
+   a_level.Assemble();
+
+   Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y_level(fes.GetVSize());
+   x.Randomize(1);
+
+   a_fa.Mult(x, y_fa);
+   a_level.Mult(x, y_level);
+   y_level -= y_fa;
+   REQUIRE(y_level.Normlinf() < 1.e-12 * std::max(1.0, y_fa.Normlinf()));
+
+   a_fa.MultTranspose(x, y_fa);
+   a_level.MultTranspose(x, y_level);
+   y_level -= y_fa;
+   REQUIRE(y_level.Normlinf() < 1.e-12 * std::max(1.0, y_fa.Normlinf()));
+
+   if (level != AssemblyLevel::NONE)
+   {
+      Vector diag_fa, diag_level(fes.GetTrueVSize());
+      a_fa.SpMat().GetDiag(diag_fa);
+      a_level.AssembleDiagonal(diag_level);
+      diag_level -= diag_fa;
+      REQUIRE(diag_level.Normlinf() <
+              1.e-12 * std::max(1.0, diag_fa.Normlinf()));
+   }
+
+   delete mesh;
+}
+
+TEST_CASE("Element assembly", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (int s = 0; s < 2; s++)
+         {
+            const bool simplices = (s == 1);
+            CompareWithFullAssembly(AssemblyLevel::ELEMENT, dim, order,
+                                    simplices, Integ::Mass);
+            CompareWithFullAssembly(AssemblyLevel::ELEMENT, dim, order,
+                                    simplices, Integ::Diffusion);
+            CompareWithFullAssembly(AssemblyLevel::ELEMENT, dim, order,
+                                    simplices, Integ::MassDiffusion);
+         }
+      }
+   }
+}
+
+TEST_CASE("Element assembly vector", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim, false);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec, dim);
+
+      BilinearForm a_fa(&fes);
+      a_fa.AddDomainIntegrator(new VectorMassIntegrator);
+      a_fa.AddDomainIntegrator(new VectorDiffusionIntegrator);
+      a_fa.Assemble();
+      a_fa.Finalize();
+
+      BilinearForm a_ea(&fes);
+      a_ea.SetAssemblyLevel(AssemblyLevel::ELEMENT);
+      a_ea.AddDomainIntegrator(new VectorMassIntegrator);
+      a_ea.AddDomainIntegrator(new VectorDiffusionIntegrator);
+      a_ea.Assemble();
+
+      Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y_ea(fes.GetVSize());
+      x.Randomize(1);
+      a_fa.Mult(x, y_fa);
+      a_ea.Mult(x, y_ea);
+      y_ea -= y_fa;
+      REQUIRE(y_ea.Normlinf() < 1.e-12 * y_fa.Normlinf());
+
+      delete mesh;
+   }
+}
+
+TEST_CASE("Matrix-free assembly", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         CompareWithFullAssembly(AssemblyLevel::NONE, dim, order, false,
+                                 Integ::Mass);
+         CompareWithFullAssembly(AssemblyLevel::NONE, dim, order, false,
+                                 Integ::Diffusion);
+         CompareWithFullAssembly(AssemblyLevel::NONE, dim, order, false,
+                                 Integ::MassDiffusion);
+      }
+   }
+}
+
+TEST_CASE("Matrix-free assembly curved", "[AssemblyLevel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = MakeMesh(dim, false);
+      mesh->SetCurvature(3);
+      mesh->Transform(perturbation);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      ConstantCoefficient one(1.0);
+
+      BilinearForm a_pa(&fes), a_mf(&fes);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_mf.SetAssemblyLevel(AssemblyLevel::NONE);
+      AddIntegrators(a_pa, Integ::MassDiffusion, one);
+      AddIntegrators(a_mf, Integ::MassDiffusion, one);
+      a_pa.Assemble();
+      a_mf.Assemble();
+
+      Vector x(fes.GetVSize()), y_pa(fes.GetVSize()), y_mf(fes.GetVSize());
+      x.Randomize(1);
+      a_pa.Mult(x, y_pa);
+      a_mf.Mult(x, y_mf);
+      y_mf -= y_pa;
+      REQUIRE(y_mf.Normlinf() < 1.e-12 * y_pa.Normlinf());
+
+      delete mesh;
+   }
+}
+
+} // namespace assembly_levels
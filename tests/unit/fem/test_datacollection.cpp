@@ -103,6 +103,54 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 
+      SECTION("Binary MFEM format")
+      {
+         VisItDataCollection dc("base", mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+         dc.SetFormat(DataCollection::BINARY_FORMAT);
+
+         //Save the DataCollection and load it into a new one
+         dc.SetPadDigits(5);
+         dc.Save();
+         REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigits(5);
+         dc_new.Load(dc.GetCycle());
+         REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+         Mesh* mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(dc.GetTime() == dc_new.GetTime());
+
+         //The binary format stores the data exactly
+         REQUIRE(mesh_new->GetNE() == mesh->GetNE());
+         Vector vert, vert_diff;
+         mesh->GetVertices(vert);
+         mesh_new->GetVertices(vert_diff);
+         vert_diff -= vert;
+         REQUIRE(vert_diff.Normlinf() == 0.0);
+
+         Vector u_diff(*u_new), v_diff(*v_new);
+         u_diff -= *u;
+         v_diff -= *v;
+         REQUIRE(u_diff.Normlinf() == 0.0);
+         REQUIRE(v_diff.Normlinf() == 0.0);
+
+         //Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+
 #ifdef MFEM_USE_ZLIB
       SECTION("Compressed MFEM format")
       {
@@ -170,3 +218,153 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
 #endif
    }
 }
+
+namespace async_save
+{
+
+std::string ReadFile(const std::string &file_name)
+{
+   std::ifstream in(file_name, std::ios::binary);
+   REQUIRE(in.good());
+   std::stringstream ss;
+   ss << in.rdbuf();
+   return ss.str();
+}
+
+// Compare the files written by the synchronous and the asynchronous saves,
+// then remove them and their directories.
+void CompareAndRemove(const std::vector<std::string> &files,
+                      const std::vector<std::string> &dirs)
+{
+   for (const std::string &f : files)
+   {
+      REQUIRE(ReadFile("async/" + f) == ReadFile("sync/" + f));
+      REQUIRE(remove(("async/" + f).c_str()) == 0);
+      REQUIRE(remove(("sync/" + f).c_str()) == 0);
+   }
+   for (const std::string &d : dirs)
+   {
+      REQUIRE(rmdir(("async/" + d).c_str()) == 0);
+      REQUIRE(rmdir(("sync/" + d).c_str()) == 0);
+   }
+   REQUIRE(rmdir("async") == 0);
+   REQUIRE(rmdir("sync") == 0);
+}
+
+}
+
+TEST_CASE("Asynchronous save", "[DataCollection]")
+{
+   Mesh mesh(4, 3, Element::QUADRILATERAL, true, 2.0, 3.0);
+   mesh.EnsureNCMesh();
+   Array<int> marked;
+   marked.Append(0);
+   marked.Append(5);
+   mesh.GeneralRefinement(marked, 1);
+   mesh.SetCurvature(2);
+
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   FiniteElementSpace vfes(&mesh, &fec, 2, Ordering::byVDIM);
+   GridFunction u(&fes), v(&vfes);
+   for (int i = 0; i < u.Size(); i++) { u(i) = sin(1.0 + i); }
+   for (int i = 0; i < v.Size(); i++) { v(i) = cos(1.0 + i); }
+   QuadratureSpace qspace(&mesh, 2);
+   QuadratureFunction q(&qspace);
+   for (int i = 0; i < q.Size(); i++) { q(i) = 0.5*i; }
+
+   const Vector u0(u), nodes0(*mesh.GetNodes());
+
+   SECTION("VisIt data files")
+   {
+      for (int format = 0; format < 2; format++)
+      {
+         for (int async = 0; async < 2; async++)
+         {
+            VisItDataCollection dc("base", &mesh);
+            dc.SetPrefixPath(async ? "async" : "sync");
+            dc.RegisterField("u", &u);
+            dc.RegisterField("v", &v);
+            dc.RegisterQField("q", &q);
+            dc.SetCycle(3);
+            dc.SetTime(1.5);
+            dc.SetFormat(format ? DataCollection::BINARY_FORMAT :
+                         DataCollection::SERIAL_FORMAT);
+            dc.SetAsync(async);
+            REQUIRE(dc.IsAsync() == bool(async));
+            dc.Save();
+            REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+            // The data can be modified as soon as Save() returns
+            u = 1.0;
+            *mesh.GetNodes() -= 1.0;
+
+            REQUIRE(dc.WaitForSaves() == DataCollection::NO_ERROR);
+            REQUIRE(dc.GetLastSave().IsDone());
+            REQUIRE(dc.GetLastSave().Wait() == DataCollection::NO_ERROR);
+            u = u0;
+            *mesh.GetNodes() = nodes0;
+         }
+         async_save::CompareAndRemove(
+         {
+            "base_000003.mfem_root", "base_000003/mesh.000000",
+            "base_000003/u.000000", "base_000003/v.000000",
+            "base_000003/q.000000"
+         }, {"base_000003"});
+      }
+   }
+
+   SECTION("ParaView data files")
+   {
+      for (int async = 0; async < 2; async++)
+      {
+         ParaViewDataCollection dc("pv", &mesh);
+         dc.SetPrefixPath(async ? "async" : "sync");
+         dc.RegisterField("u", &u);
+         dc.RegisterField("v", &v);
+         dc.SetLevelsOfDetail(2);
+         dc.SetCycle(3);
+         dc.SetTime(1.5);
+         dc.SetAsync(async);
+         dc.Save();
+         REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+         u = 1.0;
+         REQUIRE(dc.WaitForSaves() == DataCollection::NO_ERROR);
+         u = u0;
+      }
+      async_save::CompareAndRemove(
+      {
+         "pv/Cycle000003/proc000000.vtu", "pv/Cycle000003/data.pvtu",
+         "pv/pv.pvd"
+      }, {"pv/Cycle000003", "pv"});
+   }
+
+   SECTION("Bounded queue")
+   {
+      // With a limit smaller than a single save, each file waits for the
+      // previous one
+      VisItDataCollection dc("base", &mesh);
+      dc.SetPrefixPath("async");
+      dc.RegisterField("u", &u);
+      dc.SetAsync(true, 1);
+      for (int cycle = 0; cycle < 3; cycle++)
+      {
+         dc.SetCycle(cycle);
+         dc.Save();
+      }
+      DataCollection::SaveHandle last = dc.GetLastSave();
+      REQUIRE(last.Wait() == DataCollection::NO_ERROR);
+      REQUIRE(last.IsDone());
+      dc.SetAsync(false);
+      for (int cycle = 0; cycle < 3; cycle++)
+      {
+         const std::string dir = "async/base_00000" + std::to_string(cycle);
+         REQUIRE(remove((dir + ".mfem_root").c_str()) == 0);
+         REQUIRE(remove((dir + "/mesh.000000").c_str()) == 0);
+         REQUIRE(remove((dir + "/u.000000").c_str()) == 0);
+         REQUIRE(rmdir(dir.c_str()) == 0);
+      }
+      REQUIRE(rmdir("async") == 0);
+   }
+}
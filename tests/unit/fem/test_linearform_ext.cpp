@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace linearform_ext
+{
+
+double f_scalar(const Vector &x)
+{
+   double r = 1.0;
+   for (int d = 0; d < x.Size(); d++) { r += (d+1)*sin(x(d)); }
+   return r;
+}
+
+void f_vector(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = (d+1)*x(d)*x(d) - d; }
+}
+
+// Assemble the linear form with and without the fast assembly and return the
+// max norm of the difference relative to the max norm of the result.
+double TestAssembly(FiniteElementSpace &fes, bool vector)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   FunctionCoefficient fq(f_scalar);
+   ConstantCoefficient cq(2.5);
+   VectorFunctionCoefficient fvq(dim, f_vector);
+   Vector c(dim);
+   c.Randomize(1);
+   VectorConstantCoefficient cvq(c);
+   ConstantCoefficient bq(-1.0);
+
+   LinearForm lf_ref(&fes), lf(&fes);
+   for (LinearForm *b : { &lf_ref, &lf })
+   {
+      if (vector)
+      {
+         b->AddDomainIntegrator(new VectorDomainLFIntegrator(fvq));
+         b->AddDomainIntegrator(new VectorDomainLFIntegrator(cvq));
+      }
+      else
+      {
+         b->AddDomainIntegrator(new DomainLFIntegrator(fq));
+         b->AddDomainIntegrator(new DomainLFIntegrator(cq, 1, 1));
+         if (dynamic_cast<const H1_FECollection*>(fes.FEColl()))
+         {
+            b->AddBoundaryIntegrator(new BoundaryLFIntegrator(bq));
+         }
+      }
+   }
+   lf.UseFastAssembly(true);
+   REQUIRE(lf.SupportsDevice());
+   lf_ref.Assemble();
+   lf.Assemble();
+
+   const double scale = lf_ref.Normlinf();
+   REQUIRE(scale > 0.0);
+   lf -= lf_ref;
+   return lf.Normlinf() / scale;
+}
+
+TEST_CASE("LinearForm fast assembly", "[LinearForm][PartialAssembly]")
+{
+   for (auto type : { Element::QUADRILATERAL, Element::TRIANGLE,
+                      Element::HEXAHEDRON, Element::TETRAHEDRON })
+   {
+      const bool is3D = type == Element::HEXAHEDRON ||
+                        type == Element::TETRAHEDRON;
+      Mesh *mesh = is3D ? new Mesh(3, 3, 3, type, true) :
+                   new Mesh(4, 4, type, true);
+      const int dim = mesh->Dimension();
+      // Curve the mesh slightly to get non-constant Jacobians
+      mesh->EnsureNodes();
+      GridFunction &nodes = *mesh->GetNodes();
+      for (int i = 0; i < nodes.Size(); i++)
+      {
+         nodes(i) += 0.02*sin(3.0*nodes(i));
+      }
+
+      for (int order = 1; order <= 3; order++)
+      {
+         H1_FECollection h1_fec(order, dim);
+         L2_FECollection l2_fec(order, dim);
+         for (FiniteElementCollection *fec :
+              { (FiniteElementCollection*)&h1_fec,
+                (FiniteElementCollection*)&l2_fec })
+         {
+            FiniteElementSpace fes(mesh, fec);
+            REQUIRE(TestAssembly(fes, false) < 1e-12);
+            for (auto ordering : { Ordering::byNODES, Ordering::byVDIM })
+            {
+               FiniteElementSpace vfes(mesh, fec, dim, ordering);
+               REQUIRE(TestAssembly(vfes, true) < 1e-12);
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("LinearForm fast assembly fallback", "[LinearForm]")
+{
+   Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+   ND_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   Vector c(2);
+   c = 1.0;
+   VectorConstantCoefficient vone(c);
+
+   // Integrators without device support use the element-by-element assembly
+   LinearForm lf_ref(&fes), lf(&fes);
+   lf_ref.AddDomainIntegrator(new VectorFEDomainLFIntegrator(vone));
+   lf.AddDomainIntegrator(new VectorFEDomainLFIntegrator(vone));
+   lf.UseFastAssembly(true);
+   REQUIRE(!lf.SupportsDevice());
+   lf_ref.Assemble();
+   lf.Assemble();
+   lf -= lf_ref;
+   REQUIRE(lf.Normlinf() == 0.0);
+
+   // The fast assembly follows the updates of the FE space
+   H1_FECollection h1_fec(2, 2);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec);
+   LinearForm b(&h1_fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.UseFastAssembly(true);
+   b.Assemble();
+   REQUIRE(b.Sum() == Approx(1.0));
+   mesh.UniformRefinement();
+   h1_fes.Update();
+   b.Update();
+   b.Assemble();
+   REQUIRE(b.Size() == h1_fes.GetVSize());
+   REQUIRE(b.Sum() == Approx(1.0));
+}
+
+} // namespace linearform_ext
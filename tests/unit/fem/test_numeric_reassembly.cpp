@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace numeric_reassembly
+{
+
+double t_coeff = 0.0;
+
+double coeffFunction(const Vector& x)
+{
+   return 1.0 + t_coeff*x(0)*x(0) + x(1);
+}
+
+void AddIntegrators(BilinearForm &a, Coefficient &coeff)
+{
+   a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a.AddDomainIntegrator(new MassIntegrator(coeff));
+   a.AddBoundaryIntegrator(new MassIntegrator(coeff));
+}
+
+// Reassemble the form several times with a time-dependent coefficient and
+// compare the eliminated system matrix with the one of a new form.
+void TestNumericReassembly(Mesh &mesh, int order, bool threaded)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient coeff(coeffFunction);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   a.UseNumericReassembly();
+   a.UseThreadedAssembly(threaded);
+   AddIntegrators(a, coeff);
+
+   const int *I = NULL, *J = NULL;
+   for (int step = 0; step < 3; step++)
+   {
+      t_coeff = 0.5*step;
+
+      GridFunction x(&fes), b(&fes), b_ref(&fes);
+      x = 0.0;
+      b = 1.0;
+      b_ref = 1.0;
+      Vector X, B;
+      OperatorPtr A;
+      a.Assemble();
+      a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+      if (mesh.Conforming())
+      {
+         // The sparsity pattern is kept between the reassemblies
+         if (step > 0)
+         {
+            REQUIRE(a.SpMat().GetI() == I);
+            REQUIRE(a.SpMat().GetJ() == J);
+         }
+         I = a.SpMat().GetI();
+         J = a.SpMat().GetJ();
+      }
+
+      BilinearForm a_ref(&fes);
+      AddIntegrators(a_ref, coeff);
+      a_ref.Assemble();
+      Vector X_ref, B_ref;
+      OperatorPtr A_ref;
+      a_ref.FormLinearSystem(ess_tdof_list, x, b_ref, A_ref, X_ref, B_ref);
+
+      SparseMatrix *diff = Add(1.0, *A.As<SparseMatrix>(),
+                               -1.0, *A_ref.As<SparseMatrix>());
+      REQUIRE(diff->MaxNorm() < 1e-12 * A_ref.As<SparseMatrix>()->MaxNorm());
+      delete diff;
+      B -= B_ref;
+      REQUIRE(B.Normlinf() < 1e-12 * B_ref.Normlinf());
+   }
+}
+
+TEST_CASE("Numeric reassembly", "[BilinearForm]")
+{
+   for (int t = 0; t < 2; t++)
+   {
+      const bool threaded = (t == 1);
+
+      Mesh mesh2d(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+      TestNumericReassembly(mesh2d, 2, threaded);
+
+      Mesh mesh3d(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      TestNumericReassembly(mesh3d, 2, threaded);
+
+      // Non-conforming mesh: the system matrix is computed with
+      // ConformingAssemble(), which replaces the assembled matrix
+      Mesh ncmesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+      ncmesh.EnsureNCMesh();
+      Array<Refinement> refs;
+      refs.Append(Refinement(0));
+      ncmesh.GeneralRefinement(refs);
+      TestNumericReassembly(ncmesh, 2, threaded);
+   }
+}
+
+} // namespace numeric_reassembly
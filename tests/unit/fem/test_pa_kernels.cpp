@@ -457,4 +457,117 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
    }
 }//test case
 
+// Compare the partial assembly action and diagonal with the full assembly for
+// (D1D,Q1D) pairs selected with the order and the number of 1D quadrature
+// points. This covers the kernels of the switch tables, of the registry and
+// the non-templated fallback.
+void pa_vs_fa_order_quad(int dim, int order, int q1d)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*q1d - 1);
+
+   BilinearForm a_fa(&fes), a_pa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   for (BilinearForm *a : {&a_fa, &a_pa})
+   {
+      DiffusionIntegrator *diffusion = new DiffusionIntegrator;
+      diffusion->SetIntRule(&ir);
+      a->AddDomainIntegrator(new MassIntegrator(&ir));
+      a->AddDomainIntegrator(diffusion);
+      a->Assemble();
+   }
+   a_fa.Finalize();
+
+   Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1e-12 * y_fa.Normlinf());
+
+   Vector diag_fa, diag_pa(fes.GetVSize());
+   a_fa.SpMat().GetDiag(diag_fa);
+   a_pa.AssembleDiagonal(diag_pa);
+   diag_pa -= diag_fa;
+   REQUIRE(diag_pa.Normlinf() < 1e-12 * diag_fa.Normlinf());
+
+   delete mesh;
+}
+
+TEST_CASE("PA kernels order and quadrature", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 6; order++)
+      {
+         const int d1d = order + 1;
+         // Q1D = D1D + 3 is not in the registry: non-templated kernels
+         for (int q1d = d1d; q1d <= d1d + 3; q1d++)
+         {
+            pa_vs_fa_order_quad(dim, order, q1d);
+         }
+      }
+   }
+}
+
+TEST_CASE("PA element ranges", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(5, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(3, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new MassIntegrator);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+
+      const ElementRestriction *R = dynamic_cast<const ElementRestriction*>(
+                                       fes.GetElementRestriction(
+                                          ElementDofOrdering::LEXICOGRAPHIC));
+      REQUIRE(R != NULL);
+      const int n = fes.GetVSize(), ne = mesh->GetNE();
+      Vector x(n), y(n), y_ref(n), xE(R->Height()), yE(R->Height());
+      x.Randomize(1);
+      a.Mult(x, y_ref);
+
+      // Apply the elements in three ranges, in reverse order
+      const int bounds[4] = { 0, ne/3, ne/2, ne };
+      Array<BilinearFormIntegrator*> &integs = *a.GetDBFI();
+      yE = 0.0;
+      for (int k = 2; k >= 0; k--)
+      {
+         R->MultElements(x, xE, bounds[k], bounds[k+1]);
+         for (int i = 0; i < integs.Size(); i++)
+         {
+            REQUIRE(integs[i]->SupportsPAElements());
+            integs[i]->AddMultPAElements(xE, yE, bounds[k], bounds[k+1]);
+         }
+      }
+      R->MultTranspose(yE, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() < 1e-12*y_ref.Normlinf());
+
+      // Transpose restricted to a subset of the dofs
+      Array<int> dofs;
+      for (int i = 0; i < n; i += 3) { dofs.Append(i); }
+      y = -1.0;
+      R->MultTransposeDofs(yE, y, dofs);
+      for (int i = 0; i < n; i++)
+      {
+         const double expected = (i % 3 == 0) ? y_ref(i) : -1.0;
+         REQUIRE(fabs(y(i) - expected) < 1e-12*y_ref.Normlinf());
+      }
+      delete mesh;
+   }
+}
+
 }// namespace pa_kernels
@@ -0,0 +1,106 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace threaded_assembly
+{
+
+double coeffFunction(const Vector& x)
+{
+   return 1.0 + x(0)*x(0) + x(1);
+}
+
+// Return the max norm of the difference between the matrices of the two forms
+double MatrixDifference(BilinearForm &a, BilinearForm &b)
+{
+   SparseMatrix *diff = Add(1.0, a.SpMat(), -1.0, b.SpMat());
+   const double err = diff->MaxNorm();
+   delete diff;
+   return err;
+}
+
+enum class Space { H1, H1Vector, ND };
+
+void TestThreadedAssembly(int dim, Space space, int order)
+{
+   const int ne = 3;
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(ne, ne, Element::TRIANGLE, true, 1.0, 1.0) :
+                new Mesh(ne, ne, ne, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+
+   FiniteElementCollection *fec;
+   if (space == Space::ND) { fec = new ND_FECollection(order, dim); }
+   else { fec = new H1_FECollection(order, dim); }
+   const int vdim = (space == Space::H1Vector) ? dim : 1;
+   FiniteElementSpace fes(mesh, fec, vdim);
+   FunctionCoefficient coeff(coeffFunction);
+
+   BilinearForm a_ref(&fes), a_thr(&fes);
+   a_thr.UseThreadedAssembly();
+   BilinearForm *forms[2] = { &a_ref, &a_thr };
+   for (BilinearForm *a : forms)
+   {
+      switch (space)
+      {
+         case Space::H1:
+            a->AddDomainIntegrator(new DiffusionIntegrator(coeff));
+            a->AddDomainIntegrator(new MassIntegrator(coeff));
+            a->AddBoundaryIntegrator(new MassIntegrator(coeff));
+            break;
+         case Space::H1Vector:
+            a->AddDomainIntegrator(new ElasticityIntegrator(coeff, coeff));
+            a->AddDomainIntegrator(new VectorMassIntegrator(coeff));
+            break;
+         case Space::ND:
+            a->AddDomainIntegrator(new CurlCurlIntegrator(coeff));
+            a->AddDomainIntegrator(new VectorFEMassIntegrator(coeff));
+            break;
+      }
+      a->Assemble();
+      a->Finalize();
+   }
+   REQUIRE(MatrixDifference(a_ref, a_thr) <
+           1e-12 * std::max(1.0, a_ref.SpMat().MaxNorm()));
+
+   // Reassemble after refinement
+   mesh->UniformRefinement();
+   fes.Update();
+   for (BilinearForm *a : forms)
+   {
+      a->Update();
+      a->Assemble();
+      a->Finalize();
+   }
+   REQUIRE(MatrixDifference(a_ref, a_thr) <
+           1e-12 * std::max(1.0, a_ref.SpMat().MaxNorm()));
+
+   delete fec;
+   delete mesh;
+}
+
+TEST_CASE("Threaded assembly", "[BilinearForm]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 2; order++)
+      {
+         TestThreadedAssembly(dim, Space::H1, order);
+         TestThreadedAssembly(dim, Space::H1Vector, order);
+         TestThreadedAssembly(dim, Space::ND, order);
+      }
+   }
+}
+
+} // namespace threaded_assembly
@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace tmop_pa
+{
+
+double weight_fun(const Vector &x)
+{
+   return 1.0 + x(0)*x(0);
+}
+
+// Compare the energy, the action and the gradient action of a TMOP_Integrator
+// computed with partial assembly and element by element.
+void CompareTMOP_PA(Mesh *mesh, int order, bool limited)
+{
+   const int dim = mesh->Dimension();
+   mesh->SetCurvature(order, false, -1,
+                      (order % 2) ? Ordering::byVDIM : Ordering::byNODES);
+   GridFunction &x = *mesh->GetNodes();
+   FiniteElementSpace &fes = *x.FESpace();
+   GridFunction x0(&fes);
+   x0 = x;
+
+   // Perturb the nodes without inverting the elements
+   Vector jitter(x.Size());
+   jitter.Randomize(order);
+   jitter -= 0.5;
+   x.Add(0.1/(3*order), jitter);
+
+   TMOP_QualityMetric *metric;
+   if (dim == 2)
+   {
+      metric = limited ? (TMOP_QualityMetric *) new TMOP_Metric_007 :
+               (TMOP_QualityMetric *) new TMOP_Metric_002;
+   }
+   else
+   {
+      metric = limited ? (TMOP_QualityMetric *) new TMOP_Metric_321 :
+               (TMOP_QualityMetric *) new TMOP_Metric_302;
+   }
+   TargetConstructor tc(limited ? TargetConstructor::IDEAL_SHAPE_GIVEN_SIZE :
+                        TargetConstructor::IDEAL_SHAPE_UNIT_SIZE);
+   tc.SetNodes(x0);
+   GridFunction dist(&fes);
+   dist = 0.5;
+   ConstantCoefficient lim_coeff(3.0);
+   FunctionCoefficient coeff1(weight_fun);
+
+   NonlinearForm nlf(&fes), nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   for (NonlinearForm *form : { &nlf, &nlf_pa })
+   {
+      TMOP_Integrator *integ = new TMOP_Integrator(metric, &tc);
+      if (limited)
+      {
+         integ->SetCoefficient(coeff1);
+         integ->EnableLimiting(x0, dist, lim_coeff);
+      }
+      form->AddDomainIntegrator(integ);
+      form->SetEssentialBC(ess_bdr);
+   }
+   nlf_pa.Setup();
+
+   const double energy = nlf.GetGridFunctionEnergy(x);
+   const double energy_pa = nlf_pa.GetGridFunctionEnergy(x);
+   REQUIRE(fabs(energy - energy_pa) <= 1e-12*fabs(energy));
+
+   Vector X;
+   x.GetTrueDofs(X);
+   const int n = X.Size();
+   Vector y(n), y_pa(n);
+   nlf.Mult(X, y);
+   nlf_pa.Mult(X, y_pa);
+   y_pa -= y;
+   REQUIRE(y_pa.Normlinf() <= 1e-12*y.Normlinf());
+
+   Vector d(n), g(n), g_pa(n);
+   d.Randomize(1);
+   nlf.GetGradient(X).Mult(d, g);
+   nlf_pa.GetGradient(X).Mult(d, g_pa);
+   g_pa -= g;
+   REQUIRE(g_pa.Normlinf() <= 1e-11*g.Normlinf());
+
+   delete metric;
+}
+
+TEST_CASE("TMOP partial assembly", "[TMOP][PartialAssembly]")
+{
+   for (int limited = 0; limited <= 1; limited++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (auto type : { Element::QUADRILATERAL, Element::TRIANGLE })
+         {
+            Mesh *mesh = new Mesh(3, 3, type, true, 1.0, 1.0);
+            CompareTMOP_PA(mesh, order, limited);
+            delete mesh;
+         }
+      }
+      for (int order = 1; order <= 2; order++)
+      {
+         for (auto type : { Element::HEXAHEDRON, Element::TETRAHEDRON })
+         {
+            Mesh *mesh = new Mesh(2, 2, 2, type, true, 1.0, 1.0, 1.0);
+            CompareTMOP_PA(mesh, order, limited);
+            delete mesh;
+         }
+      }
+   }
+}
+
+} // namespace tmop_pa
@@ -111,4 +111,61 @@ TEST_CASE("MemoryManager", "[MemoryManager]")
    }
 }
 
+TEST_CASE("Host memory pool", "[MemoryManager]")
+{
+   const MemoryType h_mt = Device::GetHostMemoryType();
+   Device::SetHostMemoryType(MemoryType::HOST_POOL);
+
+   MemoryPoolStats s0, s1;
+   MemoryManager::GetHostPoolStats(s0);
+   for (int it = 0; it < 10; it++)
+   {
+      Vector x(1000), y(1000);
+      REQUIRE(x.GetMemory().GetMemoryType() == MemoryType::HOST_POOL);
+      REQUIRE(reinterpret_cast<uintptr_t>(x.GetData()) % 64 == 0);
+      x = 1.0;
+      y = 2.0;
+      REQUIRE(x*y == Approx(2000.0));
+      // Resizing reallocates from the pool
+      x.SetSize(3000);
+      x = 1.0;
+      REQUIRE(x.Norml1() == Approx(3000.0));
+   }
+   MemoryManager::GetHostPoolStats(s1);
+   REQUIRE(s1.allocations - s0.allocations == 30);
+   // All allocations after the first iteration reuse the cached blocks
+   REQUIRE(s1.pool_hits - s0.pool_hits >= 27);
+   REQUIRE(s1.bytes_in_use == s0.bytes_in_use);
+   REQUIRE(s1.peak_bytes_in_use >= s0.bytes_in_use + 4000*sizeof(double));
+
+   // Requests larger than the largest size class, arrays and wrapped data
+   {
+      Vector big(5000000);
+      big = 1.0;
+      REQUIRE(big.Sum() == Approx(5000000.0));
+      Array<int> a(100);
+      a = 3;
+      REQUIRE(a.Sum() == 300);
+      double *data = new double[10];
+      Vector w;
+      w.NewDataAndSize(data, 10);
+      w.MakeDataOwner();
+      w = 2.0;
+      REQUIRE(w.Sum() == Approx(20.0));
+   }
+   TestMemoryTypes(MemoryType::HOST_POOL, true);
+   TestMemoryTypes(MemoryType::HOST_POOL, false);
+   MemoryManager::GetHostPoolStats(s1);
+   REQUIRE(s1.bytes_in_use == s0.bytes_in_use);
+
+   Device::SetHostMemoryType(h_mt);
+   REQUIRE(Vector(10).GetMemory().GetMemoryType() == h_mt);
+
+   MemoryManager::GetHostPoolStats(s0);
+   REQUIRE(s0.bytes_cached > 0);
+   MemoryManager::ReleaseHostPool();
+   MemoryManager::GetHostPoolStats(s1);
+   REQUIRE(s1.bytes_cached < s0.bytes_cached);
+}
+
 #endif // _WIN32
@@ -0,0 +1,188 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <sstream>
+
+using namespace mfem;
+
+namespace profiler
+{
+
+// Busy loop of about the given number of seconds
+void Spin(double seconds)
+{
+   StopWatch sw;
+   sw.Start();
+   while (sw.RealTime() < seconds) { }
+}
+
+}
+
+TEST_CASE("Profiler", "[Profiler]")
+{
+   Profiler &prof = Profiler::Get();
+   prof.Reset();
+   prof.Enable();
+
+   SECTION("Nested regions")
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         ProfilerRegion outer("outer");
+         profiler::Spin(1e-4);
+         {
+            ProfilerRegion inner("inner");
+            prof.AddBytes(100.0);
+            profiler::Spin(1e-4);
+         }
+         ProfilerRegion other("other");
+         ProfilerRegion inner("inner");
+         prof.AddMPIWait(0.5);
+      }
+
+      const std::vector<Profiler::Region> &regions = prof.GetRegions();
+      // root, outer, outer/inner, outer/other and outer/other/inner
+      REQUIRE(regions.size() == 5);
+      const int outer = prof.FindRegion("outer");
+      const int inner = prof.FindRegion("outer/inner");
+      const int inner2 = prof.FindRegion("outer/other/inner");
+      REQUIRE(outer > 0);
+      REQUIRE(inner > 0);
+      REQUIRE(inner2 > 0);
+      REQUIRE(inner != inner2);
+      REQUIRE(prof.FindRegion("inner") == -1);
+      REQUIRE(prof.FindRegion("outer/missing") == -1);
+
+      const Profiler::Region &r_outer = regions[outer];
+      const Profiler::Region &r_inner = regions[inner];
+      REQUIRE(r_outer.calls == 3);
+      REQUIRE(r_inner.calls == 3);
+      REQUIRE(r_inner.parent == outer);
+      REQUIRE(r_inner.depth == 2);
+      REQUIRE(r_inner.inclusive >= 3e-4);
+      REQUIRE(r_outer.Exclusive() >= 3e-4);
+      REQUIRE(r_outer.inclusive >= r_outer.children_time);
+      REQUIRE(r_inner.bytes == 300.0);
+      REQUIRE(regions[inner2].mpi_wait == 1.5);
+      REQUIRE(r_outer.mpi_wait == 0.0);
+
+      std::ostringstream os;
+      prof.Print(os);
+      REQUIRE(os.str().find("  inner") != std::string::npos);
+   }
+
+   SECTION("Trace")
+   {
+      prof.EnableTrace();
+      for (int i = 0; i < 2; i++)
+      {
+         ProfilerRegion outer("outer");
+         ProfilerRegion inner("in\"ner");
+      }
+      prof.EnableTrace(false);
+      {
+         ProfilerRegion untraced("untraced");
+      }
+      const std::vector<Profiler::Event> &events = prof.GetEvents();
+      REQUIRE(events.size() == 4);
+      REQUIRE(events[0].region == prof.FindRegion("outer"));
+      REQUIRE(events[1].start >= events[0].start);
+      REQUIRE(events[1].duration <= events[0].duration);
+      REQUIRE(events[2].start >= events[1].start + events[1].duration);
+
+      std::ostringstream os;
+      prof.PrintTrace(os, 3);
+      const std::string trace = os.str();
+      REQUIRE(trace.find("{\"traceEvents\": [") == 0);
+      REQUIRE(trace.find("\"name\": \"in\\\"ner\"") != std::string::npos);
+      REQUIRE(trace.find("\"pid\": 3") != std::string::npos);
+      REQUIRE(trace.find("untraced") == std::string::npos);
+   }
+
+   SECTION("Disabled")
+   {
+      prof.Enable(false);
+      {
+         ProfilerRegion region("region");
+         prof.AddBytes(1.0);
+      }
+      REQUIRE(prof.GetRegions().size() == 1);
+      REQUIRE(prof.GetRegions()[0].bytes == 0.0);
+   }
+
+#ifdef MFEM_USE_PROFILER
+   SECTION("Library regions")
+   {
+      Mesh mesh(4, 4, Element::QUADRILATERAL);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      Vector x(fes.GetVSize()), y(fes.GetVSize());
+      x = 1.0;
+      a.Mult(x, y);
+      REQUIRE(prof.FindRegion("BilinearForm::Assemble/"
+                              "PABilinearFormExtension::Assemble") > 0);
+      const int r = prof.FindRegion("PABilinearFormExtension::Mult/"
+                                    "ElementRestriction::Mult");
+      REQUIRE(r > 0);
+      REQUIRE(prof.GetRegions()[r].bytes > 0.0);
+   }
+#endif
+
+   prof.Enable(false);
+   prof.Reset();
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Profiler aggregation", "[Profiler][Parallel]")
+{
+   int rank, size;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+   Profiler &prof = Profiler::Get();
+   prof.Reset();
+   prof.Enable();
+   prof.EnableTrace();
+   {
+      ProfilerRegion all("all ranks");
+      if (rank == 0) { ProfilerRegion root("rank 0"); }
+   }
+   prof.EnableTrace(false);
+   prof.Enable(false);
+
+   std::ostringstream summary, trace;
+   prof.Print(MPI_COMM_WORLD, summary);
+   prof.PrintTrace(MPI_COMM_WORLD, trace);
+   if (rank == 0)
+   {
+      REQUIRE(summary.str().find("all ranks") != std::string::npos);
+      REQUIRE(summary.str().find("  rank 0") != std::string::npos);
+      std::ostringstream pid;
+      pid << "\"pid\": " << size - 1 << ",";
+      REQUIRE(trace.str().find(pid.str()) != std::string::npos);
+   }
+   else
+   {
+      REQUIRE(summary.str().empty());
+      REQUIRE(trace.str().empty());
+   }
+   prof.Reset();
+}
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,93 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#ifdef MFEM_USE_THREADS
+
+#include <atomic>
+#include <cmath>
+
+using namespace mfem;
+
+TEST_CASE("Thread pool", "[Threads]")
+{
+   ThreadPool &pool = ThreadPool::Get();
+   const int nthreads = pool.NumThreads();
+   pool.Setup(4);
+   REQUIRE(pool.NumThreads() == 4);
+
+   SECTION("Each index is processed once")
+   {
+      for (int N : { 1, 3, 4, 7, 100, 10007 })
+      {
+         Array<int> count(N);
+         count = 0;
+         int *c = count.GetData();
+         pool.Forall(N, [=](int i) { c[i]++; });
+         REQUIRE(count.Min() == 1);
+         REQUIRE(count.Max() == 1);
+      }
+   }
+
+   SECTION("Uneven work")
+   {
+      // The cost of the first indices is much higher than the others, as in
+      // the element loops on locally refined meshes.
+      const int N = 1000;
+      Vector y(N);
+      double *d_y = y.GetData();
+      std::atomic<int> done(0);
+      pool.Forall(N, [&](int i)
+      {
+         const int work = (i < N/8) ? 20000 : 10;
+         double s = 0.0;
+         for (int k = 0; k < work; k++) { s += std::sin(1e-3*k); }
+         d_y[i] = s;
+         done++;
+      });
+      REQUIRE(done == N);
+      REQUIRE(y(0) == Approx(y(N/8-1)));
+      REQUIRE(y(N-1) == Approx(y(N/8)));
+   }
+
+   SECTION("Nested loops run sequentially")
+   {
+      const int N = 16;
+      Array<int> sum(N), in_loop(N);
+      int *s = sum.GetData(), *l = in_loop.GetData();
+      pool.Forall(N, [=](int i)
+      {
+         l[i] = ThreadPool::InLoop();
+         s[i] = 0;
+         ThreadPool::Get().Forall(i, [=](int j) { s[i] += j; });
+      });
+      for (int i = 0; i < N; i++) { REQUIRE(sum[i] == i*(i-1)/2); }
+      REQUIRE(in_loop.Min() == 1);
+      REQUIRE(!ThreadPool::InLoop());
+   }
+
+   SECTION("First touch preserves the data")
+   {
+      const int N = 1 << 18;
+      Vector x(N), x0(N);
+      for (int i = 0; i < N; i++) { x(i) = i; }
+      x0 = x;
+      pool.FirstTouch(x.GetData(), N*sizeof(double));
+      x -= x0;
+      REQUIRE(x.Normlinf() == 0.0);
+   }
+
+   pool.Setup(nthreads);
+}
+
+#endif // MFEM_USE_THREADS
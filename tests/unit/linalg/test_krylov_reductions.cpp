@@ -0,0 +1,140 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace krylov_reductions
+{
+
+// Return the relative residual of the solution x of A x = b.
+double RelResidual(const Operator &A, const Vector &b, const Vector &x)
+{
+   Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   return r.Norml2()/b.Norml2();
+}
+
+TEST_CASE("Pipelined CG", "[CGSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   Vector b(A.Height()), x_cg(A.Height()), x_pcg(A.Height());
+   b.Randomize(1);
+
+   for (int use_prec = 0; use_prec <= 1; use_prec++)
+   {
+      GSSmoother M(A);
+      CGSolver cg;
+      PipelinedCGSolver pcg;
+      for (IterativeSolver *s : { (IterativeSolver*)&cg,
+                                  (IterativeSolver*)&pcg })
+      {
+         s->SetRelTol(1e-10);
+         s->SetMaxIter(500);
+         s->SetPrintLevel(-1);
+         if (use_prec) { s->SetPreconditioner(M); }
+         s->SetOperator(A);
+      }
+      x_cg = 0.0;
+      x_pcg = 0.0;
+      cg.Mult(b, x_cg);
+      pcg.Mult(b, x_pcg);
+
+      REQUIRE(cg.GetConverged());
+      REQUIRE(pcg.GetConverged());
+      // In exact arithmetic the iterates are the same as those of CG
+      REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+      REQUIRE(RelResidual(A, b, x_pcg) < 1e-8);
+      x_pcg -= x_cg;
+      REQUIRE(x_pcg.Normlinf() < 1e-7*x_cg.Normlinf());
+   }
+
+   // Zero right-hand side and non-zero initial guess
+   PipelinedCGSolver pcg;
+   pcg.SetOperator(A);
+   pcg.SetAbsTol(1e-12);
+   pcg.SetMaxIter(500);
+   pcg.iterative_mode = true;
+   b = 0.0;
+   x_pcg.Randomize(2);
+   pcg.Mult(b, x_pcg);
+   REQUIRE(pcg.GetConverged());
+   REQUIRE(x_pcg.Normlinf() < 1e-8);
+}
+
+TEST_CASE("GMRES with CGS2", "[GMRESSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   Vector velocity(2);
+   velocity(0) = 20.0;
+   velocity(1) = 10.0;
+   VectorConstantCoefficient vel(velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(vel));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+
+   Vector b(A.Height()), x_mgs(A.Height()), x_cgs2(A.Height());
+   b.Randomize(3);
+   DSmoother M(A);
+
+   for (int flexible = 0; flexible <= 1; flexible++)
+   {
+      GMRESSolver gmres_mgs, gmres_cgs2;
+      FGMRESSolver fgmres_mgs, fgmres_cgs2;
+      gmres_cgs2.SetOrthogonalization(GMRESSolver::CGS2);
+      fgmres_cgs2.SetOrthogonalization(GMRESSolver::CGS2);
+      IterativeSolver *mgs = flexible ? (IterativeSolver*)&fgmres_mgs :
+                             (IterativeSolver*)&gmres_mgs;
+      IterativeSolver *cgs2 = flexible ? (IterativeSolver*)&fgmres_cgs2 :
+                              (IterativeSolver*)&gmres_cgs2;
+      for (IterativeSolver *s : { mgs, cgs2 })
+      {
+         s->SetRelTol(1e-10);
+         s->SetMaxIter(1000);
+         s->SetPreconditioner(M);
+         s->SetOperator(A);
+      }
+      x_mgs = 0.0;
+      x_cgs2 = 0.0;
+      mgs->Mult(b, x_mgs);
+      cgs2->Mult(b, x_cgs2);
+
+      REQUIRE(mgs->GetConverged());
+      REQUIRE(cgs2->GetConverged());
+      REQUIRE(std::abs(cgs2->GetNumIterations() -
+                       mgs->GetNumIterations()) <= 1);
+      REQUIRE(RelResidual(A, b, x_cgs2) < 1e-8);
+      x_cgs2 -= x_mgs;
+      REQUIRE(x_cgs2.Normlinf() < 1e-7*x_mgs.Normlinf());
+   }
+}
+
+} // namespace krylov_reductions
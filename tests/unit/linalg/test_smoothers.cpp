@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Multicolor Gauss-Seidel", "[GSSmoother]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   ConstantCoefficient one(1.0);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+   const int n = A.Height();
+
+   Table colors;
+   A.GetRowColoring(colors);
+
+   SECTION("Coloring")
+   {
+      // Each row has one color, different from those of its neighbors
+      Array<int> color(n);
+      color = -1;
+      for (int c = 0; c < colors.Size(); c++)
+      {
+         for (int k = 0; k < colors.RowSize(c); k++)
+         {
+            const int i = colors.GetRow(c)[k];
+            REQUIRE(color[i] == -1);
+            color[i] = c;
+         }
+      }
+      REQUIRE(color.Min() == 0);
+      for (int i = 0; i < n; i++)
+      {
+         for (int j = A.GetI()[i]; j < A.GetI()[i+1]; j++)
+         {
+            const int col = A.GetJ()[j];
+            REQUIRE((col == i || color[col] != color[i]));
+         }
+      }
+      // The greedy coloring of a Q2 matrix needs at most 25 colors
+      REQUIRE(colors.Size() <= 25);
+   }
+
+   SECTION("Smoother")
+   {
+      Vector x(n), b(n), r(n);
+      b.Randomize(1);
+
+      // Symmetric multicolor Gauss-Seidel is a symmetric preconditioner
+      GSSmoother S(A);
+      S.SetMulticolor();
+      CGSolver cg;
+      cg.SetOperator(A);
+      cg.SetPreconditioner(S);
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(200);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-8*b.Norml2());
+
+      // After a forward (backward) sweep, the rows of the last (first) color
+      // are solved exactly
+      x.Randomize(3);
+      A.Gauss_Seidel_forw(b, x, colors);
+      A.Mult(x, r);
+      r -= b;
+      const int last = colors.Size() - 1;
+      for (int k = 0; k < colors.RowSize(last); k++)
+      {
+         REQUIRE(fabs(r(colors.GetRow(last)[k])) < 1e-12*b.Normlinf());
+      }
+      A.Gauss_Seidel_back(b, x, colors);
+      A.Mult(x, r);
+      r -= b;
+      for (int k = 0; k < colors.RowSize(0); k++)
+      {
+         REQUIRE(fabs(r(colors.GetRow(0)[k])) < 1e-12*b.Normlinf());
+      }
+   }
+}
+
+TEST_CASE("BlockILU level scheduling", "[ILU]")
+{
+   // For a block tridiagonal matrix the block ILU(0) factorization is exact.
+   // The forward and backward substitutions have one level per block row.
+   const int nb = 200, bs = 2;
+   SparseMatrix A(nb*bs);
+   for (int i = 0; i < nb*bs; i++)
+   {
+      const int ib = i/bs;
+      for (int jb = std::max(0, ib-1); jb <= std::min(nb-1, ib+1); jb++)
+      {
+         for (int k = 0; k < bs; k++)
+         {
+            const int j = jb*bs + k;
+            A.Set(i, j, (i == j) ? 4.0 + 0.01*(i % 7) : -0.5 - 0.1*k);
+         }
+      }
+   }
+   A.Finalize();
+
+   BlockILU ilu(A, bs, BlockILU::Reordering::NONE);
+   Vector b(nb*bs), x(nb*bs), r(nb*bs);
+   b.Randomize(2);
+   ilu.Mult(b, x);
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Normlinf() < 1e-12*b.Normlinf());
+
+   // Block diagonal matrix: a single level
+   SparseMatrix D(nb*bs);
+   for (int i = 0; i < nb*bs; i++)
+   {
+      D.Set(i, i, 2.0 + i);
+      D.Set(i, i ^ 1, 1.0);
+   }
+   D.Finalize();
+   BlockILU ilu_d(D, bs, BlockILU::Reordering::MINIMUM_DISCARDED_FILL);
+   ilu_d.Mult(b, x);
+   D.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Normlinf() < 1e-12*b.Normlinf());
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparse_formats
+{
+
+// Compare the action and the transpose action of the matrix in the given
+// format with those of the CSR arrays.
+void CompareWithCSR(SparseMatrix &A, SparseMatrix::MultFormat format,
+                    int block_size = 0)
+{
+   Vector x(A.Width()), xt(A.Height());
+   Vector y_csr(A.Height()), y_fmt(A.Height());
+   Vector yt_csr(A.Width()), yt_fmt(A.Width());
+   x.Randomize(1);
+   xt.Randomize(2);
+
+   A.Mult(x, y_csr);
+   A.MultTranspose(xt, yt_csr);
+
+   A.UseMultFormat(format, block_size);
+   A.Mult(x, y_fmt);
+   A.MultTranspose(xt, yt_fmt);
+   y_fmt.Add(0.5, y_csr);
+   A.AddMult(x, y_fmt, -1.5);
+   yt_fmt -= yt_csr;
+   A.UseMultFormat(SparseMatrix::CSR);
+
+   REQUIRE(y_fmt.Normlinf() < 1e-12*std::max(1.0, y_csr.Normlinf()));
+   REQUIRE(yt_fmt.Normlinf() < 1e-12*std::max(1.0, yt_csr.Normlinf()));
+}
+
+SparseMatrix *ElasticityMatrix(Mesh &mesh, int order, Ordering::Type ordering)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, ordering);
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble();
+   a.Finalize();
+   return a.LoseMat();
+}
+
+TEST_CASE("Sparse matrix formats", "[SparseMatrix]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      for (int order = 1; order <= 2; order++)
+      {
+         SparseMatrix *A = ElasticityMatrix(*mesh, order, Ordering::byVDIM);
+         REQUIRE(BlockCSRMatrix::DetectBlockSize(*A) == dim);
+
+         CompareWithCSR(*A, SparseMatrix::BCSR);
+         CompareWithCSR(*A, SparseMatrix::BCSR, 1);
+         CompareWithCSR(*A, SparseMatrix::SELL);
+
+         A->UseMultFormat(SparseMatrix::BCSR);
+         const BlockCSRMatrix *B =
+            dynamic_cast<const BlockCSRMatrix*>(A->GetMultFormatMatrix());
+         REQUIRE(B != NULL);
+         REQUIRE(B->GetBlockSize() == dim);
+         REQUIRE(B->NumStoredEntries() >= A->NumNonZeroElems());
+         REQUIRE(B->NumStoredEntries() <= 1.25*A->NumNonZeroElems());
+         delete A;
+
+         // With byNODES ordering, the blocks contain explicit zeros
+         A = ElasticityMatrix(*mesh, order, Ordering::byNODES);
+         CompareWithCSR(*A, SparseMatrix::BCSR, dim);
+         CompareWithCSR(*A, SparseMatrix::SELL);
+         delete A;
+      }
+      delete mesh;
+   }
+
+   // Rectangular matrix with rows of very different lengths and empty rows
+   SparseMatrix R(37, 29);
+   for (int i = 0; i < 37; i++)
+   {
+      if (i % 5 == 0) { continue; }
+      const int len = (i % 7 == 0) ? 29 : 1 + i % 3;
+      for (int k = 0; k < len; k++) { R.Set(i, (3*i + 7*k) % 29, 1.0 + i + k); }
+   }
+   R.Finalize();
+   CompareWithCSR(R, SparseMatrix::SELL);
+}
+
+} // namespace sparse_formats
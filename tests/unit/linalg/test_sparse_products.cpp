@@ -0,0 +1,117 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparse_products
+{
+
+// Max norm of A - B, where A and B have the same size.
+double MaxDiff(const SparseMatrix &A, const SparseMatrix &B)
+{
+   SparseMatrix *D = Add(1.0, A, -1.0, B);
+   const double diff = D->MaxNorm();
+   delete D;
+   return diff;
+}
+
+TEST_CASE("Sparse matrix products", "[SparseMatrix]")
+{
+   // The sizes are large enough for the products to be split in several
+   // tasks when a multithreaded host backend is enabled.
+   Mesh mesh(6, 6, 6, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fine_fes(&mesh, &fec);
+   const int coarse_size = (fine_fes.GetVSize() + 2)/3;
+
+   BilinearForm a(&fine_fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix &A = a.SpMat();
+
+   // Prolongation-like rectangular matrix with a few entries per row
+   SparseMatrix P(fine_fes.GetVSize(), coarse_size);
+   for (int i = 0; i < P.Height(); i++)
+   {
+      P.Set(i, i/3, 1.0);
+      P.Set(i, (7*i + 1) % coarse_size, 0.5 + 0.001*i);
+   }
+   P.Finalize();
+
+   SECTION("Transpose")
+   {
+      SparseMatrix *Pt = Transpose(P);
+      SparseMatrix *Pt_ref = TransposeAbstractSparseMatrix(P, 0);
+      REQUIRE(Pt->Height() == Pt_ref->Height());
+      REQUIRE(Pt->Width() == Pt_ref->Width());
+      REQUIRE(Pt->NumNonZeroElems() == Pt_ref->NumNonZeroElems());
+      REQUIRE(MaxDiff(*Pt, *Pt_ref) == 0.0);
+      for (int i = 0; i < Pt->Height(); i++)
+      {
+         // The rows of the transpose are sorted
+         for (int j = Pt->GetI()[i] + 1; j < Pt->GetI()[i+1]; j++)
+         {
+            REQUIRE(Pt->GetJ()[j-1] < Pt->GetJ()[j]);
+         }
+      }
+      delete Pt_ref;
+
+      // Update the values of the transpose using the map
+      Array<int> P_to_Pt;
+      SparseMatrix *Pt2 = Transpose(P, P_to_Pt);
+      REQUIRE(MaxDiff(*Pt, *Pt2) == 0.0);
+      P *= 2.0;
+      *Pt *= 2.0;
+      TransposeValues(P, P_to_Pt, *Pt2);
+      REQUIRE(MaxDiff(*Pt, *Pt2) == 0.0);
+      delete Pt2;
+      delete Pt;
+   }
+
+   SECTION("Product and RAP")
+   {
+      SparseMatrix *AP = Mult(A, P);
+      SparseMatrix *AP_ref = MultAbstractSparseMatrix(A, P);
+      REQUIRE(AP->NumNonZeroElems() == AP_ref->NumNonZeroElems());
+      REQUIRE(MaxDiff(*AP, *AP_ref) < 1e-12*AP_ref->MaxNorm());
+
+      // Numeric-only product with the output sparsity pattern
+      A *= 3.0;
+      *AP_ref *= 3.0;
+      Mult(A, P, AP);
+      REQUIRE(MaxDiff(*AP, *AP_ref) < 1e-12*AP_ref->MaxNorm());
+
+      SparseMatrix *Pt = Transpose(P);
+      SparseMatrix *PtAP = RAP(A, *Pt);
+      SparseMatrix *PtAP_ref = MultAbstractSparseMatrix(*Pt, *AP_ref);
+      REQUIRE(MaxDiff(*PtAP, *PtAP_ref) < 1e-12*PtAP_ref->MaxNorm());
+      SparseMatrix *PtAP2 = RAP(P, A, P);
+      REQUIRE(MaxDiff(*PtAP2, *PtAP_ref) < 1e-12*PtAP_ref->MaxNorm());
+
+      A *= 0.5;
+      *PtAP_ref *= 0.5;
+      RAP(A, *Pt, PtAP);
+      REQUIRE(MaxDiff(*PtAP, *PtAP_ref) < 1e-12*PtAP_ref->MaxNorm());
+
+      delete PtAP2;
+      delete PtAP_ref;
+      delete PtAP;
+      delete Pt;
+      delete AP_ref;
+      delete AP;
+   }
+}
+
+} // namespace sparse_products
@@ -91,3 +91,481 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+TEST_CASE("Compact element storage", "[Mesh]")
+{
+   for (int type = 0; type < 4; type++)
+   {
+      Mesh *mesh;
+      if (type == 0)
+      {
+         mesh = new Mesh(4, 3, Element::TRIANGLE, true);
+      }
+      else if (type == 1)
+      {
+         mesh = new Mesh(2, 3, 2, Element::TETRAHEDRON, true);
+      }
+      else if (type == 2)
+      {
+         mesh = new Mesh(2, 3, 2, Element::HEXAHEDRON, true);
+      }
+      else
+      {
+         mesh = new Mesh(2, 2, 3, Element::WEDGE, true);
+      }
+      Mesh ref(*mesh);
+      mesh->SetCompactStorage();
+      REQUIRE(mesh->UsesCompactStorage());
+
+      for (int step = 0; step < 3; step++)
+      {
+         if (step == 1)
+         {
+            mesh->UniformRefinement();
+            ref.UniformRefinement();
+         }
+         else if (step == 2)
+         {
+            Array<int> ordering;
+            ref.GetGeckoElementOrdering(ordering);
+            mesh->ReorderElements(ordering);
+            ref.ReorderElements(ordering);
+         }
+
+         const Mesh::CompactElements &ce = mesh->GetCompactElements();
+         REQUIRE(ce.Size() == mesh->GetNE());
+         for (int i = 0; i < mesh->GetNE(); i++)
+         {
+            const Element *el = mesh->GetElement(i);
+            REQUIRE(ce.geometries[i] == el->GetGeometryType());
+            REQUIRE(ce.attributes[i] == el->GetAttribute());
+            REQUIRE(ce.GetNVertices(i) == el->GetNVertices());
+            for (int j = 0; j < el->GetNVertices(); j++)
+            {
+               REQUIRE(ce.GetVertices(i)[j] == el->GetVertices()[j]);
+            }
+         }
+         const Mesh::CompactElements &cb = mesh->GetCompactBdrElements();
+         REQUIRE(cb.Size() == mesh->GetNBE());
+
+         // The tables built from the flat arrays are the same
+         REQUIRE(mesh->GetNEdges() == ref.GetNEdges());
+         REQUIRE(mesh->GetNFaces() == ref.GetNFaces());
+         Table *v2e = mesh->GetVertexToElementTable();
+         Table *v2e_ref = ref.GetVertexToElementTable();
+         REQUIRE(v2e->Size_of_connections() == v2e_ref->Size_of_connections());
+         for (int k = 0; k < v2e->Size_of_connections(); k++)
+         {
+            REQUIRE(v2e->GetJ()[k] == v2e_ref->GetJ()[k]);
+         }
+         delete v2e;
+         delete v2e_ref;
+
+         Array<int> edges, edges_ref, cor, faces, faces_ref;
+         for (int i = 0; i < mesh->GetNE(); i++)
+         {
+            mesh->GetElementEdges(i, edges, cor);
+            ref.GetElementEdges(i, edges_ref, cor);
+            REQUIRE(edges == edges_ref);
+            if (mesh->Dimension() == 3)
+            {
+               mesh->GetElementFaces(i, faces, cor);
+               ref.GetElementFaces(i, faces_ref, cor);
+               REQUIRE(faces == faces_ref);
+            }
+         }
+         for (int i = 0; i < mesh->GetNBE(); i++)
+         {
+            mesh->GetBdrElementEdges(i, edges, cor);
+            ref.GetBdrElementEdges(i, edges_ref, cor);
+            REQUIRE(edges == edges_ref);
+         }
+      }
+
+      mesh->SetAttribute(0, 5);
+      REQUIRE(mesh->GetCompactElements().attributes[0] == 5);
+
+      mesh->SetCompactStorage(false);
+      REQUIRE(!mesh->UsesCompactStorage());
+      delete mesh;
+   }
+}
+
+namespace bvh
+{
+
+// Smooth map of the unit square/cube to itself
+void Deform(const Vector &x, Vector &y)
+{
+   y = x;
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s *= sin(M_PI*x(d)); }
+   for (int d = 0; d < x.Size(); d++) { y(d) += 0.05*s*(d + 1); }
+}
+
+// Check that FindPoints() locates random points inside each element
+void CheckFindPoints(Mesh &mesh)
+{
+   const int ne = mesh.GetNE(), sdim = mesh.SpaceDimension();
+   DenseMatrix points(sdim, ne + 1);
+   IsoparametricTransformation T;
+   IntegrationPoint ip;
+   Vector x;
+   for (int e = 0; e < ne; e++)
+   {
+      // Random convex combination of the vertices of the reference element
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(e);
+      const IntegrationRule *vert = Geometries.GetVertices(geom);
+      double p[3] = { 0.0, 0.0, 0.0 }, sum = 0.0;
+      for (int v = 0; v < vert->GetNPoints(); v++)
+      {
+         const double w = 0.1 + rand()/(double)RAND_MAX;
+         const IntegrationPoint &vp = vert->IntPoint(v);
+         p[0] += w*vp.x;
+         p[1] += w*vp.y;
+         p[2] += w*vp.z;
+         sum += w;
+      }
+      ip.Set3(p[0]/sum, p[1]/sum, p[2]/sum);
+      mesh.GetElementTransformation(e, &T);
+      points.GetColumnReference(e, x);
+      T.Transform(ip, x);
+   }
+   // A point outside of the mesh
+   for (int d = 0; d < sdim; d++) { points(d, ne) = 2.0; }
+
+   // The default tolerances are too tight for the small refined elements
+   InverseElementTransformation inv_tr;
+   inv_tr.SetReferenceTol(1e-12);
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, false, &inv_tr) == ne);
+   REQUIRE(elem_ids[ne] == -1);
+   Vector y(sdim);
+   for (int e = 0; e < ne; e++)
+   {
+      REQUIRE(elem_ids[e] == e);
+      mesh.GetElementTransformation(e, &T);
+      T.Transform(ips[e], y);
+      points.GetColumnReference(e, x);
+      y -= x;
+      REQUIRE(y.Normlinf() < 1e-8);
+   }
+
+   // The element boxes contain the nodes of the elements
+   const ElementBVH &tree = mesh.GetElementBVH();
+   REQUIRE(tree.IsUpToDate(mesh));
+   REQUIRE(tree.GetNE() == ne);
+   for (int e = 0; e < ne; e++)
+   {
+      const double *box = tree.GetElementBox(e);
+      mesh.GetElementTransformation(e, &T);
+      const DenseMatrix &pm = T.GetPointMat();
+      for (int j = 0; j < pm.Width(); j++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            REQUIRE(box[d] <= pm(d,j));
+            REQUIRE(pm(d,j) <= box[sdim+d]);
+         }
+      }
+   }
+   REQUIRE(tree.GetDepth() <= 2 + (int)ceil(log2(ne + 1.0)));
+}
+
+}
+
+TEST_CASE("FindPoints with ElementBVH", "[Mesh]")
+{
+   for (int type = 0; type < 4; type++)
+   {
+      Mesh *mesh;
+      if (type == 0)
+      {
+         mesh = new Mesh(4, 3, Element::TRIANGLE, true);
+      }
+      else if (type == 1)
+      {
+         mesh = new Mesh(4, 3, Element::QUADRILATERAL, true);
+      }
+      else if (type == 2)
+      {
+         mesh = new Mesh(2, 3, 2, Element::TETRAHEDRON, true);
+      }
+      else
+      {
+         mesh = new Mesh(2, 3, 2, Element::HEXAHEDRON, true);
+      }
+
+      SECTION("Straight and curved elements")
+      {
+         bvh::CheckFindPoints(*mesh);
+         mesh->SetCurvature(3);
+         mesh->Transform(bvh::Deform);
+         bvh::CheckFindPoints(*mesh);
+      }
+
+      SECTION("Refinement and moved nodes")
+      {
+         // Mark the tetrahedra for local refinement
+         if (type == 2) { mesh->Finalize(true); }
+         mesh->SetCurvature(2);
+         bvh::CheckFindPoints(*mesh);
+
+         // Incremental updates of the tree
+         Array<int> marked;
+         for (int e = 0; e < mesh->GetNE(); e += 3) { marked.Append(e); }
+         mesh->GeneralRefinement(marked);
+         REQUIRE(mesh->GetElementBVH().GetNE() == mesh->GetNE());
+         bvh::CheckFindPoints(*mesh);
+         mesh->UniformRefinement();
+         bvh::CheckFindPoints(*mesh);
+
+         // Refit of the boxes
+         Vector disp(mesh->GetNodes()->Size());
+         disp = 0.5;
+         mesh->MoveNodes(disp);
+         bvh::CheckFindPoints(*mesh);
+
+         // Nodes modified directly
+         *mesh->GetNodes() -= 0.5;
+         mesh->NodesUpdated();
+         bvh::CheckFindPoints(*mesh);
+      }
+      delete mesh;
+   }
+}
+
+namespace binary
+{
+
+double Func(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f *= sin(2.0*x(d)) + x(d); }
+   return f;
+}
+
+// Check that the meshes are identical, up to the last bit of the coordinates.
+void CheckSameMesh(Mesh &a, Mesh &b)
+{
+   REQUIRE(a.Dimension() == b.Dimension());
+   REQUIRE(a.SpaceDimension() == b.SpaceDimension());
+   REQUIRE(a.GetNV() == b.GetNV());
+   REQUIRE(a.GetNE() == b.GetNE());
+   REQUIRE(a.GetNBE() == b.GetNBE());
+   REQUIRE(a.GetNEdges() == b.GetNEdges());
+   REQUIRE(a.GetNFaces() == b.GetNFaces());
+   REQUIRE(!a.Nonconforming() == !b.Nonconforming());
+
+   Array<int> va, vb;
+   for (int i = 0; i < a.GetNE(); i++)
+   {
+      REQUIRE(a.GetElementBaseGeometry(i) == b.GetElementBaseGeometry(i));
+      REQUIRE(a.GetAttribute(i) == b.GetAttribute(i));
+      a.GetElementVertices(i, va);
+      b.GetElementVertices(i, vb);
+      REQUIRE(va == vb);
+   }
+   for (int i = 0; i < a.GetNBE(); i++)
+   {
+      REQUIRE(a.GetBdrAttribute(i) == b.GetBdrAttribute(i));
+      a.GetBdrElementVertices(i, va);
+      b.GetBdrElementVertices(i, vb);
+      REQUIRE(va == vb);
+   }
+
+   Vector xa, xb;
+   a.GetVertices(xa);
+   b.GetVertices(xb);
+   xb -= xa;
+   REQUIRE(xb.Normlinf() == 0.0);
+
+   REQUIRE(!a.GetNodes() == !b.GetNodes());
+   if (a.GetNodes())
+   {
+      const FiniteElementSpace *fa = a.GetNodes()->FESpace();
+      const FiniteElementSpace *fb = b.GetNodes()->FESpace();
+      REQUIRE(fa->GetOrder(0) == fb->GetOrder(0));
+      REQUIRE(fa->GetOrdering() == fb->GetOrdering());
+      Vector diff(*b.GetNodes());
+      diff -= *a.GetNodes();
+      REQUIRE(diff.Normlinf() == 0.0);
+   }
+}
+
+}
+
+TEST_CASE("Binary mesh and grid function format", "[Mesh]")
+{
+   for (int type = 0; type < 3; type++)
+   {
+      Mesh *mesh;
+      if (type == 0)
+      {
+         mesh = new Mesh(4, 3, Element::TRIANGLE, true);
+      }
+      else if (type == 1)
+      {
+         mesh = new Mesh(4, 3, Element::QUADRILATERAL, true);
+      }
+      else
+      {
+         mesh = new Mesh(2, 3, 2, Element::HEXAHEDRON, true);
+      }
+
+      SECTION("Conforming and nonconforming meshes")
+      {
+         std::stringstream ss;
+         mesh->PrintBinary(ss);
+         Mesh loaded(ss);
+         binary::CheckSameMesh(*mesh, loaded);
+
+         // Nonconforming refinement; the refinement hierarchy is stored so
+         // that the loaded mesh can be refined and derefined further
+         if (type > 0)
+         {
+            Array<int> marked;
+            for (int e = 0; e < mesh->GetNE(); e += 2) { marked.Append(e); }
+            mesh->GeneralRefinement(marked, 1);
+            std::stringstream ncs;
+            mesh->PrintBinary(ncs);
+            Mesh nc_loaded(ncs);
+            binary::CheckSameMesh(*mesh, nc_loaded);
+
+            marked.SetSize(0);
+            marked.Append(mesh->GetNE() - 1);
+            mesh->GeneralRefinement(marked, 1);
+            nc_loaded.GeneralRefinement(marked, 1);
+            binary::CheckSameMesh(*mesh, nc_loaded);
+         }
+      }
+
+      SECTION("Curved mesh and grid function")
+      {
+         mesh->SetCurvature(3, type == 1);
+         mesh->Transform(bvh::Deform);
+         H1_FECollection fec(2, mesh->Dimension());
+         FiniteElementSpace fes(mesh, &fec);
+         GridFunction gf(&fes);
+         FunctionCoefficient coeff(binary::Func);
+         gf.ProjectCoefficient(coeff);
+
+         // The format is detected by the constructors from streams
+         std::stringstream ms, gs;
+         mesh->PrintBinary(ms);
+         gf.SaveBinary(gs);
+         Mesh loaded(ms);
+         binary::CheckSameMesh(*mesh, loaded);
+         GridFunction gf_loaded(&loaded, gs);
+         REQUIRE(gf_loaded.FESpace()->GetVSize() == fes.GetVSize());
+         Vector diff(gf_loaded);
+         diff -= gf;
+         REQUIRE(diff.Normlinf() == 0.0);
+
+         // Memory-mapped files: the nodes and the grid function data are used
+         // in place
+         {
+            std::ofstream mfile("binary_mesh.mesh", std::ios::binary);
+            mesh->PrintBinary(mfile);
+            std::ofstream gfile("binary_gf.gf", std::ios::binary);
+            gf.SaveBinary(gfile);
+         }
+         {
+            BinaryReader mreader, greader;
+            mreader.Map("binary_mesh.mesh");
+            greader.Map("binary_gf.gf");
+            Mesh mapped(mreader);
+            GridFunction gf_mapped(&mapped, greader);
+            binary::CheckSameMesh(*mesh, mapped);
+            diff = gf_mapped;
+            diff -= gf;
+            REQUIRE(diff.Normlinf() == 0.0);
+#ifndef _WIN32
+            REQUIRE(mreader.IsMapped());
+#endif
+            int n;
+            REQUIRE(mapped.GetNodes()->GetData() ==
+                    mreader.GetDoubles("nodes", n));
+            REQUIRE(gf_mapped.GetData() == greader.GetDoubles("data", n));
+            REQUIRE(n == gf.Size());
+
+            // The file is mapped copy-on-write
+            mapped.GetNodes()->Neg();
+            mapped.NodesUpdated();
+            Mesh from_file("binary_mesh.mesh");
+            binary::CheckSameMesh(*mesh, from_file);
+         }
+         REQUIRE(remove("binary_mesh.mesh") == 0);
+         REQUIRE(remove("binary_gf.gf") == 0);
+      }
+      delete mesh;
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("ParMesh from distributed pieces", "[Parallel], [ParMesh]")
+{
+   for (int type = 0; type < 3; type++)
+   {
+      Mesh *mesh;
+      if (type == 0)
+      {
+         mesh = new Mesh(7, 5, Element::QUADRILATERAL, true, 1.0, 1.0);
+      }
+      else if (type == 1)
+      {
+         mesh = new Mesh(7, 5, Element::TRIANGLE, true, 1.0, 1.0);
+      }
+      else
+      {
+         mesh = new Mesh(4, 3, 5, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      }
+      const int dim = mesh->Dimension();
+
+      // Reference: the parallel mesh partitioned from the global mesh
+      ParMesh pmesh_ref(MPI_COMM_WORLD, *mesh);
+
+      // Each rank reads its chunk of the serial mesh
+      std::stringstream mesh_str;
+      mesh->Print(mesh_str);
+      delete mesh;
+      Array<long> vert_global;
+      Mesh *chunk = ParMesh::LoadSerialChunk(MPI_COMM_WORLD, mesh_str,
+                                             vert_global);
+      REQUIRE(vert_global.Size() == chunk->GetNV());
+      ParMesh pmesh(MPI_COMM_WORLD, *chunk, vert_global);
+      delete chunk;
+
+      REQUIRE(pmesh.GetGlobalNE() == pmesh_ref.GetGlobalNE());
+      long nbe = pmesh.GetNBE(), nbe_ref = pmesh_ref.GetNBE();
+      MPI_Allreduce(MPI_IN_PLACE, &nbe, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &nbe_ref, 1, MPI_LONG, MPI_SUM,
+                    MPI_COMM_WORLD);
+      REQUIRE(nbe == nbe_ref);
+
+      double vol = 0.0;
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         vol += pmesh.GetElementVolume(i);
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &vol, 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      REQUIRE(fabs(vol - 1.0) < 1e-12);
+
+      // The shared entities are consistent if the global number of true dofs
+      // is the same
+      H1_FECollection fec(2, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      ParFiniteElementSpace fes_ref(&pmesh_ref, &fec);
+      REQUIRE(fes.GlobalTrueVSize() == fes_ref.GlobalTrueVSize());
+
+      ND_FECollection nd_fec(1, dim);
+      ParFiniteElementSpace nd_fes(&pmesh, &nd_fec);
+      ParFiniteElementSpace nd_fes_ref(&pmesh_ref, &nd_fec);
+      REQUIRE(nd_fes.GlobalTrueVSize() == nd_fes_ref.GlobalTrueVSize());
+   }
+}
+
+#endif // MFEM_USE_MPI